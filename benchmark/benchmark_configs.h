@@ -0,0 +1,142 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "tconf/config.h"
+#include "tconf/errors.h"
+#include "tconf/short_macros.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tconf_bench {
+
+    struct FlatCfg : public tconf::Config {
+        PARAM(intParam0, int);
+        PARAM(intParam1, int);
+        PARAM(intParam2, int);
+        PARAM(intParam3, int);
+        PARAM(intParam4, int);
+        PARAM(intParam5, int);
+        PARAM(intParam6, int);
+        PARAM(intParam7, int);
+        PARAM(doubleParam0, double);
+        PARAM(doubleParam1, double);
+        PARAM(doubleParam2, double);
+        PARAM(doubleParam3, double);
+        PARAM(doubleParam4, double);
+        PARAM(doubleParam5, double);
+        PARAM(doubleParam6, double);
+        PARAM(doubleParam7, double);
+        PARAM(stringParam0, std::string);
+        PARAM(stringParam1, std::string);
+        PARAM(stringParam2, std::string);
+        PARAM(stringParam3, std::string);
+        PARAM(stringParam4, std::string);
+        PARAM(stringParam5, std::string);
+        PARAM(stringParam6, std::string);
+        PARAM(stringParam7, std::string);
+        PARAM(boolParam0, bool);
+        PARAM(boolParam1, bool);
+        PARAM(boolParam2, bool);
+        PARAM(boolParam3, bool);
+        PARAM(boolParam4, bool);
+        PARAM(boolParam5, bool);
+        PARAM(boolParam6, bool);
+        PARAM(boolParam7, bool);
+    };
+
+    template<int depth>
+    struct DeepCfg : public tconf::Config {
+        PARAM(level, int);
+        PARAM(name, std::string);
+        NODE(child, DeepCfg<depth - 1>);
+    };
+
+    template<>
+    struct DeepCfg<0> : public tconf::Config {
+        PARAM(level, int);
+        PARAM(name, std::string);
+    };
+
+    struct ItemCfg : public tconf::Config {
+        PARAM(id, int);
+        PARAM(name, std::string);
+        PARAM(host, std::string);
+        PARAM(port, int);
+        PARAM(weight, double);
+        PARAM(enabled, bool);
+    };
+
+    struct ItemListCfg : public tconf::Config {
+        NODE_LIST(items, std::vector<ItemCfg>);
+    };
+
+    struct ParallelItemListCfg : public tconf::Config {
+        NODE_LIST(items, std::vector<ItemCfg>).parallel();
+    };
+
+    struct CopyItemListCfg : public tconf::Config {
+        COPY_NODE_LIST(items, std::vector<ItemCfg>);
+    };
+
+    struct NonNegative {
+        template<typename T>
+        void operator()(const T &value) const {
+            if (value < T{})
+                throw tconf::ValidationError{"value can't be negative"};
+        }
+    };
+
+    struct NotEmpty {
+        void operator()(const std::string &value) const {
+            if (value.empty())
+                throw tconf::ValidationError{"value can't be empty"};
+        }
+    };
+
+    struct ValidatedItemCfg : public tconf::Config {
+        PARAM(id, int).ensure<NonNegative>();
+        PARAM(name, std::string).ensure<NotEmpty>();
+        PARAM(host, std::string).ensure<NotEmpty>();
+        PARAM(port, int).ensure<NonNegative>();
+        PARAM(weight, double).ensure<NonNegative>();
+        PARAM(enabled, bool);
+    };
+
+    struct ValidatedItemListCfg : public tconf::Config {
+        NODE_LIST(items, std::vector<ValidatedItemCfg>);
+    };
+
+    /// a large node that is rarely used, it's either loaded with the config or on the first access
+    struct CatalogCfg : public tconf::Config {
+        NODE(catalog, ValidatedItemListCfg);
+    };
+
+    struct LazyCatalogCfg : public tconf::Config {
+        NODE(catalog, tconf::lazy<ValidatedItemListCfg>);
+    };
+
+    struct DictCfg : public tconf::Config {
+        using StringMap = std::map<std::string, std::string>;
+        DICT(entries, StringMap);
+    };
+
+    struct ParamListCfg : public tconf::Config {
+        PARAM_LIST(values, std::vector<int>);
+    };
+
+} //namespace tconf_bench
@@ -0,0 +1,373 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "tconf/ini/parser.h"
+#include "tconf/json/json_parser.h"
+#include "tconf/toml/parser.h"
+#include "tconf/tree/tree.h"
+#include "tconf/yaml/parser.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tconf_bench {
+
+    enum class Format {
+        Json,
+        Yaml,
+        Toml,
+        Ini
+    };
+
+    inline const std::vector<Format> &allFormats() {
+        static const auto formats = std::vector<Format>{Format::Json, Format::Yaml, Format::Toml, Format::Ini};
+        return formats;
+    }
+
+    inline std::string formatName(Format format) {
+        switch (format) {
+            case Format::Json:
+                return "json";
+            case Format::Yaml:
+                return "yaml";
+            case Format::Toml:
+                return "toml";
+            case Format::Ini:
+                return "ini";
+        }
+        return {};
+    }
+
+    ///
+    /// Format independent description of a generated config, it's written into a text
+    /// document of the requested format with writeConfig().
+    ///
+    struct GenValue {
+        std::string text;
+        bool isString = false;
+    };
+
+    struct GenParam {
+        std::string name;
+        std::vector<GenValue> values;
+        bool isList = false;
+    };
+
+    struct GenNode {
+        std::string name;
+        bool isList = false;
+        std::vector<GenParam> params;
+        std::vector<GenNode> children;
+
+        void addParam(std::string paramName, GenValue value) {
+            params.push_back({std::move(paramName), {std::move(value)}, false});
+        }
+
+        void addParamList(std::string paramName, std::vector<GenValue> values) {
+            params.push_back({std::move(paramName), std::move(values), true});
+        }
+
+        GenNode &addNode(std::string nodeName) {
+            return children.emplace_back(GenNode{std::move(nodeName)});
+        }
+
+        GenNode &addNodeList(std::string nodeName) {
+            auto &node = children.emplace_back(GenNode{std::move(nodeName)});
+            node.isList = true;
+            return node;
+        }
+
+        GenNode &addElement() {
+            return children.emplace_back();
+        }
+    };
+
+    inline GenValue intValue(long long value) {
+        return {std::to_string(value), false};
+    }
+
+    inline GenValue doubleValue(int value) {
+        return {std::to_string(value) + ".5", false};
+    }
+
+    inline GenValue boolValue(bool value) {
+        return {value ? "true" : "false", false};
+    }
+
+    inline GenValue stringValue(const std::string &value) {
+        return {value, true};
+    }
+
+    /// FlatCfg: 32 params of mixed types in a single node
+    inline GenNode makeFlatConfig() {
+        auto root = GenNode{};
+        for (auto i = 0; i < 8; ++i)
+            root.addParam("intParam" + std::to_string(i), intValue(i * 1000));
+        for (auto i = 0; i < 8; ++i)
+            root.addParam("doubleParam" + std::to_string(i), doubleValue(i));
+        for (auto i = 0; i < 8; ++i)
+            root.addParam("stringParam" + std::to_string(i), stringValue("string_value_" + std::to_string(i)));
+        for (auto i = 0; i < 8; ++i)
+            root.addParam("boolParam" + std::to_string(i), boolValue(i % 2));
+        return root;
+    }
+
+    /// DeepCfg<depth>: a chain of depth + 1 nested nodes
+    inline GenNode makeDeepConfig(int depth) {
+        auto root = GenNode{};
+        auto *node = &root;
+        for (auto level = depth; level >= 0; --level) {
+            node->addParam("level", intValue(level));
+            node->addParam("name", stringValue("level_" + std::to_string(level)));
+            if (level > 0)
+                node = &node->addNode("child");
+        }
+        return root;
+    }
+
+    inline void fillItem(GenNode &item, int index) {
+        item.addParam("id", intValue(index));
+        item.addParam("name", stringValue("item_" + std::to_string(index)));
+        item.addParam("host", stringValue("host" + std::to_string(index % 256) + ".example.com"));
+        item.addParam("port", intValue(8000 + index % 1000));
+        item.addParam("weight", doubleValue(index % 100));
+        item.addParam("enabled", boolValue(index % 3 != 0));
+    }
+
+    /// ItemListCfg and its variants: a node list of `size` elements
+    inline GenNode makeItemListConfig(int size) {
+        auto root = GenNode{};
+        auto &items = root.addNodeList("items");
+        for (auto i = 0; i < size; ++i)
+            fillItem(items.addElement(), i);
+        return root;
+    }
+
+    /// CopyItemListCfg: the first element is complete, the others override a single param
+    inline GenNode makeCopyItemListConfig(int size) {
+        auto root = GenNode{};
+        auto &items = root.addNodeList("items");
+        fillItem(items.addElement(), 0);
+        for (auto i = 1; i < size; ++i)
+            items.addElement().addParam("id", intValue(i));
+        return root;
+    }
+
+    /// CatalogCfg and LazyCatalogCfg: a node containing a node list of `size` elements
+    inline GenNode makeCatalogConfig(int size) {
+        auto root = GenNode{};
+        auto &items = root.addNode("catalog").addNodeList("items");
+        for (auto i = 0; i < size; ++i)
+            fillItem(items.addElement(), i);
+        return root;
+    }
+
+    /// DictCfg: a dictionary with `size` entries
+    inline GenNode makeDictConfig(int size) {
+        auto root = GenNode{};
+        auto &entries = root.addNode("entries");
+        for (auto i = 0; i < size; ++i)
+            entries.addParam("key" + std::to_string(i), stringValue("value_" + std::to_string(i)));
+        return root;
+    }
+
+    /// ParamListCfg: a param list with `size` elements
+    inline GenNode makeParamListConfig(int size) {
+        auto root = GenNode{};
+        auto values = std::vector<GenValue>{};
+        values.reserve(static_cast<std::size_t>(size));
+        for (auto i = 0; i < size; ++i)
+            values.push_back(intValue(i));
+        root.addParamList("values", std::move(values));
+        return root;
+    }
+
+    namespace detail {
+
+        inline std::string quoted(const std::string &value) {
+            return '"' + value + '"';
+        }
+
+        inline std::string joinPath(const std::string &path, const std::string &name) {
+            return path.empty() ? name : path + "." + name;
+        }
+
+        inline void writeJson(const GenNode &node, std::string &out) {
+            auto jsonValue = [](const GenValue &value) {
+                return value.isString ? quoted(value.text) : value.text;
+            };
+            auto first = true;
+            auto separator = [&] {
+                if (!first)
+                    out += ",";
+                first = false;
+            };
+            out += "{";
+            for (const auto &param: node.params) {
+                separator();
+                out += quoted(param.name) + ":";
+                if (param.isList) {
+                    out += "[";
+                    for (auto i = std::size_t{}; i < param.values.size(); ++i)
+                        out += (i ? "," : "") + jsonValue(param.values[i]);
+                    out += "]";
+                } else
+                    out += jsonValue(param.values.front());
+            }
+            for (const auto &child: node.children) {
+                separator();
+                out += quoted(child.name) + ":";
+                if (child.isList) {
+                    out += "[";
+                    for (auto i = std::size_t{}; i < child.children.size(); ++i) {
+                        if (i)
+                            out += ",";
+                        writeJson(child.children[i], out);
+                    }
+                    out += "]";
+                } else
+                    writeJson(child, out);
+            }
+            out += "}";
+        }
+
+        inline void writeYaml(const GenNode &node, int indent, std::string &out) {
+            const auto indentStr = std::string(static_cast<std::size_t>(indent), ' ');
+            auto yamlValue = [](const GenValue &value) {
+                return value.isString ? quoted(value.text) : value.text;
+            };
+            for (const auto &param: node.params) {
+                out += indentStr + param.name + ": ";
+                if (param.isList) {
+                    out += "[";
+                    for (auto i = std::size_t{}; i < param.values.size(); ++i)
+                        out += (i ? ", " : "") + yamlValue(param.values[i]);
+                    out += "]\n";
+                } else
+                    out += yamlValue(param.values.front()) + "\n";
+            }
+            for (const auto &child: node.children) {
+                out += indentStr + child.name + ":\n";
+                if (child.isList) {
+                    for (const auto &element: child.children) {
+                        out += indentStr + "  -\n";
+                        writeYaml(element, indent + 4, out);
+                    }
+                } else
+                    writeYaml(child, indent + 2, out);
+            }
+        }
+
+        inline void writeToml(const GenNode &node, const std::string &path, std::string &out) {
+            auto tomlValue = [](const GenValue &value) {
+                return value.isString ? quoted(value.text) : value.text;
+            };
+            for (const auto &param: node.params) {
+                out += param.name + " = ";
+                if (param.isList) {
+                    out += "[";
+                    for (auto i = std::size_t{}; i < param.values.size(); ++i)
+                        out += (i ? ", " : "") + tomlValue(param.values[i]);
+                    out += "]\n";
+                } else
+                    out += tomlValue(param.values.front()) + "\n";
+            }
+            for (const auto &child: node.children) {
+                const auto childPath = joinPath(path, child.name);
+                if (child.isList) {
+                    for (const auto &element: child.children) {
+                        out += "[[" + childPath + "]]\n";
+                        writeToml(element, childPath, out);
+                    }
+                } else {
+                    out += "[" + childPath + "]\n";
+                    writeToml(child, childPath, out);
+                }
+            }
+        }
+
+        inline void writeIni(const GenNode &node, const std::string &path, std::string &out) {
+            for (const auto &param: node.params) {
+                out += param.name + " = ";
+                if (param.isList) {
+                    out += "[";
+                    for (auto i = std::size_t{}; i < param.values.size(); ++i)
+                        out += (i ? ", " : "") + param.values[i].text;
+                    out += "]\n";
+                } else
+                    out += param.values.front().text + "\n";
+            }
+            for (const auto &child: node.children) {
+                const auto childPath = joinPath(path, child.name);
+                if (child.isList) {
+                    for (auto i = std::size_t{}; i < child.children.size(); ++i) {
+                        const auto elementPath = childPath + "." + std::to_string(i);
+                        out += "[" + elementPath + "]\n";
+                        writeIni(child.children[i], elementPath, out);
+                    }
+                } else {
+                    out += "[" + childPath + "]\n";
+                    writeIni(child, childPath, out);
+                }
+            }
+        }
+
+    } //namespace detail
+
+    inline std::string writeConfig(const GenNode &root, Format format) {
+        auto result = std::string{};
+        switch (format) {
+            case Format::Json:
+                detail::writeJson(root, result);
+                break;
+            case Format::Yaml:
+                detail::writeYaml(root, 0, result);
+                break;
+            case Format::Toml:
+                detail::writeToml(root, {}, result);
+                break;
+            case Format::Ini:
+                detail::writeIni(root, {}, result);
+                break;
+        }
+        return result;
+    }
+
+    inline tconf::TreeNode parseConfig(const std::string &content, Format format) {
+        auto stream = std::istringstream{content};
+        switch (format) {
+            case Format::Json: {
+                auto parser = tconf::JsonParser{};
+                return parser.parse(stream);
+            }
+            case Format::Yaml: {
+                auto parser = tconf::yaml::Parser{};
+                return parser.parse(stream);
+            }
+            case Format::Toml: {
+                auto parser = tconf::toml::Parser{};
+                return parser.parse(stream);
+            }
+            case Format::Ini: {
+                auto parser = tconf::ini::Parser{};
+                return parser.parse(stream);
+            }
+        }
+        return tconf::makeTreeRoot();
+    }
+
+} //namespace tconf_bench
@@ -0,0 +1,208 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Separate timings of the reading phases:
+//   parse_<format>/<shape> - IParser::parse, text to TreeNode;
+//   reparse_yaml/<shape>   - the same as parse_yaml/* with a single yaml::Parser reused between the iterations;
+//   load/<shape>           - ConfigReader::read(const TreeNode&), TreeNode to config structure;
+//   load/validated_*       - the same as load/* with a validator attached to each parameter,
+//                            the difference with the unvalidated run is the validation cost;
+//   load/parallel_*        - the same as load/* with the node list loaded on all hardware threads;
+//   layers/<shape>         - ConfigReader::read(const TreeLayers&) of the config with a small override layer,
+//                            the difference with load/<shape> is the merging cost;
+//   update/<shape>         - ConfigReader::update() of a copy of the loaded config with a tree that differs
+//                            in a single param, the content hashes of the trees are cached after the first iteration.
+
+#include "benchmark_configs.h"
+#include "config_generator.h"
+#include "tconf/config_reader.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tconf_bench {
+
+    void registerParseBenchmark(
+            const std::string &shapeName,
+            const std::function<GenNode(int)> &makeConfig,
+            const std::vector<int64_t> &sizes) {
+        for (auto format: allFormats()) {
+            auto name = "parse_" + formatName(format) + "/" + shapeName;
+            auto benchmark = benchmark::RegisterBenchmark(
+                    name.c_str(),
+                    [=](benchmark::State &state) {
+                        const auto content = writeConfig(makeConfig(static_cast<int>(state.range(0))), format);
+                        try {
+                            for (auto _: state) {
+                                auto tree = parseConfig(content, format);
+                                benchmark::DoNotOptimize(tree);
+                            }
+                        }
+                        catch (const tconf::Error &e) {
+                            state.SkipWithError(e.what());
+                            return;
+                        }
+                        state.SetBytesProcessed(
+                                static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(content.size()));
+                    });
+            for (auto size: sizes)
+                benchmark->Arg(size);
+        }
+    }
+
+    void registerReparseBenchmark(
+            const std::string &shapeName,
+            const std::function<GenNode(int)> &makeConfig,
+            const std::vector<int64_t> &sizes) {
+        auto name = "reparse_yaml/" + shapeName;
+        auto benchmark = benchmark::RegisterBenchmark(
+                name.c_str(),
+                [=](benchmark::State &state) {
+                    const auto content = writeConfig(makeConfig(static_cast<int>(state.range(0))), Format::Yaml);
+                    auto parser = tconf::yaml::Parser{};
+                    for (auto _: state) {
+                        auto tree = parser.parse(content.data(), content.size());
+                        benchmark::DoNotOptimize(tree);
+                    }
+                    state.SetBytesProcessed(
+                            static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(content.size()));
+                });
+        for (auto size: sizes)
+            benchmark->Arg(size);
+    }
+
+    template<typename TCfg>
+    void registerLoadBenchmark(
+            const std::string &shapeName,
+            const std::function<GenNode(int)> &makeConfig,
+            const std::vector<int64_t> &sizes) {
+        auto name = "load/" + shapeName;
+        auto benchmark = benchmark::RegisterBenchmark(
+                name.c_str(),
+                [=](benchmark::State &state) {
+                    const auto tree = parseConfig(
+                            writeConfig(makeConfig(static_cast<int>(state.range(0))), Format::Yaml),
+                            Format::Yaml);
+                    auto reader = tconf::ConfigReader{};
+                    for (auto _: state) {
+                        auto cfg = reader.read<TCfg>(tree);
+                        benchmark::DoNotOptimize(cfg);
+                    }
+                    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+                });
+        for (auto size: sizes)
+            benchmark->Arg(size);
+    }
+
+    template<typename TCfg>
+    void registerUpdateBenchmark(
+            const std::string &shapeName,
+            const std::function<GenNode(int)> &makeConfig,
+            const std::function<void(GenNode &)> &changeConfig,
+            const std::vector<int64_t> &sizes) {
+        auto name = "update/" + shapeName;
+        auto benchmark = benchmark::RegisterBenchmark(
+                name.c_str(),
+                [=](benchmark::State &state) {
+                    auto config = makeConfig(static_cast<int>(state.range(0)));
+                    const auto previousTree = parseConfig(writeConfig(config, Format::Yaml), Format::Yaml);
+                    changeConfig(config);
+                    const auto tree = parseConfig(writeConfig(config, Format::Yaml), Format::Yaml);
+                    auto reader = tconf::ConfigReader{};
+                    const auto cfg = reader.read<TCfg>(previousTree);
+                    for (auto _: state) {
+                        auto updatedCfg = cfg;
+                        auto changes = reader.update(updatedCfg, previousTree, tree);
+                        benchmark::DoNotOptimize(updatedCfg);
+                        benchmark::DoNotOptimize(changes);
+                    }
+                    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+                });
+        for (auto size: sizes)
+            benchmark->Arg(size);
+    }
+
+    template<typename TCfg>
+    void registerLayersBenchmark(
+            const std::string &shapeName,
+            const std::function<GenNode(int)> &makeConfig,
+            const std::function<GenNode()> &makeOverride,
+            const std::vector<int64_t> &sizes) {
+        auto name = "layers/" + shapeName;
+        auto benchmark = benchmark::RegisterBenchmark(
+                name.c_str(),
+                [=](benchmark::State &state) {
+                    auto layers = tconf::TreeLayers{};
+                    layers.add(parseConfig(
+                            writeConfig(makeConfig(static_cast<int>(state.range(0))), Format::Yaml),
+                            Format::Yaml));
+                    layers.add(parseConfig(writeConfig(makeOverride(), Format::Yaml), Format::Yaml));
+                    auto reader = tconf::ConfigReader{};
+                    for (auto _: state) {
+                        auto cfg = reader.read<TCfg>(layers);
+                        benchmark::DoNotOptimize(cfg);
+                    }
+                    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+                });
+        for (auto size: sizes)
+            benchmark->Arg(size);
+    }
+
+    const auto phaseBenchmarksRegistered = [] {
+        auto flat = [](int) {
+            return makeFlatConfig();
+        };
+        auto deep = [](int depth) {
+            return makeDeepConfig(depth);
+        };
+        registerParseBenchmark("flat_params", flat, {32});
+        registerParseBenchmark("deep_nodes", deep, {32});
+        registerParseBenchmark("wide_node_list", makeItemListConfig, {10, 1000, 10000});
+        registerParseBenchmark("big_dict", makeDictConfig, {10, 1000, 10000});
+        registerParseBenchmark("long_param_list", makeParamListConfig, {10, 1000, 100000});
+        registerReparseBenchmark("wide_node_list", makeItemListConfig, {10, 1000, 10000});
+
+        registerLoadBenchmark<FlatCfg>("flat_params", flat, {32});
+        registerLoadBenchmark<DeepCfg<32>>("deep_nodes", deep, {32});
+        registerLoadBenchmark<ItemListCfg>("wide_node_list", makeItemListConfig, {10, 1000, 10000});
+        registerLoadBenchmark<ParallelItemListCfg>("parallel_wide_node_list", makeItemListConfig, {10, 1000, 10000});
+        registerLoadBenchmark<ValidatedItemListCfg>("validated_wide_node_list", makeItemListConfig, {10, 1000, 10000});
+        registerLoadBenchmark<CopyItemListCfg>("copy_node_list", makeCopyItemListConfig, {10, 100, 1000, 10000});
+        registerLoadBenchmark<CatalogCfg>("catalog_node", makeCatalogConfig, {1000});
+        registerLoadBenchmark<LazyCatalogCfg>("lazy_catalog_node", makeCatalogConfig, {1000});
+        registerLoadBenchmark<DictCfg>("big_dict", makeDictConfig, {10, 1000, 10000});
+        registerLoadBenchmark<ParamListCfg>("long_param_list", makeParamListConfig, {10, 1000, 100000});
+
+        auto changeMiddleItem = [](GenNode &config) {
+            auto &items = config.children.front().children;
+            items[items.size() / 2].params.front().values.front() = intValue(-1);
+        };
+        registerUpdateBenchmark<ItemListCfg>("wide_node_list", makeItemListConfig, changeMiddleItem, {10, 1000, 10000});
+
+        auto dictOverride = [] {
+            auto config = GenNode{};
+            auto &entries = config.addNode("entries");
+            entries.addParam("key0", stringValue("overridden"));
+            entries.addParam("newKey", stringValue("added"));
+            return config;
+        };
+        registerLayersBenchmark<DictCfg>("big_dict", makeDictConfig, dictOverride, {10, 1000, 10000});
+        return true;
+    }();
+
+} //namespace tconf_bench
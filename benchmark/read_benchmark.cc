@@ -0,0 +1,140 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// End-to-end ConfigReader::read_json/read_yaml/read_toml/read_ini timings
+// over generated configs of different shapes and sizes.
+
+#include "benchmark_configs.h"
+#include "config_generator.h"
+#include "tconf/binary/parser.h"
+#include "tconf/binary/writer.h"
+#include "tconf/config_reader.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace tconf_bench {
+
+    template<typename TCfg>
+    TCfg readConfig(tconf::ConfigReader<> &reader, const std::string &content, Format format) {
+        switch (format) {
+            case Format::Json:
+                return reader.read_json<TCfg>(content);
+            case Format::Yaml:
+                return reader.read_yaml<TCfg>(content);
+            case Format::Toml:
+                return reader.read_toml<TCfg>(content);
+            case Format::Ini:
+                return reader.read_ini<TCfg>(content);
+        }
+        return reader.read_json<TCfg>(content);
+    }
+
+    template<typename TCfg>
+    void registerReadBenchmark(
+            const std::string &shapeName,
+            const std::function<GenNode(int)> &makeConfig,
+            const std::vector<int64_t> &sizes) {
+        for (auto format: allFormats()) {
+            auto name = "read_" + formatName(format) + "/" + shapeName;
+            auto benchmark = benchmark::RegisterBenchmark(
+                    name.c_str(),
+                    [=](benchmark::State &state) {
+                        const auto content = writeConfig(makeConfig(static_cast<int>(state.range(0))), format);
+                        auto reader = tconf::ConfigReader{};
+                        try {
+                            for (auto _: state) {
+                                auto cfg = readConfig<TCfg>(reader, content, format);
+                                benchmark::DoNotOptimize(cfg);
+                            }
+                        }
+                        catch (const tconf::Error &e) {
+                            state.SkipWithError(e.what());
+                            return;
+                        }
+                        state.SetBytesProcessed(
+                                static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(content.size()));
+                    });
+            for (auto size: sizes)
+                benchmark->Arg(size);
+        }
+    }
+
+    /// reads the binary snapshot of a YAML config, it's compared with read_yaml of the same shape
+    template<typename TCfg>
+    void registerReadBinaryBenchmark(
+            const std::string &shapeName,
+            const std::function<GenNode(int)> &makeConfig,
+            const std::vector<int64_t> &sizes) {
+        auto name = "read_binary/" + shapeName;
+        auto benchmark = benchmark::RegisterBenchmark(
+                name.c_str(),
+                [=](benchmark::State &state) {
+                    const auto yaml = writeConfig(makeConfig(static_cast<int>(state.range(0))), Format::Yaml);
+                    const auto tree = parseConfig(yaml, Format::Yaml);
+                    auto reader = tconf::ConfigReader{};
+                    const auto content = tconf::binary::write(tree, reader.schema_fingerprint<TCfg>());
+                    auto parser = tconf::binary::Parser{};
+                    try {
+                        for (auto _: state) {
+                            auto cfg = reader.read<TCfg>(content, parser);
+                            benchmark::DoNotOptimize(cfg);
+                        }
+                    }
+                    catch (const tconf::Error &e) {
+                        state.SkipWithError(e.what());
+                        return;
+                    }
+                    state.SetBytesProcessed(
+                            static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(content.size()));
+                });
+        for (auto size: sizes)
+            benchmark->Arg(size);
+    }
+
+    const auto readBenchmarksRegistered = [] {
+        registerReadBenchmark<FlatCfg>(
+                "flat_params",
+                [](int) {
+                    return makeFlatConfig();
+                },
+                {32});
+        registerReadBenchmark<DeepCfg<8>>(
+                "deep_nodes",
+                [](int depth) {
+                    return makeDeepConfig(depth);
+                },
+                {8});
+        registerReadBenchmark<DeepCfg<32>>(
+                "deep_nodes",
+                [](int depth) {
+                    return makeDeepConfig(depth);
+                },
+                {32});
+        registerReadBenchmark<ItemListCfg>("wide_node_list", makeItemListConfig, {10, 100, 1000, 10000});
+        registerReadBenchmark<CopyItemListCfg>("copy_node_list", makeCopyItemListConfig, {10, 100, 1000, 10000});
+        registerReadBenchmark<CatalogCfg>("catalog_node", makeCatalogConfig, {1000});
+        registerReadBenchmark<LazyCatalogCfg>("lazy_catalog_node", makeCatalogConfig, {1000});
+        registerReadBenchmark<DictCfg>("big_dict", makeDictConfig, {10, 100, 1000, 10000});
+        registerReadBenchmark<ParamListCfg>("long_param_list", makeParamListConfig, {10, 100, 1000, 10000, 100000});
+        registerReadBinaryBenchmark<ItemListCfg>("wide_node_list", makeItemListConfig, {10, 100, 1000, 10000});
+        registerReadBinaryBenchmark<DictCfg>("big_dict", makeDictConfig, {10, 100, 1000, 10000});
+        registerReadBinaryBenchmark<ParamListCfg>("long_param_list", makeParamListConfig, {10, 100, 1000, 10000, 100000});
+        return true;
+    }();
+
+} //namespace tconf_bench
@@ -22,7 +22,7 @@ if (CARBIN_BUILD_TEST)
 endif (CARBIN_BUILD_TEST)
 
 if (CARBIN_BUILD_BENCHMARK)
-    #include(require_benchmark)
+    include(require_benchmark)
 endif ()
 
 find_package(Threads REQUIRED)
@@ -23,7 +23,7 @@
 
 struct NotEmpty {
     template<typename TList>
-    void operator()(const TList &list) {
+    void operator()(const TList &list) const {
         if (!list.empty())
             throw tconf::ValidationError{"can't be empty."};
     }
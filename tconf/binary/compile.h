@@ -0,0 +1,134 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_BINARY_COMPILE_H_
+#define TCONF_BINARY_COMPILE_H_
+
+#include "tconf/binary/writer.h"
+#include "tconf/config_reader.h"
+#include "tconf/errors.h"
+#include "tconf/ini/parser.h"
+#include "tconf/json/json_parser.h"
+#include "tconf/name_format.h"
+#include "tconf/toml/parser.h"
+#include "tconf/yaml/parser.h"
+#include "tconf/tree/iparser.h"
+#include "tconf/tree/tree.h"
+#include "turbo/files/filesystem.h"
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace tconf::binary {
+
+    namespace detail {
+
+        inline std::unique_ptr<IParser> makeParser(const std::string &format) {
+            if (format == "json")
+                return std::make_unique<JsonParser>();
+            if (format == "yaml" || format == "yml")
+                return std::make_unique<yaml::Parser>();
+            if (format == "toml")
+                return std::make_unique<toml::Parser>();
+            if (format == "ini")
+                return std::make_unique<ini::Parser>();
+            return nullptr;
+        }
+
+        using WriteSnapshot = std::function<void(
+                const turbo::filesystem::path &snapshotFile,
+                const TreeNode &tree,
+                std::optional<std::uint64_t> fingerprint)>;
+
+        ///
+        /// Command line of tconf-compile: [--fingerprint <hex>] <config file> <snapshot file> [json|yaml|toml|ini].
+        /// The format is detected by the config file's extension if it isn't specified. The --fingerprint option
+        /// is accepted only if hasFingerprintOption is set.
+        ///
+        inline int compileMain(int argc, char **argv, bool hasFingerprintOption, const WriteSnapshot &writeSnapshot) {
+            const auto usage = std::string{"usage: tconf-compile "} +
+                               (hasFingerprintOption ? "[--fingerprint <hex>] " : "") +
+                               "<config file> <snapshot file> [json|yaml|toml|ini]";
+            auto fingerprint = std::optional<std::uint64_t>{};
+            auto argIndex = 1;
+            if (hasFingerprintOption && argc > 2 && std::string{argv[1]} == "--fingerprint") {
+                try {
+                    auto size = std::size_t{};
+                    fingerprint = std::stoull(argv[2], &size, 16);
+                    if (size != std::string{argv[2]}.size() || *fingerprint == 0)
+                        throw std::invalid_argument{argv[2]};
+                }
+                catch (const std::exception &) {
+                    std::cerr << "tconf-compile: invalid fingerprint '" << argv[2] << "'" << std::endl;
+                    return 2;
+                }
+                argIndex = 3;
+            }
+            const auto argCount = argc - argIndex;
+            if (argCount != 2 && argCount != 3) {
+                std::cerr << usage << std::endl;
+                return 2;
+            }
+            const auto configFile = turbo::filesystem::path{argv[argIndex]};
+            const auto snapshotFile = turbo::filesystem::path{argv[argIndex + 1]};
+            auto format = argCount == 3 ? std::string{argv[argIndex + 2]} : configFile.extension().string();
+            if (!format.empty() && format.front() == '.')
+                format.erase(0, 1);
+
+            auto parser = makeParser(format);
+            if (!parser) {
+                std::cerr << "tconf-compile: unknown config format '" << format << "'" << std::endl;
+                return 2;
+            }
+            try {
+                auto reader = ConfigReader{};
+                writeSnapshot(snapshotFile, reader.parse_file(configFile, *parser), fingerprint);
+            }
+            catch (const Error &e) {
+                std::cerr << "tconf-compile: " << e.what() << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+
+    } //namespace detail
+
+    ///
+    /// Entry point of a tconf-compile tool built for the config type: the config is checked against the type
+    /// and its schema fingerprint is written into the snapshot, so read_snapshot_file<TCfg>() accepts it
+    /// and rejects it for the other types.
+    ///
+    ///     int main(int argc, char **argv) {
+    ///         return tconf::binary::compile_main<PhotoViewerCfg>(argc, argv);
+    ///     }
+    ///
+    template<typename TCfg, NameFormat nameFormat = NameFormat::Original>
+    int compile_main(int argc, char **argv) {
+        return detail::compileMain(
+                argc,
+                argv,
+                false,
+                [](const turbo::filesystem::path &snapshotFile, const TreeNode &tree, std::optional<std::uint64_t>) {
+                    ConfigReader<nameFormat>{}.template write_snapshot_file<TCfg>(snapshotFile, tree);
+                });
+    }
+
+} //namespace tconf::binary
+
+#endif // TCONF_BINARY_COMPILE_H_
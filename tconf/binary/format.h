@@ -0,0 +1,73 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_BINARY_FORMAT_H_
+#define TCONF_BINARY_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+namespace tconf::binary {
+
+    ///
+    /// Layout of a binary config snapshot. All numbers are stored in the native byte order, strings are stored
+    /// inline with their length and node records are prefixed with their size, so the snapshot has no pointers
+    /// and is read directly from the mapped file.
+    ///
+    ///   header:      magic[8] version:u32 reserved:u32 fingerprint:u64 bodySize:u64
+    ///   item body:   nodeCount:u32 node* paramCount:u32 param*
+    ///   node:        name position kind:u8 size:u32 (item body | elementCount:u32 (position item body)*)
+    ///   param:       name position kind:u8 (value | valueCount:u32 value*)
+    ///   value:       type:u8 (length:u32 bytes | int64 | uint64 | double | bool:u8)
+    ///   name:        length:u32 bytes
+    ///   position:    line:u32 column:u32, zero if it isn't set
+    ///
+    inline constexpr auto magic = std::string_view{"TCONFBIN", 8};
+    inline constexpr auto version = std::uint32_t{1};
+    inline constexpr auto headerSize = std::size_t{32};
+    /// the node records are read recursively, so a deeper snapshot is rejected instead of overflowing the stack
+    inline constexpr auto maxNestingDepth = std::size_t{256};
+
+    enum class RecordKind : std::uint8_t {
+        Item,
+        List
+    };
+
+    struct Header {
+        std::uint32_t version = 0;
+        /// fingerprint of the config schema the snapshot was validated with, zero if it wasn't
+        std::uint64_t fingerprint = 0;
+        std::uint64_t bodySize = 0;
+    };
+
+    /// Returns the header if the data starts with the snapshot magic and is large enough to contain the body
+    inline std::optional<Header> readHeader(const char *data, std::size_t size) {
+        if (size < headerSize || std::string_view{data, magic.size()} != magic)
+            return {};
+        auto header = Header{};
+        std::memcpy(&header.version, data + 8, sizeof(header.version));
+        std::memcpy(&header.fingerprint, data + 16, sizeof(header.fingerprint));
+        std::memcpy(&header.bodySize, data + 24, sizeof(header.bodySize));
+        if (header.bodySize != size - headerSize)
+            return {};
+        return header;
+    }
+
+} //namespace tconf::binary
+
+#endif // TCONF_BINARY_FORMAT_H_
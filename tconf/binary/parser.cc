@@ -0,0 +1,198 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/binary/parser.h"
+#include "tconf/binary/format.h"
+#include "tconf/errors.h"
+#include "tconf/tree/tree_builder.h"
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace tconf::binary {
+
+    namespace {
+
+        class Reader {
+        public:
+            Reader(const char *data, std::size_t size, ITreeVisitor &visitor)
+                    : pos_{data}, end_{data + size}, visitor_{visitor} {
+            }
+
+            void readItem() {
+                // each record takes at least its name size, so a corrupted count isn't passed to the visitor
+                const auto nodesCount = readNumber<std::uint32_t>();
+                if (nodesCount <= static_cast<std::size_t>(end_ - pos_))
+                    visitor_.expectNodes(nodesCount);
+                for (auto i = std::uint32_t{}; i < nodesCount; ++i)
+                    readNode();
+                const auto paramsCount = readNumber<std::uint32_t>();
+                if (paramsCount <= static_cast<std::size_t>(end_ - pos_))
+                    visitor_.expectParams(paramsCount);
+                for (auto i = std::uint32_t{}; i < paramsCount; ++i)
+                    readParam();
+            }
+
+            bool atEnd() const {
+                return pos_ == end_;
+            }
+
+        private:
+            [[noreturn]] static void throwCorrupted() {
+                throw ConfigError{"Binary config: the data is corrupted"};
+            }
+
+            const char *take(std::size_t size) {
+                if (static_cast<std::size_t>(end_ - pos_) < size)
+                    throwCorrupted();
+                const auto result = pos_;
+                pos_ += size;
+                return result;
+            }
+
+            template<typename T>
+            T readNumber() {
+                static_assert(std::is_arithmetic_v<T>);
+                auto value = T{};
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            std::string_view readString() {
+                const auto size = readNumber<std::uint32_t>();
+                return {take(size), size};
+            }
+
+            StreamPosition readPosition() {
+                auto position = StreamPosition{};
+                if (const auto line = readNumber<std::uint32_t>())
+                    position.line = static_cast<int>(line);
+                if (const auto column = readNumber<std::uint32_t>())
+                    position.column = static_cast<int>(column);
+                return position;
+            }
+
+            RecordKind readKind() {
+                const auto kind = readNumber<std::uint8_t>();
+                if (kind > static_cast<std::uint8_t>(RecordKind::List))
+                    throwCorrupted();
+                return static_cast<RecordKind>(kind);
+            }
+
+            void readNode() {
+                if (++depth_ > maxNestingDepth)
+                    throwCorrupted();
+                const auto name = readString();
+                const auto position = readPosition();
+                const auto kind = readKind();
+                const auto size = readNumber<std::uint32_t>();
+                if (size > static_cast<std::size_t>(end_ - pos_))
+                    throwCorrupted();
+                const auto recordEnd = pos_ + size;
+
+                if (kind == RecordKind::Item) {
+                    visitor_.beginNode(name, position);
+                    readItem();
+                    visitor_.endNode();
+                }
+                else {
+                    visitor_.beginNodeList(name, position);
+                    const auto count = readNumber<std::uint32_t>();
+                    for (auto i = std::uint32_t{}; i < count; ++i) {
+                        visitor_.beginListElement(readPosition());
+                        readItem();
+                        visitor_.endNode();
+                    }
+                    visitor_.endNode();
+                }
+                if (pos_ != recordEnd)
+                    throwCorrupted();
+                --depth_;
+            }
+
+            void readParam() {
+                const auto name = readString();
+                const auto position = readPosition();
+                if (readKind() == RecordKind::Item) {
+                    visitor_.param(name, readValue(), position);
+                    return;
+                }
+                const auto count = readNumber<std::uint32_t>();
+                // each value takes at least its type byte, so a corrupted count can't cause a huge allocation
+                if (count > static_cast<std::size_t>(end_ - pos_))
+                    throwCorrupted();
+                auto values = std::vector<TreeValue>{};
+                values.reserve(count);
+                for (auto i = std::uint32_t{}; i < count; ++i)
+                    values.push_back(readValue());
+                visitor_.paramList(name, TreeValueList{values.data(), values.size()}, position);
+            }
+
+            TreeValue readValue() {
+                switch (static_cast<TreeValue::Type>(readNumber<std::uint8_t>())) {
+                    case TreeValue::Type::String:
+                        return TreeValue{readString()};
+                    case TreeValue::Type::Integer:
+                        return TreeValue{readNumber<std::int64_t>()};
+                    case TreeValue::Type::Unsigned:
+                        return TreeValue{readNumber<std::uint64_t>()};
+                    case TreeValue::Type::Float:
+                        return TreeValue{readNumber<double>()};
+                    case TreeValue::Type::Bool:
+                        return TreeValue{readNumber<std::uint8_t>() != 0};
+                }
+                throwCorrupted();
+            }
+
+        private:
+            const char *pos_;
+            const char *end_;
+            ITreeVisitor &visitor_;
+            std::size_t depth_ = 0;
+        };
+
+    } //namespace
+
+    TreeNode Parser::parse(std::istream &stream) {
+        const auto content = std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+        return parse(content.data(), content.size());
+    }
+
+    TreeNode Parser::parse(const char *data, std::size_t size) {
+        auto tree = makeTreeRoot();
+        auto builder = TreeBuilder{tree};
+        visit(data, size, builder);
+        return tree;
+    }
+
+    void Parser::visit(const char *data, std::size_t size, ITreeVisitor &visitor) {
+        const auto header = readHeader(data, size);
+        if (!header)
+            throw ConfigError{"Binary config: the data isn't a tconf snapshot"};
+        if (header->version != version)
+            throw ConfigError{
+                    "Binary config: unsupported version " + std::to_string(header->version) + ", expected " +
+                    std::to_string(version)};
+        auto reader = Reader{data + headerSize, size - headerSize, visitor};
+        reader.readItem();
+        if (!reader.atEnd())
+            throw ConfigError{"Binary config: the data is corrupted"};
+    }
+
+} //namespace tconf::binary
@@ -0,0 +1,41 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_BINARY_PARSER_H_
+#define TCONF_BINARY_PARSER_H_
+
+#include "tconf/tree/iparser.h"
+#include <cstddef>
+#include <istream>
+
+namespace tconf::binary {
+
+    ///
+    /// Reads a binary config snapshot created by binary::write(). The content is reported to the visitor
+    /// straight from the buffer: the values are already typed and the strings refer to the buffer,
+    /// so nothing is tokenized or converted. The snapshot's fingerprint isn't checked here, see ConfigReader.
+    ///
+    class Parser : public IParser {
+    public:
+        TreeNode parse(std::istream &stream) override;
+
+        TreeNode parse(const char *data, std::size_t size) override;
+
+        void visit(const char *data, std::size_t size, ITreeVisitor &visitor) override;
+    };
+
+} //namespace tconf::binary
+
+#endif // TCONF_BINARY_PARSER_H_
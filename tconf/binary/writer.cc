@@ -0,0 +1,172 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/binary/writer.h"
+#include "tconf/binary/format.h"
+#include "tconf/detail/path.h"
+#include "tconf/errors.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace tconf::binary {
+
+    namespace {
+
+        class Writer {
+        public:
+            explicit Writer(std::string &out)
+                    : out_{out} {
+            }
+
+            void writeItem(const TreeNode &node) {
+                const auto &item = node.asItem();
+                writeNumber(static_cast<std::uint32_t>(item.nodesCount()));
+                for (const auto &[name, child]: item.nodes())
+                    writeNode(name, child);
+                writeNumber(static_cast<std::uint32_t>(item.paramsCount()));
+                for (const auto &[name, param]: item.params())
+                    writeParam(name, param);
+            }
+
+        private:
+            template<typename T>
+            void writeNumber(T value) {
+                static_assert(std::is_arithmetic_v<T>);
+                char bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                out_.append(bytes, sizeof(T));
+            }
+
+            void writeString(std::string_view value) {
+                writeNumber(checkedSize(value.size()));
+                out_.append(value.data(), value.size());
+            }
+
+            // lines and columns start with one, zero means the position isn't set
+            void writePosition(const StreamPosition &position) {
+                writeNumber(static_cast<std::uint32_t>(position.line.value_or(0)));
+                writeNumber(static_cast<std::uint32_t>(position.column.value_or(0)));
+            }
+
+            void writeNode(std::string_view name, const TreeNode &node) {
+                if (++depth_ > maxNestingDepth)
+                    throw ConfigError{"Binary config: the tree is nested too deeply to be serialized"};
+                writeString(name);
+                writePosition(node.position());
+                writeNumber(static_cast<std::uint8_t>(node.isList() ? RecordKind::List : RecordKind::Item));
+                // the record size is known after the content is written
+                const auto sizeOffset = out_.size();
+                writeNumber(std::uint32_t{});
+                if (node.isItem())
+                    writeItem(node);
+                else {
+                    const auto &list = node.asList();
+                    writeNumber(static_cast<std::uint32_t>(list.count()));
+                    for (auto i = 0; i < list.count(); ++i) {
+                        const auto &element = list.node(i);
+                        writePosition(element.position());
+                        writeItem(element);
+                    }
+                }
+                const auto size = checkedSize(out_.size() - sizeOffset - sizeof(std::uint32_t));
+                std::memcpy(out_.data() + sizeOffset, &size, sizeof(size));
+                --depth_;
+            }
+
+            void writeParam(std::string_view name, const TreeParam &param) {
+                writeString(name);
+                writePosition(param.position());
+                if (param.isItem()) {
+                    writeNumber(static_cast<std::uint8_t>(RecordKind::Item));
+                    writeValue(param.typedValue());
+                    return;
+                }
+                writeNumber(static_cast<std::uint8_t>(RecordKind::List));
+                const auto valueList = param.valueListView();
+                writeNumber(checkedSize(valueList.size()));
+                for (const auto &value: valueList)
+                    writeValue(value);
+            }
+
+            void writeValue(const TreeValue &value) {
+                writeNumber(static_cast<std::uint8_t>(value.type()));
+                switch (value.type()) {
+                    case TreeValue::Type::String:
+                        writeString(value.asString());
+                        break;
+                    case TreeValue::Type::Integer:
+                        writeNumber(value.asInteger());
+                        break;
+                    case TreeValue::Type::Unsigned:
+                        writeNumber(value.asUnsigned());
+                        break;
+                    case TreeValue::Type::Float:
+                        writeNumber(value.asFloat());
+                        break;
+                    case TreeValue::Type::Bool:
+                        writeNumber(static_cast<std::uint8_t>(value.asBool()));
+                        break;
+                }
+            }
+
+            static std::uint32_t checkedSize(std::size_t size) {
+                if (size > std::numeric_limits<std::uint32_t>::max())
+                    throw ConfigError{"Binary config: the tree is too large to be serialized"};
+                return static_cast<std::uint32_t>(size);
+            }
+
+        private:
+            std::string &out_;
+            std::size_t depth_ = 0;
+        };
+
+    } //namespace
+
+    std::string write(const TreeNode &tree, std::uint64_t fingerprint) {
+        auto result = std::string{magic};
+        result.resize(headerSize);
+        std::memcpy(result.data() + 8, &version, sizeof(version));
+        std::memcpy(result.data() + 16, &fingerprint, sizeof(fingerprint));
+
+        auto writer = Writer{result};
+        writer.writeItem(tree);
+        const auto bodySize = static_cast<std::uint64_t>(result.size() - headerSize);
+        std::memcpy(result.data() + 24, &bodySize, sizeof(bodySize));
+        return result;
+    }
+
+    void writeFile(const turbo::filesystem::path &file, const TreeNode &tree, std::uint64_t fingerprint) {
+        const auto content = write(tree, fingerprint);
+        auto tempFile = file;
+        tempFile += ".tmp";
+        {
+            auto stream = std::ofstream{tempFile, std::ios_base::binary | std::ios_base::trunc};
+            stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+            if (!stream)
+                throw ConfigError{"Can't write binary config file " + sfun::path_string(tempFile)};
+        }
+        auto error = std::error_code{};
+        turbo::filesystem::rename(tempFile, file, error);
+        if (error) {
+            turbo::filesystem::remove(tempFile, error);
+            throw ConfigError{"Can't write binary config file " + sfun::path_string(file)};
+        }
+    }
+
+} //namespace tconf::binary
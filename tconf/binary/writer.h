@@ -0,0 +1,34 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_BINARY_WRITER_H_
+#define TCONF_BINARY_WRITER_H_
+
+#include "tconf/tree/tree.h"
+#include "turbo/files/filesystem.h"
+#include <cstdint>
+#include <string>
+
+namespace tconf::binary {
+
+    /// Serializes the tree into a binary snapshot, zero fingerprint means the tree wasn't validated with a config type
+    std::string write(const TreeNode &tree, std::uint64_t fingerprint = 0);
+
+    /// Writes the snapshot into a temporary file first and renames it, so the readers never see a partial snapshot
+    void writeFile(const turbo::filesystem::path &file, const TreeNode &tree, std::uint64_t fingerprint = 0);
+
+} //namespace tconf::binary
+
+#endif // TCONF_BINARY_WRITER_H_
@@ -19,10 +19,11 @@
 #include "tconf/detail/config_macros.h"
 #include "tconf/detail/dict.h"
 #include "tconf/detail/dict_creator.h"
+#include "tconf/detail/field_name.h"
 #include "tconf/detail/iconfig_reader.h"
 #include "tconf/detail/initialized_optional.h"
 #include "tconf/detail/inode.h"
-#include "tconf/detail/ivalidator.h"
+#include "tconf/detail/validator.h"
 #include "tconf/detail/name_converter.h"
 #include "tconf/detail/nodelist_creator.h"
 #include "tconf/detail/param_creator.h"
@@ -68,67 +69,73 @@ namespace tconf {
         template<auto member>
         auto node(const std::string &memberName) {
             auto ptr = decltype(member){};
-            return node<member>(ptr, memberName);
+            return node<member>(ptr, detail::FieldName{memberName});
         }
 
         template<auto member>
         auto dict(const std::string &memberName) {
             auto ptr = decltype(member){};
-            return dict<member>(ptr, memberName);
+            return dict<member>(ptr, detail::FieldName{memberName});
         }
 
         template<auto member>
         auto nodeList(const std::string &memberName) {
             auto ptr = decltype(member){};
-            return nodeList<member>(ptr, memberName);
+            return nodeList<member>(ptr, detail::FieldName{memberName});
         }
 
         template<auto member>
         auto copyNodeList(const std::string &memberName) {
             auto ptr = decltype(member){};
-            return copyNodeList<member>(ptr, memberName);
+            return copyNodeList<member>(ptr, detail::FieldName{memberName});
         }
 
         template<auto member>
         auto param(const std::string &memberName) {
             auto ptr = decltype(member){};
-            return param<member>(ptr, memberName);
+            return param<member>(ptr, detail::FieldName{memberName});
         }
 
         template<auto member>
         auto paramList(const std::string &memberName) {
             auto ptr = decltype(member){};
-            return paramList<member>(ptr, memberName);
+            return paramList<member>(ptr, detail::FieldName{memberName});
         }
 
         template<auto member>
         auto node() {
-            return node<member>(std::string{turbo::nameof_member<member>()});
+            auto ptr = decltype(member){};
+            return node<member>(ptr, detail::reflectedFieldName<member>());
         }
 
         template<auto member>
         auto dict() {
-            return dict<member>(std::string{turbo::nameof_member<member>()});
+            auto ptr = decltype(member){};
+            return dict<member>(ptr, detail::reflectedFieldName<member>());
         }
 
         template<auto member>
         auto nodeList() {
-            return nodeList<member>(std::string{turbo::nameof_member<member>()});
+            auto ptr = decltype(member){};
+            return nodeList<member>(ptr, detail::reflectedFieldName<member>());
         }
 
         template<auto member>
         auto copyNodeList() {
-            return copyNodeList<member>(std::string{turbo::nameof_member<member>()});
+            auto ptr = decltype(member){};
+            return copyNodeList<member>(ptr, detail::reflectedFieldName<member>());
         }
 
         template<auto member>
         auto param() {
-            return param<member>(std::string{turbo::nameof_member<member>()});
+            auto ptr = decltype(member){};
+            return param<member>(ptr, detail::reflectedFieldName<member>());
         }
 
         template<auto member>
         auto paramList() {
-            return paramList<member>(std::string{turbo::nameof_member<member>()});
+            auto ptr = decltype(member){};
+            return paramList<member>(ptr, detail::reflectedFieldName<member>());
         }
 
         detail::ConfigReaderPtr cfgReader() const {
@@ -137,39 +144,40 @@ namespace tconf {
 
     private:
         template<auto member, typename T, typename TCfg>
-        auto node(T TCfg::*, const std::string &memberName) {
+        auto node(T TCfg::*, detail::FieldName memberName) {
             auto cfg = static_cast<TCfg *>(this);
-            return detail::NodeCreator<T>{cfgReader(), memberName, cfg->*member};
+            return detail::NodeCreator<T>{cfgReader(), std::move(memberName), cfg->*member};
         }
 
         template<auto member, typename TMap, typename TCfg>
-        auto dict(TMap TCfg::*, const std::string &memberName) {
+        auto dict(TMap TCfg::*, detail::FieldName memberName) {
             auto cfg = static_cast<TCfg *>(this);
-            return detail::DictCreator<TMap>{cfgReader(), memberName, cfg->*member};
+            return detail::DictCreator<TMap>{cfgReader(), std::move(memberName), cfg->*member};
         }
 
         template<auto member, typename TCfgList, typename TCfg>
-        auto nodeList(TCfgList TCfg::*, const std::string &memberName) {
+        auto nodeList(TCfgList TCfg::*, detail::FieldName memberName) {
             auto cfg = static_cast<TCfg *>(this);
-            return detail::NodeListCreator<TCfgList>{cfgReader(), memberName, cfg->*member};
+            return detail::NodeListCreator<TCfgList>{cfgReader(), std::move(memberName), cfg->*member};
         }
 
         template<auto member, typename TCfgList, typename TCfg>
-        auto copyNodeList(TCfgList TCfg::*, const std::string &memberName) {
+        auto copyNodeList(TCfgList TCfg::*, detail::FieldName memberName) {
             auto cfg = static_cast<TCfg *>(this);
-            return detail::NodeListCreator<TCfgList>{cfgReader(), memberName, cfg->*member, detail::NodeListType::Copy};
+            return detail::NodeListCreator<TCfgList>{
+                    cfgReader(), std::move(memberName), cfg->*member, detail::NodeListType::Copy};
         }
 
         template<auto member, typename T, typename TCfg>
-        auto param(T TCfg::*, const std::string &memberName) {
+        auto param(T TCfg::*, detail::FieldName memberName) {
             auto cfg = static_cast<TCfg *>(this);
-            return detail::ParamCreator<T>{cfgReader(), memberName, cfg->*member};
+            return detail::ParamCreator<T>{cfgReader(), std::move(memberName), cfg->*member};
         }
 
         template<auto member, typename T, typename TCfg>
-        auto paramList(T TCfg::*, const std::string &memberName) {
+        auto paramList(T TCfg::*, detail::FieldName memberName) {
             auto cfg = static_cast<TCfg *>(this);
-            return detail::ParamListCreator<T>{cfgReader(), memberName, cfg->*member};
+            return detail::ParamListCreator<T>{cfgReader(), std::move(memberName), cfg->*member};
         }
 
     private:
@@ -0,0 +1,40 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_CONFIG_CHANGES_H_
+#define TCONF_CONFIG_CHANGES_H_
+
+#include <string>
+#include <vector>
+
+namespace tconf {
+
+    ///
+    /// Result of the incremental config update
+    ///
+    struct ConfigChanges {
+        /// dotted paths of the loaded fields, the node list elements are addressed by index: "albums.1.name"
+        std::vector<std::string> fields;
+        /// set if the config's structure has changed, so it was loaded completely
+        bool isFullReload = false;
+
+        bool empty() const {
+            return fields.empty() && !isFullReload;
+        }
+    };
+
+}  // namespace tconf
+
+#endif  // TCONF_CONFIG_CHANGES_H_
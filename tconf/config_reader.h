@@ -17,25 +17,40 @@
 #define TCONF_CONFIG_READER_H_
 
 #include "tconf/config.h"
+#include "tconf/config_changes.h"
 #include "tconf/errors.h"
 #include "tconf/name_format.h"
+#include "tconf/read_result.h"
 #include "tconf/detail/path.h"
-#include "tconf/detail/iconfig_reader.h"
-#include "tconf/detail/inode.h"
-#include "tconf/detail/iparam.h"
-#include "tconf/detail/ivalidator.h"
+#include "tconf/detail/config_binder.h"
+#include "tconf/detail/config_updater.h"
+#include "tconf/detail/loading_context.h"
 #include "tconf/detail/loading_error.h"
-#include "tconf/detail/name_converter.h"
+#include "tconf/detail/file_content.h"
+#include "tconf/detail/parallel_loader.h"
+#include "tconf/detail/schema.h"
 #include "tconf/tree/iparser.h"
 #include "tconf/tree/tree.h"
+#include "tconf/tree/tree_layers.h"
 #include "tconf/json/json_parser.h"
 #include "tconf/yaml/parser.h"
 #include "tconf/ini/parser.h"
 #include "tconf/toml/parser.h"
+#include "tconf/binary/format.h"
+#include "tconf/binary/parser.h"
+#include "tconf/binary/writer.h"
 #include "turbo/files/filesystem.h"
-#include <map>
-#include <memory>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <system_error>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace tconf {
@@ -44,29 +59,274 @@ namespace tconf {
 
     std::string get_gflags_splitter();
 
+    /// Whether read_snapshot_file() accepts a snapshot written without a schema fingerprint, e.g. by tconf-compile
+    /// without the --fingerprint option. Such a snapshot isn't checked against the config structure.
+    enum class UnboundSnapshot {
+        Reject,
+        Accept
+    };
+
+    ///
+    /// The read() methods accept an optional memory resource: the config's containers and strings with
+    /// std::pmr::polymorphic_allocator are placed in it, e.g. in a std::pmr::monotonic_buffer_resource
+    /// that is released together with the config. The resource must outlive the config.
+    ///
     template<NameFormat nameFormat = NameFormat::Original>
-    class ConfigReader : public detail::IConfigReader {
+    class ConfigReader {
     public:
         template<typename TCfg>
-        TCfg read_file(const turbo::filesystem::path &configFile, IParser &parser) {
-            if (!turbo::filesystem::exists(configFile))
-                throw ConfigError{"Config file " + sfun::path_string(configFile) + " doesn't exist"};
+        TCfg read_file(
+                const turbo::filesystem::path &configFile,
+                IParser &parser,
+                std::pmr::memory_resource *memoryResource = nullptr) {
+            checkConfigFile(configFile);
+            const auto file = detail::FileContent{configFile};
+            if (!file.isOpen())
+                throw ConfigError{"Can't open config file " + sfun::path_string(configFile) + " for reading"};
 
-            if (!turbo::filesystem::is_regular_file(configFile))
-                throw ConfigError{
-                        "Can't open config file " + sfun::path_string(configFile) + " which is not a regular file"};
+            return read<TCfg>(file.data(), file.size(), parser, memoryResource);
+        }
 
-            auto configStream = std::ifstream{configFile, std::ios_base::binary};
-            if (!configStream.is_open())
+        /// Parses the config file into a tree that can be loaded with read() or passed to update()
+        TreeNode parse_file(const turbo::filesystem::path &configFile, IParser &parser) {
+            checkConfigFile(configFile);
+            const auto file = detail::FileContent{configFile};
+            if (!file.isOpen())
                 throw ConfigError{"Can't open config file " + sfun::path_string(configFile) + " for reading"};
 
-            return read < TCfg > (configStream, parser);
+            return parser.parse(file.data(), file.size());
         }
 
         template<typename TCfg>
-        TCfg read(const std::string &configContent, IParser &parser) {
-            auto configStream = std::stringstream{configContent};
-            return read<TCfg>(configStream, parser);
+        TCfg read(
+                const std::string &configContent,
+                IParser &parser,
+                std::pmr::memory_resource *memoryResource = nullptr) {
+            return read<TCfg>(configContent.data(), configContent.size(), parser, memoryResource);
+        }
+
+        template<typename TCfg>
+        TCfg read(const TreeNode &tree, std::pmr::memory_resource *memoryResource = nullptr) {
+            checkConfigType<TCfg>();
+            const auto &schema = detail::schemaOf<TCfg, nameFormat>();
+            auto cfg = TCfg{detail::ConfigReaderPtr{}};
+            auto ctx = detail::LoadingContext{nameFormat};
+            ctx.memoryResource = memoryResource;
+            try {
+                schema.load(&cfg, tree, ctx);
+            }
+            catch (const detail::LoadingError &e) {
+                throw ConfigError{std::string{"Root node: "} + e.what(), tree.position()};
+            }
+            return cfg;
+        }
+
+        /// Loads the merged content of the tree layers in a single pass, the merged tree isn't built
+        template<typename TCfg>
+        TCfg read(const TreeLayers &layers) {
+            checkConfigType<TCfg>();
+            const auto &schema = detail::schemaOf<TCfg, nameFormat>();
+            auto cfg = TCfg{detail::ConfigReaderPtr{}};
+            auto binder = detail::ConfigBinder{schema, &cfg, detail::LoadingContext{nameFormat}};
+            layers.visit(binder);
+            try {
+                binder.finish();
+            }
+            catch (const detail::LoadingError &e) {
+                throw ConfigError{std::string{"Root node: "} + e.what(), StreamPosition{1, 1}};
+            }
+            return cfg;
+        }
+
+        ///
+        /// Loads the fields of the config that differ between the trees, the config must be loaded from previousTree.
+        /// The unchanged subtrees are found by their content hashes and aren't converted again, the validators
+        /// are run only for the configs with the changed fields. If a config node has gained or lost a field,
+        /// the whole config is loaded from the tree. The config's state is unspecified if an error is thrown.
+        ///
+        template<typename TCfg>
+        ConfigChanges update(TCfg &cfg, const TreeNode &previousTree, const TreeNode &tree) {
+            checkConfigType<TCfg>();
+            const auto &schema = detail::schemaOf<TCfg, nameFormat>();
+            auto updater = detail::ConfigUpdater{detail::LoadingContext{nameFormat}};
+            if (updater.update(schema, &cfg, previousTree, tree))
+                return {updater.changedFields(), false};
+
+            cfg = read<TCfg>(tree);
+            return {{}, true};
+        }
+
+        ///
+        /// Reads the config files of the same type and format on up to threadCount threads, zero means the number
+        /// of hardware threads. Each file is parsed and loaded independently, if some of them fail,
+        /// ConfigFilesError with the errors of all the failed files is thrown after the others are read.
+        ///
+        template<typename TCfg, typename TParser>
+        std::vector<TCfg> read_many(
+                const std::vector<turbo::filesystem::path> &configFiles,
+                std::size_t threadCount = 0) {
+            auto cfgs = std::vector<std::optional<TCfg>>(configFiles.size());
+            readConcurrently<TParser>(
+                    configFiles.data(),
+                    configFiles.size(),
+                    threadCount,
+                    [&](std::size_t i, IParser &parser) {
+                        cfgs[i].emplace(read_file<TCfg>(configFiles[i], parser));
+                    });
+            auto result = std::vector<TCfg>{};
+            result.reserve(cfgs.size());
+            for (auto &cfg: cfgs)
+                result.emplace_back(std::move(*cfg));
+            return result;
+        }
+
+        ///
+        /// Reads the config files of different types in the same format concurrently like read_many(),
+        /// the n-th file is loaded into the n-th config type.
+        ///
+        template<typename TParser, typename... TCfgs>
+        std::tuple<TCfgs...> read_files(
+                const std::array<turbo::filesystem::path, sizeof...(TCfgs)> &configFiles,
+                std::size_t threadCount = 0) {
+            auto cfgs = std::tuple<std::optional<TCfgs>...>{};
+            readConcurrently<TParser>(
+                    configFiles.data(),
+                    configFiles.size(),
+                    threadCount,
+                    [&](std::size_t i, IParser &parser) {
+                        readNth(cfgs, i, configFiles[i], parser, std::index_sequence_for<TCfgs...>{});
+                    });
+            return std::apply(
+                    [](auto &...cfg) {
+                        return std::tuple<TCfgs...>{std::move(*cfg)...};
+                    },
+                    cfgs);
+        }
+
+        ///
+        /// Reads the config like read() but doesn't stop at the first error: the failed fields are skipped
+        /// and all the errors are returned in the result with their positions. The validators of the failed fields
+        /// aren't run. A syntax error still stops the reading, it's returned as the last error.
+        ///
+        template<typename TCfg>
+        ReadResult<TCfg> try_read(const std::string &configContent, IParser &parser) {
+            return tryRead<TCfg>(configContent.data(), configContent.size(), parser);
+        }
+
+        template<typename TCfg>
+        ReadResult<TCfg> try_read(const TreeNode &tree) {
+            checkConfigType<TCfg>();
+            auto errors = std::vector<Diagnostic>{};
+            auto ctx = detail::LoadingContext{nameFormat};
+            ctx.errors = &errors;
+            auto cfg = TCfg{detail::ConfigReaderPtr{}};
+            detail::schemaOf<TCfg, nameFormat>().load(&cfg, tree, ctx);
+            if (!errors.empty())
+                return ReadResult<TCfg>{std::move(errors)};
+            return ReadResult<TCfg>{std::move(cfg)};
+        }
+
+        /// The errors of opening the file are returned in the result too
+        template<typename TCfg>
+        ReadResult<TCfg> try_read_file(const turbo::filesystem::path &configFile, IParser &parser) {
+            try {
+                checkConfigFile(configFile);
+            }
+            catch (const ConfigError &e) {
+                return ReadResult<TCfg>{std::vector<Diagnostic>{e.diagnostic()}};
+            }
+            const auto file = detail::FileContent{configFile};
+            if (!file.isOpen())
+                return ReadResult<TCfg>{std::vector<Diagnostic>{
+                        {"Can't open config file " + sfun::path_string(configFile) + " for reading", {}}}};
+
+            return tryRead<TCfg>(file.data(), file.size(), parser);
+        }
+
+        ///
+        /// Reads the config files of the same type and format with try_read_file() on up to threadCount threads,
+        /// zero means the number of hardware threads. The n-th result belongs to the n-th file.
+        ///
+        template<typename TCfg, typename TParser>
+        std::vector<ReadResult<TCfg>> try_read_many(
+                const std::vector<turbo::filesystem::path> &configFiles,
+                std::size_t threadCount = 0) {
+            auto results = std::vector<std::optional<ReadResult<TCfg>>>(configFiles.size());
+            detail::runInParallel(configFiles.size(), threadCount, [&](std::size_t i) {
+                try {
+                    auto parser = TParser{};
+                    results[i].emplace(try_read_file<TCfg>(configFiles[i], parser));
+                }
+                catch (const std::exception &e) {
+                    results[i].emplace(std::vector<Diagnostic>{{e.what(), {}}});
+                }
+            });
+            auto readResults = std::vector<ReadResult<TCfg>>{};
+            readResults.reserve(results.size());
+            for (auto &result: results)
+                readResults.emplace_back(std::move(*result));
+            return readResults;
+        }
+
+        /// Fingerprint of the config's schema, binary snapshots written with write_snapshot_file() store it
+        template<typename TCfg>
+        std::uint64_t schema_fingerprint() {
+            checkConfigType<TCfg>();
+            static const auto fingerprint =
+                    detail::schemaOf<TCfg, nameFormat>().fingerprint(detail::LoadingContext{nameFormat});
+            return fingerprint;
+        }
+
+        ///
+        /// Checks that the config can be read from the tree and writes the tree into a binary snapshot file
+        /// with the config's schema fingerprint
+        ///
+        template<typename TCfg>
+        void write_snapshot_file(const turbo::filesystem::path &snapshotFile, const TreeNode &tree) {
+            read<TCfg>(tree);
+            binary::writeFile(snapshotFile, tree, schema_fingerprint<TCfg>());
+        }
+
+        ///
+        /// Reads a binary snapshot, ConfigError is thrown if it was written for a config with another schema.
+        /// A snapshot without a fingerprint is rejected too, unless UnboundSnapshot::Accept is passed.
+        ///
+        template<typename TCfg>
+        TCfg read_snapshot_file(
+                const turbo::filesystem::path &snapshotFile,
+                UnboundSnapshot unboundSnapshot = UnboundSnapshot::Reject) {
+            checkConfigFile(snapshotFile);
+            const auto file = detail::FileContent{snapshotFile, detail::FileAccess::Map};
+            if (!file.isOpen())
+                throw ConfigError{"Can't open config file " + sfun::path_string(snapshotFile) + " for reading"};
+            const auto header = binary::readHeader(file.data(), file.size());
+            if (header && header->fingerprint == 0 && unboundSnapshot == UnboundSnapshot::Reject)
+                throw ConfigError{
+                        "Binary config file " + sfun::path_string(snapshotFile) +
+                        " has no schema fingerprint, write it for the config type or pass UnboundSnapshot::Accept"};
+            if (!hasSchemaFingerprint<TCfg>(file.data(), file.size(), unboundSnapshot))
+                throw ConfigError{
+                        "Binary config file " + sfun::path_string(snapshotFile) +
+                        " was written for a config with another schema"};
+
+            auto parser = binary::Parser{};
+            return read<TCfg>(file.data(), file.size(), parser);
+        }
+
+        ///
+        /// Reads a binary snapshot of the config file if it's usable, otherwise reads the config file with the parser.
+        /// The snapshot isn't used if it's missing or older than the config file, if it was written for another schema
+        /// or by another version of the library, or if the config can't be read from it. The snapshots without
+        /// a schema fingerprint aren't used either, as they can't be checked against the config structure.
+        ///
+        template<typename TCfg>
+        TCfg read_snapshot_file(
+                const turbo::filesystem::path &snapshotFile,
+                const turbo::filesystem::path &configFile,
+                IParser &parser) {
+            if (auto cfg = tryReadSnapshot<TCfg>(snapshotFile, configFile))
+                return std::move(*cfg);
+            return read_file<TCfg>(configFile, parser);
         }
 
         template<typename TCfg>
@@ -77,8 +337,8 @@ namespace tconf {
 
         template<typename TCfg>
         TCfg read_json(const std::string &configContent) {
-            auto configStream = std::stringstream{configContent};
-            return read_json<TCfg>(configStream);
+            auto parser = JsonParser{};
+            return read<TCfg>(configContent, parser);
         }
 
         template<typename TCfg>
@@ -95,8 +355,8 @@ namespace tconf {
 
         template<typename TCfg>
         TCfg read_yaml(const std::string &configContent) {
-            auto configStream = std::stringstream{configContent};
-            return read_yaml<TCfg>(configStream);
+            auto parser = yaml::Parser{};
+            return read<TCfg>(configContent, parser);
         }
 
         template<typename TCfg>
@@ -113,8 +373,8 @@ namespace tconf {
 
         template<typename TCfg>
         TCfg read_toml(const std::string &configContent) {
-            auto configStream = std::stringstream{configContent};
-            return read_toml<TCfg>(configStream);
+            auto parser = toml::Parser{};
+            return read<TCfg>(configContent, parser);
         }
 
         template<typename TCfg>
@@ -131,8 +391,8 @@ namespace tconf {
 
         template<typename TCfg>
         TCfg read_ini(const std::string &configContent) {
-            auto configStream = std::stringstream{configContent};
-            return read_ini<TCfg>(configStream);
+            auto parser = ini::Parser{};
+            return read<TCfg>(configContent, parser);
         }
 
         template<typename TCfg>
@@ -142,88 +402,149 @@ namespace tconf {
         }
 
     private:
-        void addNode(const std::string &name, std::unique_ptr<detail::INode> node) override {
-            nodes_.emplace(detail::NameConverter<nameFormat>::name(name), std::move(node));
-        }
-
-        void addParam(const std::string &name, std::unique_ptr<detail::IParam> param) override {
-            params_.emplace(detail::NameConverter<nameFormat>::name(name), std::move(param));
-        }
+        static void checkConfigFile(const turbo::filesystem::path &configFile) {
+            if (!turbo::filesystem::exists(configFile))
+                throw ConfigError{"Config file " + sfun::path_string(configFile) + " doesn't exist"};
 
-        void addValidator(std::unique_ptr<detail::IValidator> validator) override {
-            validators_.emplace_back((std::move(validator)));
+            if (!turbo::filesystem::is_regular_file(configFile))
+                throw ConfigError{
+                        "Can't open config file " + sfun::path_string(configFile) + " which is not a regular file"};
         }
 
-        void load(const TreeNode &treeNode) override {
-            for (const auto &[nodeName, node]: treeNode.asItem().nodes()) {
-                if (!nodes_.count(nodeName))
-                    throw ConfigError{"Unknown node '" + nodeName + "'", node.position()};
+        template<typename TParser>
+        void readConcurrently(
+                const turbo::filesystem::path *configFiles,
+                std::size_t count,
+                std::size_t threadCount,
+                const std::function<void(std::size_t, IParser &)> &readFile) {
+            auto errors = std::vector<std::optional<ConfigFilesError::FileError>>(count);
+            detail::runInParallel(count, threadCount, [&](std::size_t i) {
                 try {
-                    nodes_.at(nodeName)->load(node);
+                    auto parser = TParser{};
+                    readFile(i, parser);
                 }
-                catch (const detail::LoadingError &e) {
-                    throw ConfigError{"Node '" + nodeName + "': " + e.what(), node.position()};
+                catch (const std::exception &e) {
+                    errors[i] = ConfigFilesError::FileError{sfun::path_string(configFiles[i]), e.what()};
                 }
-            }
-
-            for (const auto &[paramName, param]: treeNode.asItem().params()) {
-                if (!params_.count(paramName))
-                    throw ConfigError{"Unknown param '" + paramName + "'", param.position()};
-                params_.at(paramName)->load(param);
-            }
-
-            checkLoadingResult();
+            });
+            auto fileErrors = std::vector<ConfigFilesError::FileError>{};
+            for (auto &error: errors)
+                if (error)
+                    fileErrors.push_back(std::move(*error));
+            if (!fileErrors.empty())
+                throw ConfigFilesError{std::move(fileErrors)};
         }
 
-        void checkLoadingResult() {
-            for (const auto &[name, param]: params_)
-                if (!param->hasValue())
-                    throw detail::LoadingError{"Parameter '" + name + "' is missing."};
-            for (const auto &[name, node]: nodes_)
-                if (!node->hasValue())
-                    throw detail::LoadingError{"Node '" + name + "' is missing."};
+        template<typename... TCfgs, std::size_t... indexes>
+        void readNth(
+                std::tuple<std::optional<TCfgs>...> &cfgs,
+                std::size_t index,
+                const turbo::filesystem::path &configFile,
+                IParser &parser,
+                std::index_sequence<indexes...>) {
+            auto readIndex = [&](auto &cfg, std::size_t cfgIndex) {
+                using Cfg = typename std::remove_reference_t<decltype(cfg)>::value_type;
+                if (cfgIndex == index)
+                    cfg.emplace(read_file<Cfg>(configFile, parser));
+            };
+            (readIndex(std::get<indexes>(cfgs), indexes), ...);
+        }
 
-            for (const auto &validator: validators_)
-                validator->validate();
+        template<typename TCfg>
+        bool hasSchemaFingerprint(const char *data, std::size_t size, UnboundSnapshot unboundSnapshot) {
+            const auto header = binary::readHeader(data, size);
+            if (!header)
+                return false;
+            if (header->fingerprint == 0)
+                return unboundSnapshot == UnboundSnapshot::Accept;
+            return header->fingerprint == schema_fingerprint<TCfg>();
         }
 
-        detail::ConfigReaderPtr makeNestedReader(const std::string &name) override {
-            nestedReaders_.emplace(name, std::make_unique<ConfigReader<nameFormat>>());
-            return nestedReaders_[name]->makePtr();
+        template<typename TCfg>
+        std::optional<TCfg> tryReadSnapshot(
+                const turbo::filesystem::path &snapshotFile,
+                const turbo::filesystem::path &configFile) {
+            auto error = std::error_code{};
+            if (!turbo::filesystem::is_regular_file(snapshotFile, error))
+                return {};
+            const auto snapshotTime = turbo::filesystem::last_write_time(snapshotFile, error);
+            if (error)
+                return {};
+            const auto configTime = turbo::filesystem::last_write_time(configFile, error);
+            if (!error && configTime > snapshotTime)
+                return {};
+
+            const auto file = detail::FileContent{snapshotFile, detail::FileAccess::Map};
+            if (!file.isOpen() || !hasSchemaFingerprint<TCfg>(file.data(), file.size(), UnboundSnapshot::Reject))
+                return {};
+            try {
+                auto parser = binary::Parser{};
+                return read<TCfg>(file.data(), file.size(), parser);
+            }
+            catch (const ConfigError &) {
+                // the config file is the source of truth, its own errors are reported if it can't be read either
+                return {};
+            }
         }
 
         template<typename TCfg>
-        TCfg read(std::istream &configStream, IParser &parser) {
-            clear();
+        static void checkConfigType() {
             if constexpr (!std::is_aggregate_v<TCfg>)
                 static_assert(
                         std::is_constructible_v<TCfg, detail::ConfigReaderPtr>,
                         "Non aggregate config objects must inherit tconf::Config constructors with 'using "
                         "Config::Config;'");
-            auto cfg = TCfg{makePtr()};
-            auto tree = parser.parse(configStream);
+        }
+
+        template<typename TCfg>
+        TCfg read(
+                const char *data,
+                std::size_t size,
+                IParser &parser,
+                std::pmr::memory_resource *memoryResource = nullptr) {
+            checkConfigType<TCfg>();
+            const auto &schema = detail::schemaOf<TCfg, nameFormat>();
+            auto cfg = TCfg{detail::ConfigReaderPtr{}};
+            auto ctx = detail::LoadingContext{nameFormat};
+            ctx.memoryResource = memoryResource;
+            auto binder = detail::ConfigBinder{schema, &cfg, ctx};
+            parser.visit(data, size, binder);
             try {
-                load(tree);
+                binder.finish();
             }
             catch (const detail::LoadingError &e) {
-                throw ConfigError{std::string{"Root node: "} + e.what(), tree.position()};
+                // reported at the same position as the root of a parsed tree
+                throw ConfigError{std::string{"Root node: "} + e.what(), StreamPosition{1, 1}};
             }
-            resetConfigReader(cfg);
             return cfg;
         }
 
-        void clear() {
-            nodes_.clear();
-            params_.clear();
-            nestedReaders_.clear();
-            validators_.clear();
+        template<typename TCfg>
+        ReadResult<TCfg> tryRead(const char *data, std::size_t size, IParser &parser) {
+            checkConfigType<TCfg>();
+            auto errors = std::vector<Diagnostic>{};
+            auto ctx = detail::LoadingContext{nameFormat};
+            ctx.errors = &errors;
+            auto cfg = TCfg{detail::ConfigReaderPtr{}};
+            try {
+                auto binder = detail::ConfigBinder{detail::schemaOf<TCfg, nameFormat>(), &cfg, ctx};
+                parser.visit(data, size, binder);
+                binder.finish();
+            }
+            catch (const ConfigError &e) {
+                // only the parser's errors are thrown while the errors are collected
+                errors.push_back(e.diagnostic());
+            }
+            if (!errors.empty())
+                return ReadResult<TCfg>{std::move(errors)};
+            return ReadResult<TCfg>{std::move(cfg)};
         }
 
-    private:
-        std::map<std::string, std::unique_ptr<detail::INode>> nodes_;
-        std::map<std::string, std::unique_ptr<detail::IParam>> params_;
-        std::map<std::string, std::unique_ptr<ConfigReader<nameFormat>>> nestedReaders_;
-        std::vector<std::unique_ptr<detail::IValidator>> validators_;
+        template<typename TCfg>
+        TCfg read(std::istream &configStream, IParser &parser) {
+            auto tree = parser.parse(configStream);
+            return read<TCfg>(tree);
+        }
     };
 
 }  // namespace tconf
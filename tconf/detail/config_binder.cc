@@ -0,0 +1,449 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/detail/config_binder.h"
+#include "tconf/detail/contract.h"
+#include "tconf/detail/loading_error.h"
+#include <tconf/errors.h>
+#include <utility>
+
+namespace tconf::detail {
+
+    ConfigBinder::ConfigBinder(
+            const Schema &schema,
+            void *cfg,
+            const LoadingContext &ctx,
+            const INode *rootNode,
+            const StreamPosition &rootPosition) {
+        pushConfig({&schema, cfg}, ctx, rootPosition, rootNode, nullptr);
+    }
+
+    void ConfigBinder::finish() {
+        sfun_precondition(frames_.size() == 1);
+        finishConfig(frames_.back());
+    }
+
+    void ConfigBinder::finishUpdate() {
+        sfun_precondition(frames_.size() == 1);
+        validate(frames_.back());
+    }
+
+    void ConfigBinder::beginNode(std::string_view name, const StreamPosition &position) {
+        beginChildNode(name, false, position);
+    }
+
+    void ConfigBinder::beginNodeList(std::string_view name, const StreamPosition &position) {
+        beginChildNode(name, true, position);
+    }
+
+    void ConfigBinder::beginListElement(const StreamPosition &position) {
+        auto &frame = frames_.back();
+        switch (frame.type) {
+            case FrameType::ConfigList: {
+                const auto ctx = frame.ctx;
+                const auto *listNode = frame.node;
+                pushConfig(listNode->addElement(frame.nodeValue, ctx), ctx, position, listNode, nullptr);
+                return;
+            }
+            case FrameType::Tree:
+                frame.treeBuilder->beginListElement(position);
+                return;
+            case FrameType::Skipped:
+                pushFrame(FrameType::Skipped, position, frame.ctx);
+                return;
+            default:
+                sfun_precondition(false && "list element outside of a node list");
+        }
+    }
+
+    void ConfigBinder::endNode() {
+        sfun_precondition(frames_.size() > 1);
+        auto &frame = frames_.back();
+        if (frame.type == FrameType::Config)
+            finishConfig(frame);
+        else if (frame.type == FrameType::Tree) {
+            if (frame.treeBuilder->hasOpenNodes()) {
+                frame.treeBuilder->endNode();
+                return;
+            }
+            loadTree(*frame.node, frame.nodeValue, *frame.treeNode, frame.ctx, *frame.fieldName);
+        }
+        if (frame.fieldIndex != FieldIndex::npos && errorCount(frame.ctx) != frame.errorCount)
+            markFailedField(frames_[frames_.size() - 2], frame.fieldIndex);
+        frames_.pop_back();
+    }
+
+    void ConfigBinder::param(std::string_view name, const TreeValue &value, const StreamPosition &position) {
+        auto &frame = frames_.back();
+        switch (frame.type) {
+            case FrameType::Config: {
+                const auto fieldIndex = frame.schema->paramIndex_.find(name);
+                if (fieldIndex == FieldIndex::npos) {
+                    reportError(frame.ctx, "Unknown param '" + std::string{name} + "'", position);
+                    return;
+                }
+                if (frame.loadedFields.test(fieldIndex)) {
+                    reportError(frame.ctx, "Parameter '" + std::string{name} + "' already exists", position);
+                    return;
+                }
+                frame.loadedFields.set(fieldIndex);
+                if (!frame.fieldPositions.empty())
+                    frame.fieldPositions[fieldIndex] = position;
+                const auto &field = frame.schema->fields_[fieldIndex];
+                const auto errors = errorCount(frame.ctx);
+                field.param->load(frame.cfg + field.offset, value, position, frame.ctx);
+                if (errorCount(frame.ctx) != errors)
+                    markFailedField(frame, fieldIndex);
+                return;
+            }
+            case FrameType::Dict:
+                frame.node->addElement(frame.nodeValue, name, value, position, frame.ctx);
+                return;
+            case FrameType::ConfigDict:
+                reportError(
+                        frame.ctx,
+                        frame.node->description() + ": element '" + std::string{name} + "' must be a config node.",
+                        position);
+                return;
+            case FrameType::Tree:
+                frame.treeBuilder->param(name, value, position);
+                return;
+            case FrameType::Skipped:
+                return;
+            default:
+                sfun_precondition(false && "param inside of a node list");
+        }
+    }
+
+    void ConfigBinder::paramList(std::string_view name, TreeValueList valueList, const StreamPosition &position) {
+        auto &frame = frames_.back();
+        switch (frame.type) {
+            case FrameType::Config: {
+                const auto fieldIndex = frame.schema->paramIndex_.find(name);
+                if (fieldIndex == FieldIndex::npos) {
+                    reportError(frame.ctx, "Unknown param '" + std::string{name} + "'", position);
+                    return;
+                }
+                if (frame.loadedFields.test(fieldIndex)) {
+                    reportError(frame.ctx, "Parameter list '" + std::string{name} + "' already exists", position);
+                    return;
+                }
+                frame.loadedFields.set(fieldIndex);
+                if (!frame.fieldPositions.empty())
+                    frame.fieldPositions[fieldIndex] = position;
+                const auto &field = frame.schema->fields_[fieldIndex];
+                const auto errors = errorCount(frame.ctx);
+                field.param->load(frame.cfg + field.offset, valueList, position, frame.ctx);
+                if (errorCount(frame.ctx) != errors)
+                    markFailedField(frame, fieldIndex);
+                return;
+            }
+            case FrameType::Dict:
+                reportError(frame.ctx, frame.node->description() + ": config parameter can't be a list.", position);
+                return;
+            case FrameType::ConfigDict:
+                reportError(
+                        frame.ctx,
+                        frame.node->description() + ": element '" + std::string{name} + "' must be a config node.",
+                        position);
+                return;
+            case FrameType::Tree:
+                frame.treeBuilder->paramList(name, valueList, position);
+                return;
+            case FrameType::Skipped:
+                return;
+            default:
+                sfun_precondition(false && "param list inside of a node list");
+        }
+    }
+
+    void ConfigBinder::expectNodes(std::size_t count) {
+        const auto &frame = frames_.back();
+        if (frame.type == FrameType::ConfigDict)
+            frame.node->reserve(frame.nodeValue, count);
+    }
+
+    void ConfigBinder::expectParams(std::size_t count) {
+        const auto &frame = frames_.back();
+        if (frame.type == FrameType::Dict)
+            frame.node->reserve(frame.nodeValue, count);
+    }
+
+    bool ConfigBinder::visitSubtree(std::string_view name, const TreeNode &node) {
+        auto &frame = frames_.back();
+        if (frame.type != FrameType::Config)
+            return false;
+        const auto fieldIndex = frame.schema->nodeIndex_.find(name);
+        if (fieldIndex == FieldIndex::npos)
+            return false;
+        const auto &field = frame.schema->fields_[fieldIndex];
+        if (field.node->binding() != NodeBinding::Tree)
+            return false;
+
+        if (markLoadedField(frame, name, node.isList(), node.position()) == FieldIndex::npos)
+            return true;
+        if (!checkNodeKind(frame, fieldIndex, node.isList(), node.position()))
+            return true;
+        const auto errors = errorCount(frame.ctx);
+        loadTree(*field.node, frame.cfg + field.offset, node, frame.ctx, field.name);
+        if (errorCount(frame.ctx) != errors)
+            markFailedField(frame, fieldIndex);
+        return true;
+    }
+
+    void ConfigBinder::beginChildNode(std::string_view name, bool isList, const StreamPosition &position) {
+        auto &frame = frames_.back();
+        switch (frame.type) {
+            case FrameType::Config:
+                beginField(name, isList, position);
+                return;
+            case FrameType::Tree:
+                if (isList)
+                    frame.treeBuilder->beginNodeList(name, position);
+                else
+                    frame.treeBuilder->beginNode(name, position);
+                return;
+            case FrameType::ConfigDict:
+                beginDictElement(name, isList, position);
+                return;
+            case FrameType::Dict:
+            case FrameType::Skipped:
+                // nested nodes of a dictionary aren't loaded
+                pushFrame(FrameType::Skipped, position, frame.ctx);
+                return;
+            default:
+                sfun_precondition(false && "named node inside of a node list");
+        }
+    }
+
+    void ConfigBinder::beginField(std::string_view name, bool isList, const StreamPosition &position) {
+        auto &frame = frames_.back();
+        const auto fieldIndex = markLoadedField(frame, name, isList, position);
+        if (fieldIndex == FieldIndex::npos || !checkNodeKind(frame, fieldIndex, isList, position)) {
+            pushFrame(FrameType::Skipped, position, frame.ctx);
+            return;
+        }
+        const auto &field = frame.schema->fields_[fieldIndex];
+        const auto &node = *field.node;
+        auto nodeValue = static_cast<void *>(frame.cfg + field.offset);
+        const auto ctx = frame.ctx;
+        switch (node.binding()) {
+            case NodeBinding::Config:
+                pushConfig(node.begin(nodeValue, isList, position, ctx), ctx, position, nullptr, &field.name);
+                frames_.back().fieldIndex = fieldIndex;
+                break;
+            case NodeBinding::ConfigList:
+            case NodeBinding::Dict:
+            case NodeBinding::ConfigDict: {
+                node.begin(nodeValue, isList, position, ctx);
+                auto frameType = FrameType::ConfigList;
+                if (node.binding() == NodeBinding::Dict)
+                    frameType = FrameType::Dict;
+                else if (node.binding() == NodeBinding::ConfigDict)
+                    frameType = FrameType::ConfigDict;
+                auto &nodeFrame = pushFrame(frameType, position, ctx);
+                nodeFrame.node = &node;
+                nodeFrame.nodeValue = nodeValue;
+                nodeFrame.fieldName = &field.name;
+                nodeFrame.fieldIndex = fieldIndex;
+                break;
+            }
+            case NodeBinding::Tree: {
+                auto &treeFrame = pushFrame(FrameType::Tree, position, ctx);
+                treeFrame.node = &node;
+                treeFrame.nodeValue = nodeValue;
+                treeFrame.fieldName = &field.name;
+                treeFrame.fieldIndex = fieldIndex;
+                // the builder refers to the field's node owned by the tree's document,
+                // so it stays valid when the frame is moved
+                auto &root = treeFrame.tree.emplace(makeTreeRoot()).asItem();
+                treeFrame.treeNode = isList ? &root.addNodeList(name, position) : &root.addNode(name, position);
+                treeFrame.treeBuilder.emplace(*treeFrame.treeNode);
+                break;
+            }
+        }
+    }
+
+    void ConfigBinder::beginDictElement(std::string_view key, bool isList, const StreamPosition &position) {
+        auto &frame = frames_.back();
+        const auto ctx = frame.ctx;
+        const auto *dictNode = frame.node;
+        if (isList) {
+            reportError(ctx, dictNode->description() + ": element '" + std::string{key} + "' can't be a list.", position);
+            pushFrame(FrameType::Skipped, position, ctx);
+            return;
+        }
+        const auto boundConfig = dictNode->addElement(frame.nodeValue, key, position, ctx);
+        if (!boundConfig.cfg) {
+            pushFrame(FrameType::Skipped, position, ctx);
+            return;
+        }
+        pushConfig(boundConfig, ctx, position, dictNode, nullptr);
+        frames_.back().elementKey = key;
+    }
+
+    std::size_t ConfigBinder::markLoadedField(
+            Frame &frame,
+            std::string_view name,
+            bool isList,
+            const StreamPosition &position) {
+        const auto fieldIndex = frame.schema->nodeIndex_.find(name);
+        if (fieldIndex == FieldIndex::npos) {
+            reportError(frame.ctx, "Unknown node '" + std::string{name} + "'", position);
+            return FieldIndex::npos;
+        }
+        if (frame.loadedFields.test(fieldIndex)) {
+            reportError(
+                    frame.ctx,
+                    std::string{isList ? "Node list '" : "Node '"} + std::string{name} + "' already exists",
+                    position);
+            return FieldIndex::npos;
+        }
+        frame.loadedFields.set(fieldIndex);
+        if (!frame.fieldPositions.empty())
+            frame.fieldPositions[fieldIndex] = position;
+        return fieldIndex;
+    }
+
+    bool ConfigBinder::checkNodeKind(
+            Frame &frame,
+            std::size_t fieldIndex,
+            bool isList,
+            const StreamPosition &position) const {
+        const auto &node = *frame.schema->fields_[fieldIndex].node;
+        const auto isListNode = node.structure() == NodeBinding::ConfigList;
+        if (isList == isListNode)
+            return true;
+        reportError(
+                frame.ctx,
+                node.description() + (isListNode ? ": config node must be a list." : ": config node can't be a list."),
+                position);
+        markFailedField(frame, fieldIndex);
+        return false;
+    }
+
+    void ConfigBinder::markFailedField(Frame &frame, std::size_t fieldIndex) {
+        frame.failedFields.set(fieldIndex);
+    }
+
+    void ConfigBinder::loadTree(
+            const INode &node,
+            void *nodeValue,
+            const TreeNode &treeNode,
+            const LoadingContext &ctx,
+            const std::string &fieldName) const {
+        try {
+            node.load(nodeValue, treeNode, ctx);
+        }
+        catch (const LoadingError &e) {
+            reportError(ctx, "Node '" + fieldName + "': " + e.what(), treeNode.position());
+        }
+        catch (const ConfigError &e) {
+            // the errors of the nodes checking their trees on their own, e.g. the lazy ones
+            if (!ctx.errors)
+                throw;
+            ctx.errors->push_back(e.diagnostic());
+        }
+    }
+
+    void ConfigBinder::pushConfig(
+            const BoundConfig &boundConfig,
+            const LoadingContext &ctx,
+            const StreamPosition &position,
+            const INode *listNode,
+            const std::string *fieldName) {
+        auto &frame = pushFrame(FrameType::Config, position, ctx);
+        frame.node = listNode;
+        frame.fieldName = fieldName;
+        frame.schema = boundConfig.schema;
+        frame.cfg = static_cast<char *>(boundConfig.cfg);
+        frame.loadedFields = FieldSet{boundConfig.schema->fields_.size()};
+        if (!boundConfig.schema->validators_.empty())
+            frame.fieldPositions.resize(boundConfig.schema->fields_.size());
+        if (ctx.errors)
+            frame.failedFields = FieldSet{boundConfig.schema->fields_.size()};
+    }
+
+    ConfigBinder::Frame &ConfigBinder::pushFrame(FrameType type, const StreamPosition &position, const LoadingContext &ctx) {
+        auto &frame = frames_.emplace_back();
+        frame.type = type;
+        frame.position = position;
+        frame.ctx = ctx;
+        frame.errorCount = errorCount(ctx);
+        return frame;
+    }
+
+    void ConfigBinder::finishConfig(const Frame &frame) const {
+        try {
+            checkMissingFields(frame);
+        }
+        catch (const LoadingError &e) {
+            if (frame.fieldName || frame.node)
+                throw ConfigError{nodeDescription(frame) + ": " + e.what(), frame.position};
+            throw;
+        }
+        validate(frame);
+    }
+
+    std::string ConfigBinder::nodeDescription(const Frame &frame) {
+        if (frame.fieldName)
+            return "Node '" + *frame.fieldName + "'";
+        if (!frame.elementKey.empty())
+            return frame.node->description() + " element '" + frame.elementKey + "'";
+        return frame.node->description();
+    }
+
+    void ConfigBinder::checkMissingFields(const Frame &frame) const {
+        if (!frame.ctx.checkMissingFields || frame.loadedFields.all())
+            return;
+        // the collected errors get the prefix that's added to LoadingError by the catching code
+        const auto report = [&](const std::string &message) {
+            if (!frame.ctx.errors)
+                throw LoadingError{message};
+            if (frame.fieldName || frame.node)
+                reportError(frame.ctx, nodeDescription(frame) + ": " + message, frame.position);
+            else
+                reportError(frame.ctx, "Root node: " + message, frame.position);
+        };
+        const auto &fields = frame.schema->fields_;
+        for (auto i = std::size_t{}; i < fields.size(); ++i) {
+            const auto &field = fields[i];
+            if (frame.loadedFields.test(i))
+                continue;
+            if (field.param && !field.param->isOptional())
+                report("Parameter '" + field.name + "' is missing.");
+            if (field.node && !field.node->isOptional())
+                report("Node '" + field.name + "' is missing.");
+        }
+    }
+
+    void ConfigBinder::validate(const Frame &frame) const {
+        const auto &schema = *frame.schema;
+        for (const auto &validator: schema.validators_) {
+            if (frame.ctx.errors && frame.failedFields.test(validator.fieldIndex))
+                continue;
+            try {
+                validator.run(frame.cfg);
+            }
+            catch (const ValidationError &e) {
+                reportError(
+                        frame.ctx,
+                        schema.entity(schema.fields_[validator.fieldIndex]).description() + ": " + e.what(),
+                        frame.fieldPositions[validator.fieldIndex]);
+            }
+        }
+    }
+
+} //namespace tconf::detail
@@ -0,0 +1,154 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "tconf/detail/field_index.h"
+#include "tconf/detail/inode.h"
+#include "tconf/detail/loading_context.h"
+#include "tconf/detail/schema.h"
+#include <tconf/tree/itree_visitor.h>
+#include <tconf/tree/stream_position.h>
+#include <tconf/tree/tree_builder.h>
+#include <tconf/tree/tree.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tconf::detail {
+
+    ///
+    /// Loads a config from the structure reported by a parser: visited nodes and params are dispatched
+    /// to the schema fields as they arrive, without building an intermediate tree. The nodes with the tree
+    /// binding are the exception, they're collected into a tree and loaded with INode::load().
+    /// If the context collects errors, a failed field is skipped with its subtree and the loading goes on,
+    /// the validators of the failed fields aren't run.
+    ///
+    class ConfigBinder : public ITreeVisitor {
+    public:
+        /// rootNode is the entity of a loaded list element, it's used in the messages of the root's missing fields
+        ConfigBinder(
+                const Schema &schema,
+                void *cfg,
+                const LoadingContext &ctx,
+                const INode *rootNode = nullptr,
+                const StreamPosition &rootPosition = {1, 1});
+
+        /// Completes loading of the root config, its missing fields are reported with LoadingError
+        void finish();
+
+        /// Completes loading of the fields bound over an already loaded root config, only its validators are run
+        void finishUpdate();
+
+        void beginNode(std::string_view name, const StreamPosition &position) override;
+
+        void beginNodeList(std::string_view name, const StreamPosition &position) override;
+
+        void beginListElement(const StreamPosition &position) override;
+
+        void endNode() override;
+
+        void param(std::string_view name, const TreeValue &value, const StreamPosition &position) override;
+
+        void paramList(std::string_view name, TreeValueList valueList, const StreamPosition &position) override;
+
+        /// The dictionaries are pre-sized for the expected count of their elements
+        void expectNodes(std::size_t count) override;
+
+        void expectParams(std::size_t count) override;
+
+        /// The fields loaded from a tree are given the visited subtree instead of collecting its copy
+        bool visitSubtree(std::string_view name, const TreeNode &node) override;
+
+    private:
+        enum class FrameType {
+            Config,
+            ConfigList,
+            Dict,
+            ConfigDict,
+            Tree,
+            Skipped
+        };
+
+        struct Frame {
+            FrameType type = FrameType::Config;
+            StreamPosition position;
+            LoadingContext ctx;
+            /// entity of the bound node field, for the config frames it's set only for the list elements
+            const INode *node = nullptr;
+            void *nodeValue = nullptr;
+            /// name of the bound schema field, it isn't set for the root and the list elements
+            const std::string *fieldName = nullptr;
+            /// key of a config dictionary element, the dictionary is the frame's node
+            std::string elementKey;
+            /// index of the bound field in the parent config, it's marked as failed if the frame reports errors
+            std::size_t fieldIndex = FieldIndex::npos;
+            std::size_t errorCount = 0;
+            // Config frames
+            const Schema *schema = nullptr;
+            char *cfg = nullptr;
+            FieldSet loadedFields{0};
+            std::vector<StreamPosition> fieldPositions;
+            FieldSet failedFields{0};
+            // Tree frames
+            std::optional<TreeNode> tree;
+            TreeNode *treeNode = nullptr;
+            std::optional<TreeBuilder> treeBuilder;
+        };
+
+        void beginChildNode(std::string_view name, bool isList, const StreamPosition &position);
+
+        void beginField(std::string_view name, bool isList, const StreamPosition &position);
+
+        void beginDictElement(std::string_view key, bool isList, const StreamPosition &position);
+
+        /// Returns FieldIndex::npos if the error is collected and the node must be skipped
+        std::size_t markLoadedField(Frame &frame, std::string_view name, bool isList, const StreamPosition &position);
+
+        bool checkNodeKind(Frame &frame, std::size_t fieldIndex, bool isList, const StreamPosition &position) const;
+
+        static void markFailedField(Frame &frame, std::size_t fieldIndex);
+
+        void loadTree(
+                const INode &node,
+                void *nodeValue,
+                const TreeNode &treeNode,
+                const LoadingContext &ctx,
+                const std::string &fieldName) const;
+
+        void pushConfig(
+                const BoundConfig &boundConfig,
+                const LoadingContext &ctx,
+                const StreamPosition &position,
+                const INode *listNode,
+                const std::string *fieldName);
+
+        Frame &pushFrame(FrameType type, const StreamPosition &position, const LoadingContext &ctx);
+
+        void finishConfig(const Frame &frame) const;
+
+        /// Returns the description of a config frame's node used as the prefix of its messages
+        static std::string nodeDescription(const Frame &frame);
+
+        void checkMissingFields(const Frame &frame) const;
+
+        void validate(const Frame &frame) const;
+
+    private:
+        std::vector<Frame> frames_;
+    };
+
+} //namespace tconf::detail
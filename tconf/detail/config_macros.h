@@ -21,10 +21,10 @@
 #include "tconf/detail/param_creator.h"
 #include "tconf/detail/paramlist_creator.h"
 
-#define TCONF_PARAM(name, type) type name = param<&std::remove_pointer_t<decltype(this)>::name>(#name)
-#define TCONF_NODE(name, type) type name = node<&std::remove_pointer_t<decltype(this)>::name>(#name)
+#define TCONF_PARAM(name, type) type name = param<&std::remove_pointer_t<decltype(this)>::name>()
+#define TCONF_NODE(name, type) type name = node<&std::remove_pointer_t<decltype(this)>::name>()
 #define TCONF_COPY_NODE_LIST(name, listType)                                                                          \
-    listType name = copyNodeList<&std::remove_pointer_t<decltype(this)>::name>(#name)
-#define TCONF_NODE_LIST(name, listType) listType name = nodeList<&std::remove_pointer_t<decltype(this)>::name>(#name)
-#define TCONF_PARAM_LIST(name, listType) listType name = paramList<&std::remove_pointer_t<decltype(this)>::name>(#name)
-#define TCONF_DICT(name, mapType) mapType name = dict<&std::remove_pointer_t<decltype(this)>::name>(#name)
\ No newline at end of file
+    listType name = copyNodeList<&std::remove_pointer_t<decltype(this)>::name>()
+#define TCONF_NODE_LIST(name, listType) listType name = nodeList<&std::remove_pointer_t<decltype(this)>::name>()
+#define TCONF_PARAM_LIST(name, listType) listType name = paramList<&std::remove_pointer_t<decltype(this)>::name>()
+#define TCONF_DICT(name, mapType) mapType name = dict<&std::remove_pointer_t<decltype(this)>::name>()
\ No newline at end of file
@@ -0,0 +1,153 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "tconf/detail/config_updater.h"
+#include "tconf/detail/config_binder.h"
+#include "tconf/detail/field_index.h"
+#include <tconf/tree/itree_visitor.h>
+#include <optional>
+
+namespace tconf::detail {
+
+    namespace {
+        std::string joinPath(const std::string &path, std::string_view name) {
+            if (path.empty())
+                return std::string{name};
+            auto result = path;
+            result += '.';
+            result += name;
+            return result;
+        }
+
+        bool hasSameFields(const TreeNode::Item &previous, const TreeNode::Item &current) {
+            if (previous.paramsCount() != current.paramsCount() || previous.nodesCount() != current.nodesCount())
+                return false;
+            for (const auto &[name, param]: current.params())
+                if (!previous.hasParam(name))
+                    return false;
+            for (const auto &[name, node]: current.nodes())
+                if (!previous.hasNode(name))
+                    return false;
+            return true;
+        }
+    } //namespace
+
+    ConfigUpdater::ConfigUpdater(const LoadingContext &ctx)
+            : ctx_{ctx} {
+    }
+
+    bool ConfigUpdater::update(const Schema &schema, void *cfg, const TreeNode &previousTree, const TreeNode &tree) {
+        changedFields_.clear();
+        return updateConfig(schema, cfg, previousTree, tree, {});
+    }
+
+    const std::vector<std::string> &ConfigUpdater::changedFields() const {
+        return changedFields_;
+    }
+
+    bool ConfigUpdater::updateConfig(
+            const Schema &schema,
+            void *cfg,
+            const TreeNode &previous,
+            const TreeNode &current,
+            const std::string &path) {
+        if (!previous.isItem() || !current.isItem())
+            return false;
+        if (previous.contentHash() == current.contentHash())
+            return true;
+        const auto &previousItem = previous.asItem();
+        const auto &currentItem = current.asItem();
+        if (!hasSameFields(previousItem, currentItem))
+            return false;
+
+        const auto changesCount = changedFields_.size();
+        auto binder = std::optional<ConfigBinder>{};
+        auto bind = [&]() -> ConfigBinder & {
+            if (!binder)
+                binder.emplace(schema, cfg, ctx_);
+            return *binder;
+        };
+
+        for (const auto &[name, param]: currentItem.params()) {
+            const auto &previousParam = previousItem.param(name);
+            if (param.isList() == previousParam.isList() && param.contentHash() == previousParam.contentHash())
+                continue;
+            if (param.isItem())
+                bind().param(name, param.typedValue(), param.position());
+            else
+                bind().paramList(name, param.valueListView(), param.position());
+            changedFields_.push_back(joinPath(path, name));
+        }
+
+        for (const auto &[name, node]: currentItem.nodes()) {
+            const auto &previousNode = previousItem.node(name);
+            if (node.isList() == previousNode.isList() && node.contentHash() == previousNode.contentHash())
+                continue;
+
+            const auto nodePath = joinPath(path, name);
+            const auto fieldIndex = schema.nodeIndex_.find(name);
+            if (fieldIndex != FieldIndex::npos && node.isList() == previousNode.isList()) {
+                const auto &field = schema.fields_[fieldIndex];
+                auto nodeValue = static_cast<void *>(static_cast<char *>(cfg) + field.offset);
+                if (field.node->binding() == NodeBinding::Config && node.isItem()) {
+                    const auto loadedConfig = field.node->loadedConfig(nodeValue, ctx_);
+                    if (!loadedConfig.cfg ||
+                        !updateConfig(*loadedConfig.schema, loadedConfig.cfg, previousNode, node, nodePath))
+                        return false;
+                    continue;
+                }
+                if (field.node->binding() == NodeBinding::ConfigList && node.isList() &&
+                    updateNodeList(*field.node, nodeValue, previousNode, node, nodePath))
+                    continue;
+            }
+            // dictionaries, copy node lists and resized node lists are loaded completely
+            visitNode(name, node, bind());
+            changedFields_.push_back(nodePath);
+        }
+
+        // a validator of a config node field checks its content, so it's run for the nested changes too
+        if (changedFields_.size() != changesCount)
+            bind().finishUpdate();
+        return true;
+    }
+
+    bool ConfigUpdater::updateNodeList(
+            const INode &node,
+            void *nodeValue,
+            const TreeNode &previous,
+            const TreeNode &current,
+            const std::string &path) {
+        const auto &previousList = previous.asList();
+        const auto &currentList = current.asList();
+        if (previousList.count() != currentList.count())
+            return false;
+
+        const auto changesCount = changedFields_.size();
+        for (auto i = 0; i < currentList.count(); ++i) {
+            const auto &element = currentList.node(i);
+            const auto &previousElement = previousList.node(i);
+            if (element.contentHash() == previousElement.contentHash())
+                continue;
+            const auto loadedElement = node.loadedElement(nodeValue, static_cast<std::size_t>(i), ctx_);
+            if (!loadedElement.cfg ||
+                !updateConfig(*loadedElement.schema, loadedElement.cfg, previousElement, element,
+                              path + "." + std::to_string(i))) {
+                changedFields_.resize(changesCount);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} //namespace tconf::detail
@@ -0,0 +1,67 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "tconf/detail/inode.h"
+#include "tconf/detail/loading_context.h"
+#include "tconf/detail/schema.h"
+#include <tconf/tree/tree.h>
+#include <string>
+#include <vector>
+
+namespace tconf::detail {
+
+    ///
+    /// Loads a new tree over the config loaded from the previous one: the subtrees with equal content hashes
+    /// are skipped, the changed params, dictionaries and node lists are loaded with ConfigBinder, and
+    /// the changed config nodes and node list elements are updated recursively. The validators are run
+    /// for the configs that contain the changed fields.
+    ///
+    class ConfigUpdater {
+    public:
+        explicit ConfigUpdater(const LoadingContext &ctx);
+
+        ///
+        /// Returns false if a config node has gained or lost a field or can't be updated in place,
+        /// such config must be loaded completely. The config's state is unspecified in that case
+        /// or if an error is thrown.
+        ///
+        bool update(const Schema &schema, void *cfg, const TreeNode &previousTree, const TreeNode &tree);
+
+        /// dotted paths of the loaded fields
+        const std::vector<std::string> &changedFields() const;
+
+    private:
+        bool updateConfig(
+                const Schema &schema,
+                void *cfg,
+                const TreeNode &previous,
+                const TreeNode &current,
+                const std::string &path);
+
+        bool updateNodeList(
+                const INode &node,
+                void *nodeValue,
+                const TreeNode &previous,
+                const TreeNode &current,
+                const std::string &path);
+
+    private:
+        LoadingContext ctx_;
+        std::vector<std::string> changedFields_;
+    };
+
+} //namespace tconf::detail
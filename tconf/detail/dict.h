@@ -15,85 +15,163 @@
 
 #pragma once
 
+#include "tconf/detail/config_reader_ptr.h"
 #include "tconf/detail/inode.h"
+#include "tconf/detail/memory_resource.h"
 #include "tconf/detail/param.h"
+#include "tconf/detail/schema.h"
 #include "tconf/detail/utils.h"
 #include "tconf/detail/type_traits.h"
 #include <tconf/tree/tree.h>
 #include <map>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+
+namespace tconf {
+    class Config;
+}
 
 namespace tconf::detail {
 
     template<typename TMap>
     class Dict : public INode {
     public:
-        explicit Dict(std::string name, TMap &dictMap)
-                : name_{std::move(name)}, dictMap_{dictMap} {
+        explicit Dict(std::string name)
+                : name_{std::move(name)} {
             static_assert(
                     sfun::is_associative_container_v < sfun::remove_optional_t < TMap >> ,
                     "Dictionary field must be an associative container or an associative container placed in "
                     "std::optional");
             static_assert(
-                    std::is_same_v<typename sfun::remove_optional_t<TMap>::key_type, std::string>,
-                    "Dictionary associative container's key type must be std::string");
+                    sfun::is_basic_string_v<typename sfun::remove_optional_t<TMap>::key_type>,
+                    "Dictionary associative container's key type must be std::string or a string with another "
+                    "allocator");
         }
 
         void markValueIsSet() {
-            hasValue_ = true;
+            hasDefaultValue_ = true;
         }
 
     private:
-        void load(const TreeNode &node) override {
-            hasValue_ = true;
-            position_ = node.position();
-            if (!node.isItem())
-                throw ConfigError{"Dictionary '" + name_ + "': config node can't be a list.", node.position()};
-            if constexpr (sfun::is_optional_v < TMap >)
-                dictMap_.emplace();
-            maybeOptValue(dictMap_).clear();
-
-            for (const auto &[paramName, paramValue]: node.asItem().params()) {
-                using Param = typename sfun::remove_optional_t<TMap>::mapped_type;
-                const auto paramNameStr = paramName;
-                const auto paramValueStr = paramValue;
-                auto paramReadResult = convertFromString<Param>(paramValueStr.value());
+        using DictMap = sfun::remove_optional_t<TMap>;
+        using Value = typename DictMap::mapped_type;
+        /// the elements of a dictionary of configs are the child nodes instead of the params
+        static constexpr auto isConfigDict = std::is_base_of_v<Config, Value>;
+
+        NodeBinding binding() const override {
+            return isConfigDict ? NodeBinding::ConfigDict : NodeBinding::Dict;
+        }
+
+        BoundConfig begin(void *value, bool isList, const StreamPosition &position, const LoadingContext &ctx)
+                const override {
+            if (isList)
+                throw ConfigError{"Dictionary '" + name_ + "': config node can't be a list.", position};
+            resetContainer(*static_cast<TMap *>(value), ctx);
+            return {};
+        }
+
+        void addElement(
+                void *value,
+                std::string_view key,
+                const TreeValue &paramValue,
+                const StreamPosition &position,
+                const LoadingContext &ctx) const override {
+            if constexpr (isConfigDict)
+                INode::addElement(value, key, paramValue, position, ctx);
+            else {
+                auto &dictMap = maybeOptValue(*static_cast<TMap *>(value));
+                auto paramReadResult = convertFromValue<Value>(paramValue);
                 auto readResultVisitor = sfun::overloaded{
-                        [&](const Param &param) {
-                            maybeOptValue(dictMap_).emplace(paramNameStr, param);
+                        [&](Value &param) {
+                            if (!emplaceElement(dictMap, key, std::move(param)).second)
+                                reportError(ctx, "Parameter '" + std::string{key} + "' already exists", position);
                         },
                         [&](const StringConversionError &error) {
-                            throw ConfigError{
-                                    "Couldn't set dict element'" + name_ + "' value from '" + paramValueStr.value() +
-                                    "'" +
-                                    (!error.message.empty() ? ": " + error.message : ""),
-                                    position_};
+                            reportError(
+                                    ctx,
+                                    "Couldn't set dict element'" + name_ + "' value from '" + paramValue.text() +
+                                            "'" + (!error.message.empty() ? ": " + error.message : ""),
+                                    position);
                         }};
                 std::visit(readResultVisitor, paramReadResult);
             }
         }
 
-        bool hasValue() const override {
-            if constexpr (sfun::is_optional_v < TMap >)
-                return true;
+        BoundConfig addElement(
+                void *value,
+                std::string_view key,
+                const StreamPosition &position,
+                const LoadingContext &ctx) const override {
+            if constexpr (isConfigDict) {
+                auto &dictMap = maybeOptValue(*static_cast<TMap *>(value));
+                auto [it, isAdded] = emplaceElement(dictMap, key, Value{ConfigReaderPtr{}});
+                if (!isAdded) {
+                    reportError(ctx, "Node '" + std::string{key} + "' already exists", position);
+                    return {};
+                }
+                return {&schemaOf<Value>(ctx.nameFormat), &it->second};
+            }
             else
-                return hasValue_;
+                return INode::addElement(value, key, position, ctx);
+        }
+
+        void reserve(void *value, std::size_t count) const override {
+            if constexpr (sfun::has_reserve_v<DictMap>) {
+                auto &dictMap = maybeOptValue(*static_cast<TMap *>(value));
+                dictMap.reserve(dictMap.size() + count);
+            }
+        }
+
+        const Schema *schema(const LoadingContext &ctx) const override {
+            if constexpr (isConfigDict)
+                return &schemaOf<Value>(ctx.nameFormat);
+            else
+                return nullptr;
+        }
+
+        /// Returns the element and whether it's added, the elements with repeated keys are always added
+        /// to the multimaps
+        static std::pair<typename DictMap::iterator, bool> emplaceElement(
+                DictMap &dictMap,
+                std::string_view key,
+                Value &&value) {
+            // a pmr map constructs the key and the value with its own allocator
+            if constexpr (sfun::is_unordered_container_v<DictMap>) {
+                auto result = dictMap.emplace(
+                        std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                        std::forward_as_tuple(std::move(value)));
+                if constexpr (std::is_same_v<decltype(result), typename DictMap::iterator>)
+                    return {result, true};
+                else
+                    return result;
+            }
+            else {
+                // the keys of the sorted configs are appended without searching the tree
+                const auto size = dictMap.size();
+                auto it = dictMap.emplace_hint(
+                        dictMap.end(),
+                        std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                        std::forward_as_tuple(std::move(value)));
+                return {it, dictMap.size() != size};
+            }
         }
 
-        StreamPosition position() override {
-            return position_;
+        bool isOptional() const override {
+            return sfun::is_optional_v<TMap> || hasDefaultValue_;
         }
 
-        std::string description() override {
+        std::string description() const override {
             return "Dictionary '" + name_ + "'";
         }
 
     private:
         std::string name_;
-        TMap &dictMap_;
-        bool hasValue_ = false;
-        StreamPosition position_;
+        bool hasDefaultValue_ = false;
     };
 
 } //namespace tconf::detail
\ No newline at end of file
@@ -15,22 +15,24 @@
 
 #pragma once
 #include "tconf/detail/dict.h"
+#include "tconf/detail/field_name.h"
 #include "tconf/detail/iconfig_reader.h"
 #include "tconf/detail/validator.h"
 #include "tconf/detail/contract.h"
 #include "tconf/detail/type_traits.h"
 #include "tconf/name_format.h"
 #include <memory>
+#include <type_traits>
 
 namespace tconf::detail {
 
 template<typename TMap>
 class DictCreator {
 public:
-    DictCreator(ConfigReaderPtr cfgReader, std::string dictName, TMap& dictMap)
+    DictCreator(ConfigReaderPtr cfgReader, FieldName dictName, TMap& dictMap)
         : cfgReader_{cfgReader}
-        , dictName_{(sfun_precondition(!dictName.empty()), std::move(dictName))}
-        , dict_{std::make_unique<Dict<TMap>>(dictName_, dictMap)}
+        , dictName_{(sfun_precondition(!dictName.original().empty()), std::move(dictName))}
+        , dict_{cfgReader_ ? std::make_unique<Dict<TMap>>(std::string{dictName_.original()}) : nullptr}
         , dictMap_{dictMap}
     {
         static_assert(
@@ -38,13 +40,15 @@ public:
                 "Dictionary field must be an associative container or an associative container placed in "
                 "std::optional");
         static_assert(
-                std::is_same_v<typename sfun::remove_optional_t<TMap>::key_type, std::string>,
-                "Dictionary associative container's key type must be std::string");
+                sfun::is_basic_string_v<typename sfun::remove_optional_t<TMap>::key_type>,
+                "Dictionary associative container's key type must be std::string or a string with another "
+                "allocator");
     }
 
     DictCreator& operator()(TMap defaultValue = {})
     {
-        dict_->markValueIsSet();
+        if (dict_)
+            dict_->markValueIsSet();
         defaultValue_ = std::move(defaultValue);
         return *this;
     }
@@ -52,14 +56,17 @@ public:
     operator TMap()
     {
         if (cfgReader_)
-            cfgReader_->addNode(dictName_, std::move(dict_));
+            cfgReader_->addNode(dictName_, std::move(dict_), &dictMap_);
         return defaultValue_;
     }
 
-    DictCreator& checkedWith(std::function<void(const TMap&)> validatingFunc)
+    template<
+            typename TValidatingFunc,
+            typename = std::enable_if_t<std::is_invocable_v<TValidatingFunc&, const TMap&>>>
+    DictCreator& checkedWith(TValidatingFunc validatingFunc)
     {
         if (cfgReader_)
-            cfgReader_->addValidator(std::make_unique<Validator<TMap>>(*dict_, dictMap_, std::move(validatingFunc)));
+            cfgReader_->addValidator(Validator::of<TMap>(std::move(validatingFunc)), *dict_, &dictMap_);
         return *this;
     }
 
@@ -68,13 +75,15 @@ public:
     {
         if (cfgReader_)
             cfgReader_->addValidator(
-                    std::make_unique<Validator<TMap>>(*dict_, dictMap_, TValidator{std::forward<TArgs>(args)...}));
+                    Validator::of<TMap>(TValidator{std::forward<TArgs>(args)...}),
+                    *dict_,
+                    &dictMap_);
         return *this;
     }
 
 private:
     ConfigReaderPtr cfgReader_;
-    std::string dictName_;
+    FieldName dictName_;
     std::unique_ptr<Dict<TMap>> dict_;
     TMap& dictMap_;
     TMap defaultValue_;
@@ -0,0 +1,150 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tconf::detail {
+
+    constexpr std::uint64_t fieldNameHash(std::string_view name) {
+        // FNV-1a
+        auto hash = std::uint64_t{14695981039346656037ull};
+        for (auto ch: name) {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    ///
+    /// Open addressing hash table mapping the field names of a config schema to
+    /// their indices. It's built once when the schema is compiled and is looked
+    /// up with string_view keys taken directly from the parsed tree.
+    ///
+    class FieldIndex {
+    public:
+        static constexpr auto npos = static_cast<std::size_t>(-1);
+
+        void insert(std::string name, std::size_t fieldIndex) {
+            auto hash = fieldNameHash(name);
+            insert(std::move(name), fieldIndex, hash);
+        }
+
+        void insert(std::string name, std::size_t fieldIndex, std::uint64_t hash) {
+            keys_.push_back({std::move(name), fieldIndex, hash});
+        }
+
+        void build() {
+            auto capacity = std::size_t{8};
+            while (capacity < keys_.size() * 2)
+                capacity *= 2;
+            slots_.assign(capacity, Slot{});
+            mask_ = capacity - 1;
+            for (auto i = std::size_t{}; i < keys_.size(); ++i) {
+                const auto hash = keys_[i].hash;
+                auto pos = static_cast<std::size_t>(hash) & mask_;
+                while (slots_[pos].key != npos)
+                    pos = (pos + 1) & mask_;
+                slots_[pos] = Slot{hash, i};
+            }
+        }
+
+        std::size_t find(std::string_view name) const {
+            if (slots_.empty())
+                return npos;
+            const auto hash = fieldNameHash(name);
+            for (auto pos = static_cast<std::size_t>(hash) & mask_;; pos = (pos + 1) & mask_) {
+                const auto &slot = slots_[pos];
+                if (slot.key == npos)
+                    return npos;
+                if (slot.hash == hash && keys_[slot.key].name == name)
+                    return keys_[slot.key].fieldIndex;
+            }
+        }
+
+    private:
+        struct Key {
+            std::string name;
+            std::size_t fieldIndex;
+            std::uint64_t hash;
+        };
+
+        struct Slot {
+            std::uint64_t hash = 0;
+            std::size_t key = npos;
+        };
+
+        std::vector<Key> keys_;
+        std::vector<Slot> slots_;
+        std::size_t mask_ = 0;
+    };
+
+    ///
+    /// Dense bitset of the fields loaded from a tree node, stored inline for the
+    /// usual config sizes
+    ///
+    class FieldSet {
+        static constexpr auto inlineWords = std::size_t{4};
+
+    public:
+        explicit FieldSet(std::size_t size)
+                : size_{size} {
+            if (wordCount() > inlineWords)
+                heapWords_.resize(wordCount());
+        }
+
+        void set(std::size_t index) {
+            words()[index / 64] |= std::uint64_t{1} << (index % 64);
+        }
+
+        bool test(std::size_t index) const {
+            return (words()[index / 64] >> (index % 64)) & 1u;
+        }
+
+        bool all() const {
+            for (auto i = std::size_t{}; i < size_ / 64; ++i)
+                if (words()[i] != ~std::uint64_t{})
+                    return false;
+            if (size_ % 64)
+                return words()[size_ / 64] == (std::uint64_t{1} << (size_ % 64)) - 1;
+            return true;
+        }
+
+    private:
+        std::size_t wordCount() const {
+            return (size_ + 63) / 64;
+        }
+
+        std::uint64_t *words() {
+            return heapWords_.empty() ? inlineWords_.data() : heapWords_.data();
+        }
+
+        const std::uint64_t *words() const {
+            return heapWords_.empty() ? inlineWords_.data() : heapWords_.data();
+        }
+
+    private:
+        std::size_t size_;
+        std::array<std::uint64_t, inlineWords> inlineWords_{};
+        std::vector<std::uint64_t> heapWords_;
+    };
+
+} //namespace tconf::detail
@@ -0,0 +1,101 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "tconf/detail/field_index.h"
+#include "tconf/detail/name_converter.h"
+#include <tconf/name_format.h>
+#include "turbo/meta/reflect.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tconf::detail {
+
+    ///
+    /// Field name converted to every NameFormat, indexed by the format value
+    ///
+    struct ConvertedNames {
+        std::string_view original;
+        std::array<std::string_view, 4> names;
+        std::array<std::uint64_t, 4> hashes;
+    };
+
+    template<auto member>
+    class ReflectedName {
+        static constexpr auto memberName_ = std::string_view{turbo::nameof_member<member>()};
+        static constexpr auto capacity_ = memberName_.size() * 2;
+
+        static constexpr auto original_ = FixedName<capacity_>{memberName_};
+        static constexpr auto originalFormat_ =
+                NameConverter<NameFormat::Original>::fixedName<capacity_>(original_.view());
+        static constexpr auto snakeCase_ = NameConverter<NameFormat::SnakeCase>::fixedName<capacity_>(original_.view());
+        static constexpr auto camelCase_ = NameConverter<NameFormat::CamelCase>::fixedName<capacity_>(original_.view());
+        static constexpr auto kebabCase_ = NameConverter<NameFormat::KebabCase>::fixedName<capacity_>(original_.view());
+
+    public:
+        static constexpr auto names = ConvertedNames{
+                original_.view(),
+                {originalFormat_.view(), snakeCase_.view(), camelCase_.view(), kebabCase_.view()},
+                {fieldNameHash(originalFormat_.view()),
+                 fieldNameHash(snakeCase_.view()),
+                 fieldNameHash(camelCase_.view()),
+                 fieldNameHash(kebabCase_.view())}};
+    };
+
+    ///
+    /// Name of a registered config field. Names of reflected members are converted
+    /// at compile time, explicitly specified names are converted once when the
+    /// config schema is built.
+    ///
+    class FieldName {
+    public:
+        FieldName(std::string name)
+                : name_{std::move(name)} {
+        }
+
+        FieldName(const ConvertedNames &convertedNames)
+                : convertedNames_{&convertedNames} {
+        }
+
+        std::string_view original() const {
+            return convertedNames_ ? convertedNames_->original : std::string_view{name_};
+        }
+
+        std::string converted(NameFormat nameFormat) const {
+            if (convertedNames_)
+                return std::string{convertedNames_->names[static_cast<std::size_t>(nameFormat)]};
+            return convertName(nameFormat, name_);
+        }
+
+        std::uint64_t hash(NameFormat nameFormat) const {
+            if (convertedNames_)
+                return convertedNames_->hashes[static_cast<std::size_t>(nameFormat)];
+            return fieldNameHash(converted(nameFormat));
+        }
+
+    private:
+        const ConvertedNames *convertedNames_ = nullptr;
+        std::string name_;
+    };
+
+    template<auto member>
+    FieldName reflectedFieldName() {
+        return FieldName{ReflectedName<member>::names};
+    }
+
+} //namespace tconf::detail
@@ -0,0 +1,118 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "tconf/detail/file_content.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace tconf::detail {
+
+    FileContent::FileContent(const turbo::filesystem::path &path, FileAccess access) {
+#ifndef _WIN32
+        if (access == FileAccess::Map) {
+            const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return;
+
+            struct stat fileStat = {};
+            if (::fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0) {
+                const auto size = static_cast<std::size_t>(fileStat.st_size);
+                auto mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED) {
+                    ::madvise(mapping, size, MADV_SEQUENTIAL);
+                    mapping_ = mapping;
+                    mappingSize_ = size;
+                    isOpen_ = true;
+                }
+            }
+            ::close(fd);
+            if (isOpen_)
+                return;
+        }
+#endif
+        // Empty files, files that can't be mapped and platforms without mmap are read into memory
+        isOpen_ = readContent(path);
+    }
+
+    FileContent::~FileContent() {
+#ifndef _WIN32
+        if (mapping_)
+            ::munmap(mapping_, mappingSize_);
+#endif
+    }
+
+#ifndef _WIN32
+    bool FileContent::readContent(const turbo::filesystem::path &path) {
+        const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+
+        // the size is only a hint: the file can be truncated or appended while it's read
+        struct stat fileStat = {};
+        auto capacity = std::size_t{4096};
+        if (::fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0)
+            capacity = static_cast<std::size_t>(fileStat.st_size) + 1;
+        content_.resize(capacity);
+        auto size = std::size_t{};
+        auto isRead = true;
+        while (true) {
+            if (size == content_.size())
+                content_.resize(content_.size() * 2);
+            const auto result = ::read(fd, content_.data() + size, content_.size() - size);
+            if (result == 0)
+                break;
+            if (result < 0) {
+                if (errno == EINTR)
+                    continue;
+                isRead = false;
+                break;
+            }
+            size += static_cast<std::size_t>(result);
+        }
+        ::close(fd);
+        content_.resize(size);
+        return isRead;
+    }
+#else
+    bool FileContent::readContent(const turbo::filesystem::path &path) {
+        auto stream = std::ifstream{path, std::ios_base::binary};
+        if (!stream.is_open())
+            return false;
+        content_.assign(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+        return !stream.bad();
+    }
+#endif
+
+    bool FileContent::isOpen() const {
+        return isOpen_;
+    }
+
+    const char *FileContent::data() const {
+        return mapping_ ? static_cast<const char *>(mapping_) : content_.data();
+    }
+
+    std::size_t FileContent::size() const {
+        return mapping_ ? mappingSize_ : content_.size();
+    }
+
+} //namespace tconf::detail
@@ -0,0 +1,65 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "turbo/files/filesystem.h"
+#include <cstddef>
+#include <string>
+
+namespace tconf::detail {
+
+    enum class FileAccess {
+        Read,
+        Map
+    };
+
+    ///
+    /// Read only view of a file's content. By default the content is read into memory: a mapped file truncated
+    /// by another process raises SIGBUS on access, while a read only gets the shorter content. FileAccess::Map
+    /// memory-maps regular files where it's supported, it's used only for the files that are replaced
+    /// by renaming, like the binary snapshots. If the mapping fails, the content is read into memory.
+    ///
+    class FileContent {
+    public:
+        explicit FileContent(const turbo::filesystem::path &path, FileAccess access = FileAccess::Read);
+
+        ~FileContent();
+
+        FileContent(const FileContent &) = delete;
+
+        FileContent &operator=(const FileContent &) = delete;
+
+        FileContent(FileContent &&) = delete;
+
+        FileContent &operator=(FileContent &&) = delete;
+
+        bool isOpen() const;
+
+        const char *data() const;
+
+        std::size_t size() const;
+
+    private:
+        bool readContent(const turbo::filesystem::path &path);
+
+    private:
+        void *mapping_ = nullptr;
+        std::size_t mappingSize_ = 0;
+        std::string content_;
+        bool isOpen_ = false;
+    };
+
+} //namespace tconf::detail
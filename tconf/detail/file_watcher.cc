@@ -0,0 +1,214 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "tconf/detail/file_watcher.h"
+#include <algorithm>
+#include <system_error>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tconf::detail {
+
+#ifdef __linux__
+    namespace {
+        constexpr auto watchedEvents = IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM;
+    }
+#endif
+
+    FileWatcher::FileWatcher(const turbo::filesystem::path &path, std::chrono::milliseconds pollInterval)
+            : path_{path}, fileName_{path.filename().string()}, pollInterval_{pollInterval} {
+        fileStamp_ = readFileStamp();
+#ifdef __linux__
+        notifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        interruptFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        const auto dir = path.has_parent_path() ? path.parent_path() : turbo::filesystem::path{"."};
+        if (notifyFd_ >= 0 && interruptFd_ >= 0)
+            dirWatch_ = ::inotify_add_watch(notifyFd_, dir.c_str(), watchedEvents);
+        if (dirWatch_ >= 0) {
+            watchTargetDir();
+            return;
+        }
+
+        // the watch limit can be exhausted, the file stamp is polled then
+        if (notifyFd_ >= 0)
+            ::close(notifyFd_);
+        if (interruptFd_ >= 0)
+            ::close(interruptFd_);
+        notifyFd_ = -1;
+        interruptFd_ = -1;
+#endif
+    }
+
+    FileWatcher::~FileWatcher() {
+#ifdef __linux__
+        if (notifyFd_ >= 0)
+            ::close(notifyFd_);
+        if (interruptFd_ >= 0)
+            ::close(interruptFd_);
+#endif
+    }
+
+    bool FileWatcher::waitForChange(std::chrono::milliseconds debounce) {
+        auto event = waitForEvent(std::nullopt);
+        while (event == Event::Timeout)
+            event = waitForEvent(std::nullopt);
+        if (event == Event::Interrupted)
+            return false;
+
+        while (event == Event::Changed)
+            event = waitForEvent(debounce);
+        return event == Event::Timeout;
+    }
+
+    void FileWatcher::interrupt() {
+        {
+            auto lock = std::lock_guard{mutex_};
+            interrupted_ = true;
+        }
+        interruptCondition_.notify_all();
+#ifdef __linux__
+        if (interruptFd_ >= 0) {
+            const auto value = std::uint64_t{1};
+            [[maybe_unused]] const auto result = ::write(interruptFd_, &value, sizeof(value));
+        }
+#endif
+    }
+
+    bool FileWatcher::usesNotifications() const {
+        return notifyFd_ >= 0;
+    }
+
+    FileWatcher::Event FileWatcher::waitForEvent(std::optional<std::chrono::milliseconds> timeout) {
+        if (notifyFd_ >= 0)
+            return waitForNotification(timeout);
+        return pollFileStamp(timeout);
+    }
+
+    FileWatcher::Event FileWatcher::waitForNotification(std::optional<std::chrono::milliseconds> timeout) {
+#ifdef __linux__
+        const auto deadline = std::chrono::steady_clock::now() + timeout.value_or(std::chrono::milliseconds{});
+        for (;;) {
+            auto timeoutMs = -1;
+            if (timeout) {
+                const auto timeLeft = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - std::chrono::steady_clock::now());
+                timeoutMs = static_cast<int>(std::max(timeLeft.count(), std::chrono::milliseconds::rep{}));
+            }
+            pollfd fds[] = {{notifyFd_, POLLIN, 0}, {interruptFd_, POLLIN, 0}};
+            const auto result = ::poll(fds, 2, timeoutMs);
+            if (result < 0 && errno == EINTR)
+                continue;
+            if (result < 0 || fds[1].revents)
+                return Event::Interrupted;
+            if (result == 0)
+                return Event::Timeout;
+
+            auto isChanged = false;
+            auto hasOtherEvents = false;
+            alignas(inotify_event) char buffer[4096];
+            for (;;) {
+                const auto size = ::read(notifyFd_, buffer, sizeof(buffer));
+                if (size <= 0)
+                    break;
+                for (auto pos = ssize_t{}; pos < size;) {
+                    const auto *event = reinterpret_cast<const inotify_event *>(buffer + pos);
+                    const auto isFileEvent = event->wd == dirWatch_ && event->len && fileName_ == event->name;
+                    if ((event->mask & IN_Q_OVERFLOW) || isFileEvent)
+                        isChanged = true;
+                    else
+                        hasOtherEvents = true;
+                    pos += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+            // the events of the other files change the config only if they replace the symlink's target,
+            // the stamp is updated after the file's own events too, so they aren't reported again
+            const auto isStampChanged = (isChanged || hasOtherEvents) && updateFileStamp();
+            if (isChanged || isStampChanged) {
+                watchTargetDir();
+                return Event::Changed;
+            }
+        }
+#else
+        return pollFileStamp(timeout);
+#endif
+    }
+
+    FileWatcher::Event FileWatcher::pollFileStamp(std::optional<std::chrono::milliseconds> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout.value_or(std::chrono::milliseconds{});
+        auto lock = std::unique_lock{mutex_};
+        for (;;) {
+            auto waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(pollInterval_);
+            if (timeout)
+                waitTime = std::clamp(
+                        std::chrono::duration_cast<std::chrono::milliseconds>(
+                                deadline - std::chrono::steady_clock::now()),
+                        std::chrono::milliseconds{},
+                        waitTime);
+            if (interruptCondition_.wait_for(lock, waitTime, [this] { return interrupted_; }))
+                return Event::Interrupted;
+
+            if (updateFileStamp())
+                return Event::Changed;
+            if (timeout && std::chrono::steady_clock::now() >= deadline)
+                return Event::Timeout;
+        }
+    }
+
+    FileWatcher::FileStamp FileWatcher::readFileStamp() const {
+        auto error = std::error_code{};
+        auto result = FileStamp{};
+        result.exists = turbo::filesystem::exists(path_, error);
+        if (!result.exists)
+            return result;
+        if (turbo::filesystem::is_symlink(turbo::filesystem::symlink_status(path_, error))) {
+            result.target = turbo::filesystem::canonical(path_, error);
+            if (error)
+                result.target.clear();
+        }
+        result.time = turbo::filesystem::last_write_time(path_, error);
+        result.size = turbo::filesystem::file_size(path_, error);
+#ifdef __linux__
+        struct stat fileStat = {};
+        if (::stat(path_.c_str(), &fileStat) == 0)
+            result.inode = static_cast<std::uint64_t>(fileStat.st_ino);
+#endif
+        return result;
+    }
+
+    bool FileWatcher::updateFileStamp() {
+        auto fileStamp = readFileStamp();
+        if (fileStamp == fileStamp_)
+            return false;
+        fileStamp_ = std::move(fileStamp);
+        return true;
+    }
+
+    void FileWatcher::watchTargetDir() {
+#ifdef __linux__
+        // the watches of the replaced target directories are removed by the kernel when they're deleted
+        if (fileStamp_.target.empty() || fileStamp_.target.parent_path() == targetDir_)
+            return;
+        targetDir_ = fileStamp_.target.parent_path();
+        ::inotify_add_watch(notifyFd_, targetDir_.c_str(), watchedEvents);
+#endif
+    }
+
+} //namespace tconf::detail
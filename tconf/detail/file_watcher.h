@@ -0,0 +1,110 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "turbo/files/filesystem.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace tconf::detail {
+
+    ///
+    /// Waits for the changes of a file. On Linux the file's directory is watched with inotify,
+    /// so the files replaced by renaming are tracked too. If the file is a symlink, the directory
+    /// of its target is watched as well, and the events of the other files are checked against
+    /// the resolved target, e.g. when a Kubernetes ConfigMap mount swaps its data directory link.
+    /// If inotify isn't available, the modification time and the size of the file are checked periodically.
+    ///
+    class FileWatcher {
+    public:
+        FileWatcher(const turbo::filesystem::path &path, std::chrono::milliseconds pollInterval);
+
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher &) = delete;
+
+        FileWatcher &operator=(const FileWatcher &) = delete;
+
+        FileWatcher(FileWatcher &&) = delete;
+
+        FileWatcher &operator=(FileWatcher &&) = delete;
+
+        ///
+        /// Blocks until the file is changed and no more changes follow during the debounce period.
+        /// Returns false if the waiting was interrupted.
+        ///
+        bool waitForChange(std::chrono::milliseconds debounce);
+
+        /// interrupts the current and all the following calls of waitForChange(), it can be called from any thread
+        void interrupt();
+
+        bool usesNotifications() const;
+
+    private:
+        enum class Event {
+            Changed,
+            Timeout,
+            Interrupted
+        };
+
+        /// the state of the symlink's target for the symlinks
+        struct FileStamp {
+            turbo::filesystem::path target;
+            turbo::filesystem::file_time_type time;
+            std::uintmax_t size = 0;
+            std::uint64_t inode = 0;
+            bool exists = false;
+
+            bool operator==(const FileStamp &other) const {
+                return target == other.target && time == other.time && size == other.size && inode == other.inode &&
+                       exists == other.exists;
+            }
+        };
+
+        /// waits without a time limit if the timeout isn't set
+        Event waitForEvent(std::optional<std::chrono::milliseconds> timeout);
+
+        Event waitForNotification(std::optional<std::chrono::milliseconds> timeout);
+
+        Event pollFileStamp(std::optional<std::chrono::milliseconds> timeout);
+
+        FileStamp readFileStamp() const;
+
+        /// returns true if the file's stamp has changed since the last check
+        bool updateFileStamp();
+
+        /// adds the watch of the symlink target's directory if it isn't watched yet
+        void watchTargetDir();
+
+    private:
+        turbo::filesystem::path path_;
+        std::string fileName_;
+        std::chrono::milliseconds pollInterval_;
+        int notifyFd_ = -1;
+        int interruptFd_ = -1;
+        int dirWatch_ = -1;
+        turbo::filesystem::path targetDir_;
+        FileStamp fileStamp_;
+        std::mutex mutex_;
+        std::condition_variable interruptCondition_;
+        bool interrupted_ = false;
+    };
+
+} //namespace tconf::detail
@@ -16,17 +16,13 @@
 #pragma once
 
 #include "tconf/detail/interface.h"
-#include <tconf/tree/stream_position.h>
-#include <functional>
 #include <string>
 
 namespace tconf::detail {
 
     class IConfigEntity : private sfun::interface<IConfigEntity> {
     public:
-        virtual StreamPosition position() = 0;
-
-        virtual std::string description() = 0;
+        virtual std::string description() const = 0;
     };
 
-} //namespace tconf::detail
\ No newline at end of file
+} //namespace tconf::detail
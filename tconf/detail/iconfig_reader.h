@@ -16,34 +16,31 @@
 #pragma once
 #include "tconf/detail/config_reader_ptr.h"
 #include "tconf/detail/interface.h"
-#include "tconf/tree/tree.h"
 #include <memory>
-#include <string>
 
 namespace tconf::detail {
+class FieldName;
 class INode;
 class IParam;
-class IValidator;
+class Validator;
+class IConfigEntity;
 
+///
+/// Receives the fields registered by a config object during its construction.
+/// Only the schema builder implements it, config objects bound to a read are
+/// constructed with an empty ConfigReaderPtr and register nothing.
+///
 class IConfigReader : private sfun::interface<IConfigReader> {
 public:
-    virtual ConfigReaderPtr makeNestedReader(const std::string& name) = 0;
-    virtual void load(const tconf::TreeNode& node) = 0;
-    virtual void addNode(const std::string& name, std::unique_ptr<INode> cfg) = 0;
-    virtual void addParam(const std::string& name, std::unique_ptr<IParam> param) = 0;
-    virtual void addValidator(std::unique_ptr<IValidator> validator) = 0;
+    virtual void addNode(const FieldName& name, std::unique_ptr<INode> node, const void* nodeValue) = 0;
+    virtual void addParam(const FieldName& name, std::unique_ptr<IParam> param, const void* paramValue) = 0;
+    virtual void addValidator(Validator validator, const IConfigEntity& entity, const void* entityValue) = 0;
 
 protected:
     ConfigReaderPtr makePtr()
     {
         return this;
     }
-
-    template<typename TCfg>
-    void resetConfigReader(TCfg& cfg)
-    {
-        cfg.cfgReader_ = ConfigReaderPtr{};
-    }
 };
 
-} //namespace tconf::detail
\ No newline at end of file
+} //namespace tconf::detail
@@ -16,16 +16,137 @@
 
 #pragma once
 #include "tconf/detail/iconfig_entity.h"
+#include "tconf/detail/loading_context.h"
+#include <tconf/tree/stream_position.h>
 #include <tconf/tree/tree.h>
+#include <cstddef>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace tconf::detail {
 
+class Schema;
+
+/// Defines how ConfigBinder loads the content of a node
+enum class NodeBinding {
+    Config,     /// fields of a config are bound directly
+    ConfigList, /// each list element is bound as a config
+    Dict,       /// params are added to the dictionary
+    Tree,       /// the node is collected into a tree and loaded with INode::load()
+    ConfigDict  /// each child node is added to the dictionary and bound as a config
+};
+
+struct BoundConfig {
+    const Schema* schema = nullptr;
+    void* cfg = nullptr;
+};
+
 class INode : public IConfigEntity {
 public:
-    virtual void load(const tconf::TreeNode& node) = 0;
-    virtual bool hasValue() const = 0;
+    virtual NodeBinding binding() const = 0;
+
+    /// Returns the kind of the node in the config structure: Config, ConfigList or Dict.
+    /// It differs from binding() for the nodes loaded from a collected tree.
+    virtual NodeBinding structure() const;
+
+    /// Checks the node kind and prepares the value before the node's content is bound,
+    /// returns the config to bind for NodeBinding::Config
+    virtual BoundConfig begin(void* nodeValue, bool isList, const StreamPosition& position, const LoadingContext& ctx)
+            const = 0;
+
+    /// Appends an element to the list, NodeBinding::ConfigList only
+    virtual BoundConfig addElement(void* nodeValue, const LoadingContext& ctx) const;
+
+    /// Adds a dictionary element, NodeBinding::Dict only
+    virtual void addElement(
+            void* nodeValue,
+            std::string_view key,
+            const TreeValue& value,
+            const StreamPosition& position,
+            const LoadingContext& ctx) const;
+
+    /// Adds a dictionary element, NodeBinding::ConfigDict only.
+    /// The config isn't set if the error of a repeated key is collected.
+    virtual BoundConfig addElement(
+            void* nodeValue,
+            std::string_view key,
+            const StreamPosition& position,
+            const LoadingContext& ctx) const;
+
+    /// Pre-sizes the dictionary for the expected count of the added elements,
+    /// NodeBinding::Dict and NodeBinding::ConfigDict only
+    virtual void reserve(void* nodeValue, std::size_t count) const;
+
+    /// Loads the collected node, NodeBinding::Tree only
+    virtual void load(void* nodeValue, const tconf::TreeNode& node, const LoadingContext& ctx) const;
+
+    /// Returns the already loaded config for the incremental update, NodeBinding::Config only.
+    /// The config isn't set if the node value is empty.
+    virtual BoundConfig loadedConfig(void* nodeValue, const LoadingContext& ctx) const;
+
+    /// Returns the already loaded list element for the incremental update, NodeBinding::ConfigList only.
+    /// The config isn't set if the element doesn't exist.
+    virtual BoundConfig loadedElement(void* nodeValue, std::size_t index, const LoadingContext& ctx) const;
+
+    /// Returns the schema of the node's config or of the list's elements, it's used for the schema fingerprint
+    virtual const Schema* schema(const LoadingContext& ctx) const;
+
+    /// Returns whether the list elements are loaded over the first one, so only the first element must be complete
+    virtual bool isCopyList() const;
+
+    virtual bool isOptional() const = 0;
 };
 
-} //namespace tconf::detail
\ No newline at end of file
+inline NodeBinding INode::structure() const
+{
+    return binding();
+}
+
+inline BoundConfig INode::addElement(void*, const LoadingContext&) const
+{
+    throw std::logic_error{"Node doesn't support list binding"};
+}
+
+inline void INode::addElement(void*, std::string_view, const TreeValue&, const StreamPosition&, const LoadingContext&)
+        const
+{
+    throw std::logic_error{"Node doesn't support dictionary binding"};
+}
+
+inline BoundConfig INode::addElement(void*, std::string_view, const StreamPosition&, const LoadingContext&) const
+{
+    throw std::logic_error{"Node doesn't support config dictionary binding"};
+}
+
+inline void INode::reserve(void*, std::size_t) const
+{
+}
+
+inline void INode::load(void*, const tconf::TreeNode&, const LoadingContext&) const
+{
+    throw std::logic_error{"Node doesn't support tree binding"};
+}
+
+inline BoundConfig INode::loadedConfig(void*, const LoadingContext&) const
+{
+    return {};
+}
+
+inline BoundConfig INode::loadedElement(void*, std::size_t, const LoadingContext&) const
+{
+    return {};
+}
+
+inline const Schema* INode::schema(const LoadingContext&) const
+{
+    return nullptr;
+}
+
+inline bool INode::isCopyList() const
+{
+    return false;
+}
+
+} //namespace tconf::detail
@@ -15,14 +15,20 @@
 
 #pragma once
 #include "tconf/detail/iconfig_entity.h"
+#include "tconf/detail/loading_context.h"
+#include <tconf/tree/stream_position.h>
 #include <tconf/tree/tree.h>
+#include <string_view>
 
 namespace tconf::detail {
 
 class IParam : public IConfigEntity {
 public:
-    virtual void load(const tconf::TreeParam& node) = 0;
-    virtual bool hasValue() const = 0;
+    virtual void load(void* paramValue, const TreeValue& value, const StreamPosition& position, const LoadingContext& ctx)
+            const = 0;
+    virtual void load(void* paramValue, TreeValueList valueList, const StreamPosition& position, const LoadingContext& ctx)
+            const = 0;
+    virtual bool isOptional() const = 0;
 };
 
-} //namespace tconf::detail
\ No newline at end of file
+} //namespace tconf::detail
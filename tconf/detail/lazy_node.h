@@ -0,0 +1,102 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#pragma once
+#include "tconf/detail/inode.h"
+#include "tconf/detail/schema.h"
+#include <tconf/errors.h>
+#include <tconf/lazy.h>
+#include <tconf/tree/itree_visitor.h>
+#include <tconf/tree/tree.h>
+#include <tconf/tree/tree_builder.h>
+#include <memory>
+#include <string>
+
+namespace tconf::detail {
+
+    ///
+    /// Node of tconf::lazy<TCfg> type: the collected subtree is checked for the required fields
+    /// and copied into the lazy value, which loads the config on the first access
+    ///
+    template<typename TLazyCfg>
+    class LazyNode : public INode {
+        using Cfg = typename TLazyCfg::value_type;
+        using State = typename TLazyCfg::State;
+
+    public:
+        explicit LazyNode(std::string name)
+                : name_{std::move(name)} {
+        }
+
+        void markValueIsSet() {
+            hasDefaultValue_ = true;
+        }
+
+    private:
+        NodeBinding binding() const override {
+            return NodeBinding::Tree;
+        }
+
+        NodeBinding structure() const override {
+            return NodeBinding::Config;
+        }
+
+        BoundConfig begin(void *, bool isList, const StreamPosition &position, const LoadingContext &)
+                const override {
+            if (isList)
+                throw ConfigError{"Node '" + name_ + "': config node can't be a list.", position};
+            return {};
+        }
+
+        /// The node keeps the document of the read tree or of the subtree collected by ConfigBinder,
+        /// the root node isn't kept by the documents, so it's copied
+        void load(void *value, const TreeNode &treeNode, const LoadingContext &ctx) const override {
+            check(treeNode, ctx);
+            auto node = treeNode.retain();
+            if (!node) {
+                auto tree = std::make_shared<TreeNode>(makeTreeRoot());
+                auto builder = TreeBuilder{*tree};
+                visitTree(treeNode, builder);
+                node = std::move(tree);
+            }
+            static_cast<TLazyCfg *>(value)->state_ = std::make_shared<State>(std::move(node), name_, ctx);
+        }
+
+        void check(const TreeNode &treeNode, const LoadingContext &ctx) const {
+            if (treeNode.isList())
+                throw ConfigError{"Node '" + name_ + "': config node can't be a list.", treeNode.position()};
+            if (ctx.checkMissingFields)
+                schemaOf<Cfg>(ctx.nameFormat).checkRequiredFields(treeNode, ctx);
+        }
+
+        const Schema *schema(const LoadingContext &ctx) const override {
+            return &schemaOf<Cfg>(ctx.nameFormat);
+        }
+
+        bool isOptional() const override {
+            return hasDefaultValue_;
+        }
+
+        std::string description() const override {
+            return "Node '" + name_ + "'";
+        }
+
+    private:
+        std::string name_;
+        bool hasDefaultValue_ = false;
+    };
+
+} //namespace tconf::detail
@@ -0,0 +1,66 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#pragma once
+#include "tconf/detail/iparam.h"
+#include <tconf/errors.h>
+#include <tconf/lazy.h>
+#include <tconf/tree/tree.h>
+#include <memory>
+#include <string>
+
+namespace tconf::detail {
+
+    ///
+    /// Param of tconf::lazy_param<T> type: the value is copied into the lazy param
+    /// which converts it on the first access
+    ///
+    template<typename TLazyParam>
+    class LazyParam : public IParam {
+    public:
+        explicit LazyParam(std::string name)
+                : name_{std::move(name)} {
+        }
+
+        void markValueIsSet() {
+            hasDefaultValue_ = true;
+        }
+
+    private:
+        void load(void *value, const TreeValue &paramValue, const StreamPosition &position, const LoadingContext &)
+                const override {
+            static_cast<TLazyParam *>(value)->state_ =
+                    std::make_shared<typename TLazyParam::State>(name_, paramValue, position);
+        }
+
+        void load(void *, TreeValueList, const StreamPosition &position, const LoadingContext &ctx) const override {
+            reportError(ctx, "Parameter '" + name_ + "': config parameter can't be a list.", position);
+        }
+
+        bool isOptional() const override {
+            return hasDefaultValue_;
+        }
+
+        std::string description() const override {
+            return "Parameter '" + name_ + "'";
+        }
+
+    private:
+        std::string name_;
+        bool hasDefaultValue_ = false;
+    };
+
+} //namespace tconf::detail
@@ -0,0 +1,53 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include <tconf/errors.h>
+#include <tconf/name_format.h>
+#include <tconf/tree/stream_position.h>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace tconf::detail {
+
+    ///
+    /// Per-read state passed down the config schemas while a tree is being loaded
+    ///
+    struct LoadingContext {
+        NameFormat nameFormat = NameFormat::Original;
+        /// disabled when a tree is loaded over already loaded values,
+        /// e.g. for the elements of a copy node list
+        bool checkMissingFields = true;
+        /// the errors are added here instead of being thrown, the failed field is skipped then
+        std::vector<Diagnostic> *errors = nullptr;
+        /// the loaded pmr containers and strings are placed in it, it isn't used by several threads at once
+        std::pmr::memory_resource *memoryResource = nullptr;
+    };
+
+    /// Throws ConfigError or adds the error to the collected ones, the caller must skip the failed field
+    inline void reportError(const LoadingContext &ctx, std::string message, const StreamPosition &position) {
+        if (!ctx.errors)
+            throw ConfigError{message, position};
+        ctx.errors->push_back({std::move(message), position});
+    }
+
+    inline std::size_t errorCount(const LoadingContext &ctx) {
+        return ctx.errors ? ctx.errors->size() : 0;
+    }
+
+} //namespace tconf::detail
@@ -0,0 +1,77 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "tconf/detail/loading_context.h"
+#include "tconf/detail/type_traits.h"
+#include "tconf/detail/utils.h"
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace tconf::detail {
+
+    ///
+    /// Places the value of a loaded field in the read's memory resource if it's a container or a string
+    /// with std::pmr::polymorphic_allocator. Such a value doesn't take the allocator of the value assigned to it,
+    /// so it's constructed again. The values with the other allocators keep them.
+    ///
+    template<typename T>
+    T &useMemoryResource(T &value, const LoadingContext &ctx) {
+        if constexpr (sfun::uses_polymorphic_allocator_v<T>) {
+            if (ctx.memoryResource && value.get_allocator().resource() != ctx.memoryResource) {
+                std::destroy_at(&value);
+                ::new (static_cast<void *>(&value)) T(typename T::allocator_type{ctx.memoryResource});
+            }
+        }
+        return value;
+    }
+
+    /// Assigns the loaded value, a pmr value is moved into the read's memory resource
+    template<typename T>
+    void assignValue(T &target, T &&value, const LoadingContext &ctx) {
+        using TValue = sfun::remove_optional_t<T>;
+        if constexpr (sfun::uses_polymorphic_allocator_v<TValue>) {
+            if (ctx.memoryResource) {
+                if constexpr (sfun::is_optional_v<T>) {
+                    if (!value.has_value())
+                        target.reset();
+                    else
+                        target.emplace(std::move(*value), typename TValue::allocator_type{ctx.memoryResource});
+                }
+                else
+                    useMemoryResource(target, ctx) = std::move(value);
+                return;
+            }
+        }
+        target = std::move(value);
+    }
+
+    ///
+    /// Returns the emptied container of a loaded field, an optional field gets a new container.
+    /// The container is placed in the read's memory resource.
+    ///
+    template<typename T>
+    auto &resetContainer(T &value, const LoadingContext &ctx) {
+        if constexpr (sfun::is_optional_v<T>)
+            value.emplace();
+        auto &container = useMemoryResource(maybeOptValue(value), ctx);
+        container.clear();
+        return container;
+    }
+
+} //namespace tconf::detail
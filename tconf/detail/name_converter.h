@@ -16,42 +16,58 @@
 #pragma once
 #include "tconf/detail/nameutils.h"
 #include <tconf/name_format.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
 
 namespace tconf::detail {
 
-template<NameFormat>
-struct NameConverter;
+template<NameFormat nameFormat, typename TOut>
+constexpr void writeConvertedName(std::string_view configName, TOut& result)
+{
+    if constexpr (nameFormat == NameFormat::SnakeCase)
+        writeSnakeCase(configName, result);
+    else if constexpr (nameFormat == NameFormat::CamelCase)
+        writeCamelCase(configName, result);
+    else if constexpr (nameFormat == NameFormat::KebabCase)
+        writeKebabCase(configName, result);
+    else
+        for (auto ch : trimName(configName))
+            result.push_back(ch);
+}
 
-template<>
-struct NameConverter<NameFormat::Original> {
+template<NameFormat nameFormat>
+struct NameConverter {
     static std::string name(const std::string& configName)
     {
-        return formatName(configName);
+        auto result = std::string{};
+        writeConvertedName<nameFormat>(configName, result);
+        return result;
     }
-};
-
-template<>
-struct NameConverter<NameFormat::SnakeCase> {
-    static std::string name(const std::string& configName)
-    {
-        return toSnakeCase(configName);
-    }
-};
 
-template<>
-struct NameConverter<NameFormat::CamelCase> {
-    static std::string name(const std::string& configName)
+    /// converted names are at most twice as long as the original ones
+    template<std::size_t capacity>
+    static constexpr FixedName<capacity> fixedName(std::string_view configName)
     {
-        return toCamelCase(configName);
+        auto result = FixedName<capacity>{};
+        writeConvertedName<nameFormat>(configName, result);
+        return result;
     }
 };
 
-template<>
-struct NameConverter<NameFormat::KebabCase> {
-    static std::string name(const std::string& configName)
-    {
-        return toKebabCase(configName);
+inline std::string convertName(NameFormat nameFormat, const std::string& configName)
+{
+    switch (nameFormat) {
+    case NameFormat::Original:
+        return NameConverter<NameFormat::Original>::name(configName);
+    case NameFormat::SnakeCase:
+        return NameConverter<NameFormat::SnakeCase>::name(configName);
+    case NameFormat::CamelCase:
+        return NameConverter<NameFormat::CamelCase>::name(configName);
+    case NameFormat::KebabCase:
+        return NameConverter<NameFormat::KebabCase>::name(configName);
     }
-};
+    return configName;
+}
 
-} //namespace tconf::detail
\ No newline at end of file
+} //namespace tconf::detail
@@ -13,88 +13,147 @@
 // limitations under the License.
 //
 
-
 #pragma once
 
-#include "tconf/detail/string_utils.h"
-#include <algorithm>
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace tconf::detail {
 
-    inline std::string formatName(const std::string &name) {
-        auto result = name;
-        //remove front non-alphabet characters
-        result.erase(
-                result.begin(),
-                std::find_if(
-                        result.begin(),
-                        result.end(),
-                        [](auto ch) {
-                            return sfun::isalpha(ch);
-                        }));
-        //remove back non-alphabet and non-digit characters
-        result.erase(
-                std::find_if(
-                        result.rbegin(),
-                        result.rend(),
-                        [](auto ch) {
-                            return sfun::isalnum(ch);
-                        })
-                        .base(),
-                result.end());
-        return result;
+    namespace name_chars {
+
+        constexpr bool isupper(char ch) {
+            return ch >= 'A' && ch <= 'Z';
+        }
+
+        constexpr bool isalpha(char ch) {
+            return isupper(ch) || (ch >= 'a' && ch <= 'z');
+        }
+
+        constexpr bool isdigit(char ch) {
+            return ch >= '0' && ch <= '9';
+        }
+
+        constexpr bool isalnum(char ch) {
+            return isalpha(ch) || isdigit(ch);
+        }
+
+        constexpr char tolower(char ch) {
+            return isupper(ch) ? static_cast<char>(ch - 'A' + 'a') : ch;
+        }
+
+        constexpr char toupper(char ch) {
+            return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - 'a' + 'A') : ch;
+        }
+
+    } //namespace name_chars
+
+    ///
+    /// Fixed capacity string used to build converted field names in constant expressions
+    ///
+    template<std::size_t capacity>
+    class FixedName {
+    public:
+        constexpr FixedName() = default;
+
+        constexpr explicit FixedName(std::string_view name) {
+            for (auto ch: name)
+                push_back(ch);
+        }
+
+        constexpr void push_back(char ch) {
+            data_[size_++] = ch;
+        }
+
+        constexpr bool empty() const {
+            return size_ == 0;
+        }
+
+        constexpr std::string_view view() const {
+            return {data_, size_};
+        }
+
+    private:
+        char data_[capacity + 1] = {};
+        std::size_t size_ = 0;
+    };
+
+    /// removes front non-alphabet and back non-alphabet and non-digit characters
+    constexpr std::string_view trimName(std::string_view name) {
+        auto begin = std::size_t{};
+        while (begin < name.size() && !name_chars::isalpha(name[begin]))
+            ++begin;
+        auto end = name.size();
+        while (end > begin && !name_chars::isalnum(name[end - 1]))
+            --end;
+        return name.substr(begin, end - begin);
     }
 
-    inline std::string toCamelCase(const std::string &name) {
-        auto result = std::string{};
+    template<typename TOut>
+    constexpr void writeCamelCase(std::string_view name, TOut &result) {
         auto prevCharNonAlpha = false;
-        auto formattedName = formatName(name);
-        if (!formattedName.empty())
-            formattedName[0] = static_cast<char>(sfun::tolower(formattedName[0]));
-        for (auto ch: formattedName) {
-            if (!sfun::isalpha(ch)) {
-                if (sfun::isdigit(ch))
+        auto formattedName = trimName(name);
+        for (auto i = std::size_t{}; i < formattedName.size(); ++i) {
+            auto ch = i == 0 ? name_chars::tolower(formattedName[i]) : formattedName[i];
+            if (!name_chars::isalpha(ch)) {
+                if (name_chars::isdigit(ch))
                     result.push_back(ch);
                 if (!result.empty())
                     prevCharNonAlpha = true;
                 continue;
             }
             if (prevCharNonAlpha)
-                ch = static_cast<char>(sfun::toupper(ch));
+                ch = name_chars::toupper(ch);
             result.push_back(ch);
             prevCharNonAlpha = false;
         }
-        return result;
     }
 
-    inline std::string toKebabCase(const std::string &name) {
-        auto result = std::string{};
-        auto formattedName = formatName(sfun::replace(name, "_", "-"));
-        if (!formattedName.empty())
-            formattedName[0] = sfun::tolower(formattedName[0]);
-        for (auto ch: formattedName) {
-            if (sfun::isupper(ch) && !result.empty()) {
-                result.push_back('-');
-                result.push_back(sfun::tolower(ch));
+    template<typename TOut>
+    constexpr void writeSeparatedCase(std::string_view name, char separator, TOut &result) {
+        auto formattedName = trimName(name);
+        for (auto i = std::size_t{}; i < formattedName.size(); ++i) {
+            auto ch = i == 0 ? name_chars::tolower(formattedName[i]) : formattedName[i];
+            if (ch == '_')
+                ch = separator;
+            if (name_chars::isupper(ch) && !result.empty()) {
+                result.push_back(separator);
+                result.push_back(name_chars::tolower(ch));
             } else
                 result.push_back(ch);
         }
+    }
+
+    template<typename TOut>
+    constexpr void writeKebabCase(std::string_view name, TOut &result) {
+        writeSeparatedCase(name, '-', result);
+    }
+
+    template<typename TOut>
+    constexpr void writeSnakeCase(std::string_view name, TOut &result) {
+        writeSeparatedCase(name, '_', result);
+    }
+
+    inline std::string formatName(const std::string &name) {
+        return std::string{trimName(name)};
+    }
+
+    inline std::string toCamelCase(const std::string &name) {
+        auto result = std::string{};
+        writeCamelCase(name, result);
+        return result;
+    }
+
+    inline std::string toKebabCase(const std::string &name) {
+        auto result = std::string{};
+        writeKebabCase(name, result);
         return result;
     }
 
     inline std::string toSnakeCase(const std::string &name) {
         auto result = std::string{};
-        auto formattedName = formatName(name);
-        if (!formattedName.empty())
-            formattedName[0] = sfun::tolower(formattedName[0]);
-        for (auto ch: formattedName) {
-            if (sfun::isupper(ch) && !result.empty()) {
-                result.push_back('_');
-                result.push_back(sfun::tolower(ch));
-            } else
-                result.push_back(ch);
-        }
+        writeSnakeCase(name, result);
         return result;
     }
 
@@ -16,13 +16,11 @@
 
 #pragma once
 #include "tconf/detail/iconfig_entity.h"
-#include "tconf/detail/iconfig_reader.h"
 #include "tconf/detail/inode.h"
+#include "tconf/detail/schema.h"
 #include "tconf/detail/utils.h"
 #include <tconf/errors.h>
 #include <tconf/tree/tree.h>
-#include <algorithm>
-#include <sstream>
 #include <string>
 
 namespace tconf::detail {
@@ -30,57 +28,67 @@ namespace tconf::detail {
 template<typename TCfg>
 class Node : public INode {
 public:
-    Node(std::string name, TCfg& cfg, ConfigReaderPtr cfgReader)
+    explicit Node(std::string name)
         : name_{std::move(name)}
-        , cfg_{cfg}
-        , cfgReader_{cfgReader}
     {
     }
 
     void markValueIsSet()
     {
-        hasValue_ = true;
+        hasDefaultValue_ = true;
     }
 
 private:
-    void load(const TreeNode& node) override
+    NodeBinding binding() const override
     {
-        hasValue_ = true;
-        position_ = node.position();
-        if (!node.isItem())
-            throw ConfigError{"Node '" + name_ + "': config node can't be a list.", node.position()};
+        return NodeBinding::Config;
+    }
 
-        if constexpr (is_initialized_optional_v<TCfg>)
-            cfg_.emplace();
+    BoundConfig begin(void* value, bool isList, const StreamPosition& position, const LoadingContext& ctx)
+            const override
+    {
+        if (isList)
+            throw ConfigError{"Node '" + name_ + "': config node can't be a list.", position};
 
-        if (cfgReader_)
-            cfgReader_->load(node);
+        auto& cfg = *static_cast<TCfg*>(value);
+        if constexpr (is_initialized_optional_v<TCfg>) {
+            cfg.emplace();
+            return {&schemaOf<sfun::remove_optional_t<TCfg>>(ctx.nameFormat), &*cfg};
+        }
+        else
+            return {&schemaOf<TCfg>(ctx.nameFormat), &cfg};
     }
 
-    bool hasValue() const override
+    BoundConfig loadedConfig(void* value, const LoadingContext& ctx) const override
     {
-        if constexpr (is_initialized_optional_v<TCfg>)
-            return true;
+        auto& cfg = *static_cast<TCfg*>(value);
+        if constexpr (is_initialized_optional_v<TCfg>) {
+            if (!cfg.has_value())
+                return {};
+            return {&schemaOf<sfun::remove_optional_t<TCfg>>(ctx.nameFormat), &*cfg};
+        }
         else
-            return hasValue_;
+            return {&schemaOf<TCfg>(ctx.nameFormat), &cfg};
+    }
+
+    const Schema* schema(const LoadingContext& ctx) const override
+    {
+        return &schemaOf<sfun::remove_optional_t<TCfg>>(ctx.nameFormat);
     }
 
-    StreamPosition position() override
+    bool isOptional() const override
     {
-        return position_;
+        return is_initialized_optional_v<TCfg> || hasDefaultValue_;
     }
 
-    std::string description() override
+    std::string description() const override
     {
         return "Node '" + name_ + "'";
     }
 
 private:
     std::string name_;
-    TCfg& cfg_;
-    ConfigReaderPtr cfgReader_;
-    bool hasValue_ = false;
-    StreamPosition position_;
+    bool hasDefaultValue_ = false;
 };
 
-} //namespace tconf::detail
\ No newline at end of file
+} //namespace tconf::detail
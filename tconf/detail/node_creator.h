@@ -15,8 +15,10 @@
 
 
 #pragma once
+#include "tconf/detail/field_name.h"
 #include "tconf/detail/iconfig_reader.h"
 #include "tconf/detail/inode.h"
+#include "tconf/detail/lazy_node.h"
 #include "tconf/detail/node.h"
 #include "tconf/detail/utils.h"
 #include "tconf/detail/validator.h"
@@ -33,50 +35,71 @@ class Config;
 
 namespace tconf::detail {
 
+template<typename TCfg>
+struct remove_lazy {
+    using type = TCfg;
+};
+
+template<typename TCfg>
+struct remove_lazy<lazy<TCfg>> {
+    using type = TCfg;
+};
+
+template<typename TCfg>
+using remove_lazy_t = typename remove_lazy<TCfg>::type;
+
 template<typename TCfg>
 class NodeCreator {
     static_assert(
-            std::is_base_of_v<Config, sfun::remove_optional_t<TCfg>>,
+            std::is_base_of_v<Config, sfun::remove_optional_t<remove_lazy_t<TCfg>>>,
             "TConfig must be a subclass of tconf::Config.");
+    using NodeType = std::conditional_t<is_lazy_v<TCfg>, LazyNode<TCfg>, Node<TCfg>>;
 
 public:
-    NodeCreator(ConfigReaderPtr cfgReader, std::string nodeName, TCfg& nodeCfg)
+    NodeCreator(ConfigReaderPtr cfgReader, FieldName nodeName, TCfg& nodeCfg)
         : cfgReader_{cfgReader}
-        , nodeName_{(sfun_precondition(!nodeName.empty()), std::move(nodeName))}
+        , nodeName_{(sfun_precondition(!nodeName.original().empty()), std::move(nodeName))}
         , nodeCfg_{nodeCfg}
-        , nestedCfgReader_{cfgReader_ ? cfgReader_->makeNestedReader(nodeName_) : ConfigReaderPtr{}}
+        , node_{cfgReader_ ? std::make_unique<NodeType>(std::string{nodeName_.original()}) : nullptr}
     {
         if constexpr (sfun::is_optional_v<TCfg>)
             static_assert(
                     sfun::dependent_false<TCfg>,
                     "TConfig can't be placed in std::optional, use tconf::optional instead.");
-        node_ = std::make_unique<Node<TCfg>>(nodeName_, nodeCfg_, nestedCfgReader_);
     }
 
     NodeCreator<TCfg>& operator()()
     {
-        node_->markValueIsSet();
+        if (node_)
+            node_->markValueIsSet();
         return *this;
     }
 
     operator TCfg()
     {
         if (cfgReader_)
-            cfgReader_->addNode(nodeName_, std::move(node_));
+            cfgReader_->addNode(nodeName_, std::move(node_), &nodeCfg_);
 
-        if constexpr (!std::is_aggregate_v<TCfg>)
+        using Cfg = remove_lazy_t<TCfg>;
+        if constexpr (!std::is_aggregate_v<Cfg>)
             static_assert(
-                    std::is_constructible_v<TCfg, detail::ConfigReaderPtr>,
+                    std::is_constructible_v<Cfg, detail::ConfigReaderPtr>,
                     "Non aggregate config objects must inherit tconf::Config constructors with 'using "
                     "Config::Config;'");
 
-        return TCfg{nestedCfgReader_};
+        if constexpr (is_lazy_v<TCfg>)
+            return TCfg{};
+        else
+            return TCfg{ConfigReaderPtr{}};
     }
 
-    NodeCreator<TCfg>& ensure(std::function<void(const TCfg&)> validatingFunc)
+    template<
+            typename TValidatingFunc,
+            typename = std::enable_if_t<std::is_invocable_v<TValidatingFunc&, const TCfg&>>>
+    NodeCreator<TCfg>& ensure(TValidatingFunc validatingFunc)
     {
         if (cfgReader_)
-            cfgReader_->addValidator(std::make_unique<Validator<TCfg>>(*node_, nodeCfg_, std::move(validatingFunc)));
+            cfgReader_->addValidator(Validator::of<TCfg>(std::move(validatingFunc)), *node_, &nodeCfg_);
         return *this;
     }
 
@@ -85,16 +108,17 @@ public:
     {
         if (cfgReader_)
             cfgReader_->addValidator(
-                    std::make_unique<Validator<TCfg>>(*node_, nodeCfg_, TValidator{std::forward<TArgs>(args)...}));
+                    Validator::of<TCfg>(TValidator{std::forward<TArgs>(args)...}),
+                    *node_,
+                    &nodeCfg_);
         return *this;
     }
 
 private:
     ConfigReaderPtr cfgReader_;
-    std::string nodeName_;
+    FieldName nodeName_;
     TCfg& nodeCfg_;
-    ConfigReaderPtr nestedCfgReader_;
-    std::unique_ptr<Node<TCfg>> node_;
+    std::unique_ptr<NodeType> node_;
 };
 
 } //namespace tconf::detail
\ No newline at end of file
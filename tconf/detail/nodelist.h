@@ -15,13 +15,19 @@
 
 #pragma once
 
+#include "tconf/detail/config_reader_ptr.h"
 #include "tconf/detail/inode.h"
-#include "tconf/detail/loading_error.h"
+#include "tconf/detail/memory_resource.h"
+#include "tconf/detail/parallel_loader.h"
+#include "tconf/detail/schema.h"
 #include "tconf/detail/utils.h"
 #include "tconf/detail/type_traits.h"
 #include <tconf/errors.h>
 #include <tconf/tree/tree.h>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <vector>
 
@@ -35,73 +41,161 @@ namespace tconf::detail {
     template<typename TCfgList>
     class NodeList : public detail::INode {
     public:
-        NodeList(std::string name, TCfgList &nodeList, ConfigReaderPtr cfgReader,
-                 NodeListType type = NodeListType::Normal)
-                : name_{std::move(name)}, nodeList_{nodeList}, type_{type}, cfgReader_{cfgReader} {
+        explicit NodeList(std::string name, NodeListType type = NodeListType::Normal)
+                : name_{std::move(name)}, type_{type} {
             static_assert(
                     sfun::is_dynamic_sequence_container_v<sfun::remove_optional_t<TCfgList>>,
                     "Node list field must be a sequence container or a sequence container placed in std::optional");
+            if constexpr (!std::is_aggregate_v<Cfg>)
+                static_assert(
+                        std::is_constructible_v<Cfg, detail::ConfigReaderPtr>,
+                        "Non aggregate config objects must inherit tconf::Config constructors with 'using "
+                        "Config::Config;'");
         }
 
         void markValueIsSet() {
-            hasValue_ = true;
+            hasDefaultValue_ = true;
         }
 
-        void load(const TreeNode &nodeList) override {
-            hasValue_ = true;
-            position_ = nodeList.position();
+        void setParallel(std::size_t threadCount) {
+            isParallel_ = true;
+            threadCount_ = threadCount;
+        }
+
+        NodeBinding binding() const override {
+            // elements of a copy list are loaded over the first one and the elements of a parallel list
+            // are distributed among the threads, so these lists are collected first
+            return type_ == NodeListType::Copy || isParallel_ ? NodeBinding::Tree : NodeBinding::ConfigList;
+        }
+
+        NodeBinding structure() const override {
+            return NodeBinding::ConfigList;
+        }
+
+        BoundConfig begin(void *value, bool isList, const StreamPosition &position, const LoadingContext &ctx)
+                const override {
+            if (!isList)
+                throw ConfigError{"Node list '" + name_ + "': config node must be a list.", position};
+            resetContainer(*static_cast<TCfgList *>(value), ctx);
+            return {};
+        }
+
+        BoundConfig addElement(void *value, const LoadingContext &ctx) const override {
+            auto &cfg = maybeOptValue(*static_cast<TCfgList *>(value)).emplace_back(Cfg{ConfigReaderPtr{}});
+            return {&schemaOf<Cfg>(ctx.nameFormat), &cfg};
+        }
+
+        void load(void *value, const TreeNode &nodeList, const LoadingContext &ctx) const override {
             if (!nodeList.isList())
                 throw ConfigError{"Node list '" + name_ + "': config node must be a list.", nodeList.position()};
-            if constexpr (sfun::is_optional<TCfgList>::value)
-                nodeList_.emplace();
+            auto &nodeListValue = resetContainer(*static_cast<TCfgList *>(value), ctx);
+            // the collected errors are added in the order of the elements,
+            // and a memory resource isn't shared between the threads
+            if (isParallel_ && !ctx.errors && !ctx.memoryResource) {
+                loadParallel(nodeListValue, nodeList, ctx);
+                return;
+            }
+
+            auto overlayCtx = ctx;
+            overlayCtx.checkMissingFields = false;
 
-            maybeOptValue(nodeList_).clear();
-            for (auto i = 0; i < nodeList.asList().count(); ++i) {
+            // the first element of a copy list is loaded once and copied into the following elements
+            // before their own fields are loaded over it, the last element takes it by move
+            auto prototype = std::optional<Cfg>{};
+            const auto count = nodeList.asList().count();
+            for (auto i = 0; i < count; ++i) {
                 const auto &treeNode = nodeList.asList().node(i);
-                try {
-                    using Cfg = typename sfun::remove_optional_t<TCfgList>::value_type;
-                    if constexpr (!std::is_aggregate_v<Cfg>)
-                        static_assert(
-                                std::is_constructible_v<Cfg, detail::ConfigReaderPtr>,
-                                "Non aggregate config objects must inherit tconf::Config constructors with 'using "
-                                "Config::Config;'");
-
-                    auto cfg = Cfg{cfgReader_};
-                    if (cfgReader_) {
-                        if (type_ == NodeListType::Copy && i > 0)
-                            cfgReader_->load(nodeList.asList().node(0));
-                        cfgReader_->load(treeNode);
-                    }
-                    maybeOptValue(nodeList_).emplace_back(std::move(cfg));
-                }
-                catch (const LoadingError &e) {
-                    throw ConfigError{"Node list '" + name_ + "': " + e.what(), treeNode.position()};
+                if (type_ == NodeListType::Copy && i > 0) {
+                    auto cfg = (i == count - 1) ? std::move(*prototype) : *prototype;
+                    loadElement(cfg, treeNode, overlayCtx);
+                    nodeListValue.emplace_back(std::move(cfg));
+                    continue;
                 }
+                auto cfg = Cfg{ConfigReaderPtr{}};
+                loadElement(cfg, treeNode, ctx);
+                if (type_ == NodeListType::Copy && count > 1)
+                    prototype.emplace(cfg);
+                nodeListValue.emplace_back(std::move(cfg));
             }
         }
 
-        bool hasValue() const override {
+        BoundConfig loadedElement(void *value, std::size_t index, const LoadingContext &ctx) const override {
+            if (type_ == NodeListType::Copy)
+                return {};
+            auto &nodeListValue = *static_cast<TCfgList *>(value);
             if constexpr (sfun::is_optional_v<TCfgList>)
-                return true;
-            else
-                return hasValue_;
+                if (!nodeListValue.has_value())
+                    return {};
+            auto &list = maybeOptValue(nodeListValue);
+            if (index >= list.size())
+                return {};
+            auto &cfg = *std::next(list.begin(), static_cast<std::ptrdiff_t>(index));
+            return {&schemaOf<Cfg>(ctx.nameFormat), &cfg};
         }
 
-        StreamPosition position() override {
-            return position_;
+        const Schema *schema(const LoadingContext &ctx) const override {
+            return &schemaOf<Cfg>(ctx.nameFormat);
         }
 
-        std::string description() override {
+        bool isCopyList() const override {
+            return type_ == NodeListType::Copy;
+        }
+
+        bool isOptional() const override {
+            return sfun::is_optional_v<TCfgList> || hasDefaultValue_;
+        }
+
+        std::string description() const override {
             return "Node list '" + name_ + "'";
         }
 
+    private:
+        using Cfg = typename sfun::remove_optional_t<TCfgList>::value_type;
+
+        void loadElement(Cfg &cfg, const TreeNode &treeNode, const LoadingContext &ctx) const {
+            schemaOf<Cfg>(ctx.nameFormat).load(&cfg, treeNode, ctx, this);
+        }
+
+        /// The container is filled with the elements first, then they are loaded in place by the worker threads
+        template<typename TList>
+        void loadParallel(TList &nodeListValue, const TreeNode &nodeList, const LoadingContext &ctx) const {
+            const auto count = static_cast<std::size_t>(nodeList.asList().count());
+            if constexpr (sfun::has_reserve_v<TList>)
+                nodeListValue.reserve(count);
+            auto elements = std::vector<Cfg *>{};
+            elements.reserve(count);
+            for (auto i = std::size_t{}; i < count; ++i)
+                elements.push_back(&nodeListValue.emplace_back(Cfg{ConfigReaderPtr{}}));
+
+            auto firstIndex = std::size_t{};
+            if (type_ == NodeListType::Copy && count > 0) {
+                loadElement(*elements.front(), nodeList.asList().node(0), ctx);
+                firstIndex = 1;
+            }
+            auto overlayCtx = ctx;
+            overlayCtx.checkMissingFields = false;
+            loadInParallel(
+                    count - firstIndex,
+                    threadCount_,
+                    [&](std::size_t i) {
+                        const auto index = firstIndex + i;
+                        auto &cfg = *elements[index];
+                        const auto &treeNode = nodeList.asList().node(static_cast<int>(index));
+                        if (type_ == NodeListType::Copy) {
+                            cfg = *elements.front();
+                            loadElement(cfg, treeNode, overlayCtx);
+                        }
+                        else
+                            loadElement(cfg, treeNode, ctx);
+                    });
+        }
+
     private:
         std::string name_;
-        TCfgList &nodeList_;
-        bool hasValue_ = false;
-        StreamPosition position_;
         NodeListType type_;
-        ConfigReaderPtr cfgReader_;
+        bool hasDefaultValue_ = false;
+        bool isParallel_ = false;
+        std::size_t threadCount_ = 0;
     };
 
 } //namespace tconf::detail
\ No newline at end of file
@@ -1,9 +1,12 @@
 #pragma once
+#include "tconf/detail/field_name.h"
 #include "tconf/detail/iconfig_reader.h"
 #include "tconf/detail/nodelist.h"
 #include "tconf/detail/contract.h"
 #include "tconf/detail/type_traits.h"
+#include "tconf/detail/validator.h"
 #include <tconf/name_format.h>
+#include <type_traits>
 
 namespace tconf {
 class Config;
@@ -23,38 +26,51 @@ class NodeListCreator {
 public:
     NodeListCreator(
             ConfigReaderPtr cfgReader,
-            std::string nodeListName,
+            FieldName nodeListName,
             TCfgList& nodeList,
             NodeListType type = NodeListType::Normal)
         : cfgReader_{cfgReader}
-        , nodeListName_{(sfun_precondition(!nodeListName.empty()), std::move(nodeListName))}
-        , nodeList_{std::make_unique<NodeList<TCfgList>>(
-                  nodeListName_,
-                  nodeList,
-                  cfgReader_ ? cfgReader_->makeNestedReader(nodeListName_) : ConfigReaderPtr{},
-                  type)}
+        , nodeListName_{(sfun_precondition(!nodeListName.original().empty()), std::move(nodeListName))}
+        , nodeList_{
+                  cfgReader_ ? std::make_unique<NodeList<TCfgList>>(std::string{nodeListName_.original()}, type)
+                             : nullptr}
         , nodeListValue_(nodeList)
     {
     }
 
     NodeListCreator<TCfgList>& operator()()
     {
-        nodeList_->markValueIsSet();
+        if (nodeList_)
+            nodeList_->markValueIsSet();
+        return *this;
+    }
+
+    /// Loads the elements on up to threadCount threads, zero means the number of hardware threads.
+    /// The order of the elements and the reported error are the same as for the sequential loading.
+    NodeListCreator<TCfgList>& parallel(std::size_t threadCount = 0)
+    {
+        if (nodeList_)
+            nodeList_->setParallel(threadCount);
         return *this;
     }
 
     operator TCfgList()
     {
         if (cfgReader_)
-            cfgReader_->addNode(nodeListName_, std::move(nodeList_));
+            cfgReader_->addNode(nodeListName_, std::move(nodeList_), &nodeListValue_);
         return {};
     }
 
-    NodeListCreator<TCfgList>& ensure(std::function<void(const TCfgList&)> validatingFunc)
+    template<
+            typename TValidatingFunc,
+            typename = std::enable_if_t<std::is_invocable_v<TValidatingFunc&, const TCfgList&>>>
+    NodeListCreator<TCfgList>& ensure(TValidatingFunc validatingFunc)
     {
         if (cfgReader_)
             cfgReader_->addValidator(
-                    std::make_unique<Validator<TCfgList>>(*nodeList_, nodeListValue_, std::move(validatingFunc)));
+                    Validator::of<TCfgList>(std::move(validatingFunc)),
+                    *nodeList_,
+                    &nodeListValue_);
         return *this;
     }
 
@@ -62,16 +78,16 @@ public:
     NodeListCreator<TCfgList>& ensure(TArgs&&... args)
     {
         if (cfgReader_)
-            cfgReader_->addValidator(std::make_unique<Validator<TCfgList>>(
+            cfgReader_->addValidator(
+                    Validator::of<TCfgList>(TValidator{std::forward<TArgs>(args)...}),
                     *nodeList_,
-                    nodeListValue_,
-                    TValidator{std::forward<TArgs>(args)...}));
+                    &nodeListValue_);
         return *this;
     }
 
 private:
     ConfigReaderPtr cfgReader_;
-    std::string nodeListName_;
+    FieldName nodeListName_;
     std::unique_ptr<NodeList<TCfgList>> nodeList_;
     TCfgList& nodeListValue_;
 };
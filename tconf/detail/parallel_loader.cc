@@ -0,0 +1,113 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/detail/parallel_loader.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace tconf::detail {
+
+    namespace {
+
+        // a thread isn't worth starting for fewer elements
+        constexpr auto minElementsPerThread = std::size_t{64};
+        // more chunks than threads, so the threads that got cheap elements take more work
+        constexpr auto chunksPerThread = std::size_t{8};
+
+        std::size_t workerCount(std::size_t count, std::size_t threadCount, std::size_t minCountPerThread) {
+            if (threadCount == 0)
+                threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+            return std::max(std::min(threadCount, count / minCountPerThread), std::size_t{1});
+        }
+
+        /// Runs work on the calling thread and workers - 1 started ones
+        void runOnThreads(std::size_t workers, const std::function<void()> &work) {
+            auto threads = std::vector<std::thread>{};
+            threads.reserve(workers - 1);
+            try {
+                for (auto i = std::size_t{1}; i < workers; ++i)
+                    threads.emplace_back(work);
+            }
+            catch (const std::system_error &) {
+                // the started threads and the calling one do all the work anyway
+            }
+            work();
+            for (auto &thread: threads)
+                thread.join();
+        }
+
+    } //namespace
+
+    void loadInParallel(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t)> &loadElement) {
+        const auto workers = workerCount(count, threadCount, minElementsPerThread);
+        if (workers == 1) {
+            for (auto i = std::size_t{}; i < count; ++i)
+                loadElement(i);
+            return;
+        }
+
+        const auto chunkSize = std::max(count / (workers * chunksPerThread), std::size_t{1});
+        auto nextChunk = std::atomic<std::size_t>{};
+        auto errorIndex = std::atomic<std::size_t>{count};
+        auto errorMutex = std::mutex{};
+        auto error = std::exception_ptr{};
+
+        auto work = [&] {
+            while (true) {
+                const auto begin = nextChunk.fetch_add(1, std::memory_order_relaxed) * chunkSize;
+                if (begin >= count)
+                    return;
+                const auto end = std::min(begin + chunkSize, count);
+                for (auto i = begin; i < end; ++i) {
+                    // the elements following an error won't be used
+                    if (i > errorIndex.load(std::memory_order_relaxed))
+                        return;
+                    try {
+                        loadElement(i);
+                    }
+                    catch (...) {
+                        auto lock = std::lock_guard{errorMutex};
+                        if (i < errorIndex.load(std::memory_order_relaxed)) {
+                            errorIndex.store(i, std::memory_order_relaxed);
+                            error = std::current_exception();
+                        }
+                        return;
+                    }
+                }
+            }
+        };
+
+        runOnThreads(workers, work);
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void runInParallel(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t)> &task) {
+        const auto workers = workerCount(count, threadCount, 1);
+        auto nextIndex = std::atomic<std::size_t>{};
+        runOnThreads(workers, [&] {
+            for (auto i = nextIndex.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = nextIndex.fetch_add(1, std::memory_order_relaxed))
+                task(i);
+        });
+    }
+
+} //namespace tconf::detail
@@ -0,0 +1,38 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace tconf::detail {
+
+    ///
+    /// Calls loadElement for each index of [0, count) on up to threadCount threads including the calling one,
+    /// zero threadCount means the number of hardware threads. Short ranges are loaded on the calling thread only.
+    /// The indexes are taken in chunks, if some calls have thrown, the exception of the lowest index
+    /// is rethrown after all threads are joined, like it would be by a sequential loop.
+    ///
+    void loadInParallel(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t)> &loadElement);
+
+    ///
+    /// Calls task for each index of [0, count) on up to threadCount threads including the calling one,
+    /// zero threadCount means the number of hardware threads. Each index is a separate unit of work,
+    /// e.g. a config file, so a thread is started even for a couple of them. The task must not throw.
+    ///
+    void runInParallel(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t)> &task);
+
+} //namespace tconf::detail
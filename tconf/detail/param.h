@@ -16,6 +16,7 @@
 #pragma once
 #include "tconf/detail/iconfig_entity.h"
 #include "tconf/detail/iparam.h"
+#include "tconf/detail/memory_resource.h"
 #include "tconf/detail/string_converter.h"
 #include "tconf/detail/utils.h"
 #include "tconf/detail/functional.h"
@@ -26,70 +27,63 @@
 #include <algorithm>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 namespace tconf::detail {
 
 template<typename T>
 class Param : public IParam {
 public:
-    Param(std::string name, T& paramValue)
+    explicit Param(std::string name)
         : name_{std::move(name)}
-        , paramValue_{paramValue}
     {
     }
 
     void markValueIsSet()
     {
-        hasValue_ = true;
+        hasDefaultValue_ = true;
     }
 
 private:
-    void load(const TreeParam& param) override
+    void load(void* value, const TreeValue& paramValue, const StreamPosition& position, const LoadingContext& ctx)
+            const override
     {
-        hasValue_ = true;
-        position_ = param.position();
-        if (!param.isItem())
-            throw ConfigError{"Parameter '" + name_ + "': config parameter can't be a list.", param.position()};
-        auto paramReadResult = convertFromString<T>(param.value());
+        auto paramReadResult = convertFromValue<T>(paramValue);
         auto readResultVisitor = sfun::overloaded{
-                [&](const T& param)
+                [&](T& param)
                 {
-                    paramValue_ = param;
+                    assignValue(*static_cast<T*>(value), std::move(param), ctx);
                 },
                 [&](const StringConversionError& error)
                 {
-                    throw ConfigError{
-                            "Couldn't set parameter '" + name_ + "' value from '" + param.value() + "'" +
+                    reportError(
+                            ctx,
+                            "Couldn't set parameter '" + name_ + "' value from '" + paramValue.text() + "'" +
                                     (!error.message.empty() ? ": " + error.message : ""),
-                            param.position()};
+                            position);
                 }};
 
         std::visit(readResultVisitor, paramReadResult);
     }
 
-    bool hasValue() const override
+    void load(void*, TreeValueList, const StreamPosition& position, const LoadingContext& ctx) const override
     {
-        if constexpr (sfun::is_optional_v<T>)
-            return true;
-        else
-            return hasValue_;
+        reportError(ctx, "Parameter '" + name_ + "': config parameter can't be a list.", position);
     }
 
-    StreamPosition position() override
+    bool isOptional() const override
     {
-        return position_;
+        return sfun::is_optional_v<T> || hasDefaultValue_;
     }
 
-    std::string description() override
+    std::string description() const override
     {
         return "Parameter '" + name_ + "'";
     }
 
 private:
     std::string name_;
-    T& paramValue_;
-    bool hasValue_ = false;
-    StreamPosition position_;
+    bool hasDefaultValue_ = false;
 };
 
 } //namespace tconf::detail
\ No newline at end of file
@@ -15,35 +15,44 @@
 
 
 #pragma once
+#include "tconf/detail/field_name.h"
 #include "tconf/detail/iconfig_reader.h"
+#include "tconf/detail/lazy_param.h"
 #include "tconf/detail/param.h"
 #include "tconf/detail/validator.h"
 #include "tconf/detail/contract.h"
+#include <type_traits>
 
 namespace tconf::detail {
 
 template<typename T>
 class ParamCreator {
+    using ParamType = std::conditional_t<is_lazy_param_v<T>, LazyParam<T>, Param<T>>;
+
 public:
-    ParamCreator(ConfigReaderPtr cfgReader, std::string paramName, T& paramValue)
+    ParamCreator(ConfigReaderPtr cfgReader, FieldName paramName, T& paramValue)
         : cfgReader_{cfgReader}
-        , paramName_{(sfun_precondition(!paramName.empty()), std::move(paramName))}
+        , paramName_{(sfun_precondition(!paramName.original().empty()), std::move(paramName))}
         , paramValue_{paramValue}
-        , param_{std::make_unique<Param<T>>(paramName_, paramValue)}
+        , param_{cfgReader_ ? std::make_unique<ParamType>(std::string{paramName_.original()}) : nullptr}
     {
     }
 
     ParamCreator<T>& operator()(T defaultValue = {})
     {
         defaultValue_ = std::move(defaultValue);
-        param_->markValueIsSet();
+        if (param_)
+            param_->markValueIsSet();
         return *this;
     }
 
-    ParamCreator<T>& ensure(std::function<void(const T&)> validatingFunc)
+    template<
+            typename TValidatingFunc,
+            typename = std::enable_if_t<std::is_invocable_v<TValidatingFunc&, const T&>>>
+    ParamCreator<T>& ensure(TValidatingFunc validatingFunc)
     {
         if (cfgReader_)
-            cfgReader_->addValidator(std::make_unique<Validator<T>>(*param_, paramValue_, std::move(validatingFunc)));
+            cfgReader_->addValidator(Validator::of<T>(std::move(validatingFunc)), *param_, &paramValue_);
         return *this;
     }
 
@@ -52,22 +61,24 @@ public:
     {
         if (cfgReader_)
             cfgReader_->addValidator(
-                    std::make_unique<Validator<T>>(*param_, paramValue_, TValidator{std::forward<TArgs>(args)...}));
+                    Validator::of<T>(TValidator{std::forward<TArgs>(args)...}),
+                    *param_,
+                    &paramValue_);
         return *this;
     }
 
     operator T()
     {
         if (cfgReader_)
-            cfgReader_->addParam(paramName_, std::move(param_));
+            cfgReader_->addParam(paramName_, std::move(param_), &paramValue_);
         return defaultValue_;
     }
 
 private:
     ConfigReaderPtr cfgReader_;
-    std::string paramName_;
+    FieldName paramName_;
     T& paramValue_;
-    std::unique_ptr<Param<T>> param_;
+    std::unique_ptr<ParamType> param_;
     T defaultValue_;
 };
 
@@ -16,6 +16,7 @@
 
 #pragma once
 #include "tconf/detail/iparam.h"
+#include "tconf/detail/memory_resource.h"
 #include "tconf/detail/string_converter.h"
 #include "tconf/detail/utils.h"
 #include "tconf/detail/type_traits.h"
@@ -25,6 +26,7 @@
 #include <algorithm>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tconf::detail {
@@ -36,70 +38,66 @@ class ParamList : public IParam {
             "Param list field must be a sequence container or a sequence container placed in std::optional");
 
 public:
-    ParamList(std::string name, TParamList& paramValue)
+    explicit ParamList(std::string name)
         : name_{std::move(name)}
-        , paramListValue_{paramValue}
     {
     }
 
     void markValueIsSet()
     {
-        hasValue_ = true;
+        hasDefaultValue_ = true;
     }
 
 private:
-    void load(const TreeParam& paramList) override
+    void load(void* value, const TreeValue&, const StreamPosition& position, const LoadingContext& ctx) const override
     {
-        position_ = paramList.position();
-        hasValue_ = true;
-        if constexpr (sfun::is_optional_v<TParamList>)
-            paramListValue_.emplace();
+        resetContainer(*static_cast<TParamList*>(value), ctx);
+        reportError(ctx, "Parameter list '" + name_ + "': config parameter must be a list.", position);
+    }
 
-        if (!paramList.isList())
-            throw ConfigError{"Parameter list '" + name_ + "': config parameter must be a list.", paramList.position()};
-        for (const auto& paramValueStr : paramList.valueList()) {
+    void load(void* value, TreeValueList valueList, const StreamPosition& position, const LoadingContext& ctx)
+            const override
+    {
+        auto& paramListValue = resetContainer(*static_cast<TParamList*>(value), ctx);
+        for (const auto& paramValueItem : valueList) {
             using Param = typename sfun::remove_optional_t<TParamList>::value_type;
-            auto paramReadResult = convertFromString<Param>(paramValueStr);
+            auto paramReadResult = convertFromValue<Param>(paramValueItem);
             auto readResultVisitor = sfun::overloaded{
-                    [&](const Param& param)
+                    [&](Param& param)
                     {
-                        maybeOptValue(paramListValue_).emplace_back(param);
+                        paramListValue.emplace_back(std::move(param));
+                        return true;
                     },
                     [&](const StringConversionError& error)
                     {
-                        throw ConfigError{
-                                "Couldn't set parameter list element'" + name_ + "' value from '" + paramValueStr +
-                                        "'" + (!error.message.empty() ? ": " + error.message : ""),
-                                paramList.position()};
+                        reportError(
+                                ctx,
+                                "Couldn't set parameter list element'" + name_ + "' value from '" +
+                                        paramValueItem.text() + "'" +
+                                        (!error.message.empty() ? ": " + error.message : ""),
+                                position);
+                        return false;
                     }};
 
-            std::visit(readResultVisitor, paramReadResult);
+            // the list isn't loaded further after a collected error
+            if (!std::visit(readResultVisitor, paramReadResult))
+                return;
         }
     }
 
-    bool hasValue() const override
-    {
-        if constexpr (sfun::is_optional_v<TParamList>)
-            return true;
-        else
-            return hasValue_;
-    }
-
-    StreamPosition position() override
+    bool isOptional() const override
     {
-        return position_;
+        return sfun::is_optional_v<TParamList> || hasDefaultValue_;
     }
 
-    std::string description() override
+    std::string description() const override
     {
         return "Parameter list '" + name_ + "'";
     }
 
 private:
     std::string name_;
-    TParamList& paramListValue_;
-    bool hasValue_ = false;
-    StreamPosition position_;
+    bool hasDefaultValue_ = false;
 };
 
 } //namespace tconf::detail
\ No newline at end of file
@@ -13,6 +13,7 @@
 // limitations under the License.
 //
 #pragma once
+#include "tconf/detail/field_name.h"
 #include "tconf/detail/iconfig_reader.h"
 #include "tconf/detail/inode.h"
 #include "tconf/detail/paramlist.h"
@@ -20,6 +21,7 @@
 #include "tconf/detail/validator.h"
 #include "tconf/detail/contract.h"
 #include "tconf/detail/type_traits.h"
+#include <type_traits>
 #include <vector>
 
 namespace tconf::detail {
@@ -31,26 +33,34 @@ class ParamListCreator {
             "Param list field must be a sequence container or a sequence container placed in std::optional");
 
 public:
-    ParamListCreator(ConfigReaderPtr cfgReader, std::string paramListName, TParamList& paramListValue)
+    ParamListCreator(ConfigReaderPtr cfgReader, FieldName paramListName, TParamList& paramListValue)
         : cfgReader_{cfgReader}
-        , paramListName_{(sfun_precondition(!paramListName.empty()), std::move(paramListName))}
+        , paramListName_{(sfun_precondition(!paramListName.original().empty()), std::move(paramListName))}
         , paramListValue_{paramListValue}
-        , paramList_{std::make_unique<ParamList<TParamList>>(paramListName_, paramListValue)}
+        , paramList_{
+                  cfgReader_ ? std::make_unique<ParamList<TParamList>>(std::string{paramListName_.original()})
+                             : nullptr}
     {
     }
 
     ParamListCreator<TParamList>& operator()(TParamList defaultValue = {})
     {
         defaultValue_ = std::move(defaultValue);
-        paramList_->markValueIsSet();
+        if (paramList_)
+            paramList_->markValueIsSet();
         return *this;
     }
 
-    ParamListCreator<TParamList>& ensure(std::function<void(const TParamList&)> validatingFunc)
+    template<
+            typename TValidatingFunc,
+            typename = std::enable_if_t<std::is_invocable_v<TValidatingFunc&, const TParamList&>>>
+    ParamListCreator<TParamList>& ensure(TValidatingFunc validatingFunc)
     {
         if (cfgReader_)
             cfgReader_->addValidator(
-                    std::make_unique<Validator<TParamList>>(*paramList_, paramListValue_, std::move(validatingFunc)));
+                    Validator::of<TParamList>(std::move(validatingFunc)),
+                    *paramList_,
+                    &paramListValue_);
         return *this;
     }
 
@@ -58,23 +68,23 @@ public:
     ParamListCreator<TParamList>& ensure(TArgs&&... args)
     {
         if (cfgReader_)
-            cfgReader_->addValidator(std::make_unique<Validator<TParamList>>(
+            cfgReader_->addValidator(
+                    Validator::of<TParamList>(TValidator{std::forward<TArgs>(args)...}),
                     *paramList_,
-                    paramListValue_,
-                    TValidator{std::forward<TArgs>(args)...}));
+                    &paramListValue_);
         return *this;
     }
 
     operator TParamList()
     {
         if (cfgReader_)
-            cfgReader_->addParam(paramListName_, std::move(paramList_));
+            cfgReader_->addParam(paramListName_, std::move(paramList_), &paramListValue_);
         return defaultValue_;
     }
 
 private:
     ConfigReaderPtr cfgReader_;
-    std::string paramListName_;
+    FieldName paramListName_;
     TParamList& paramListValue_;
     std::unique_ptr<ParamList<TParamList>> paramList_;
     TParamList defaultValue_;
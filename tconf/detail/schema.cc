@@ -0,0 +1,204 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/detail/schema.h"
+#include "tconf/detail/config_binder.h"
+#include "tconf/detail/contract.h"
+#include "tconf/detail/loading_error.h"
+#include <tconf/errors.h>
+#include <tconf/tree/itree_visitor.h>
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace tconf::detail {
+
+    void Schema::load(void *cfg, const TreeNode &treeNode, const LoadingContext &ctx, const INode *node) const {
+        auto binder = ConfigBinder{*this, cfg, ctx, node, treeNode.position()};
+        visitTree(treeNode, binder);
+        binder.finish();
+    }
+
+    namespace {
+
+        std::uint64_t mixHash(std::uint64_t hash, std::uint64_t value) {
+            // splitmix64 finalizer over the combined value
+            auto x = hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+
+        std::uint64_t stringHash(std::string_view value) {
+            auto hash = 0xcbf29ce484222325ull;
+            for (auto ch: value) {
+                hash ^= static_cast<unsigned char>(ch);
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+    } //namespace
+
+    std::uint64_t Schema::fingerprint(const LoadingContext &ctx) const {
+        auto visitedSchemas = std::vector<const Schema *>{};
+        return fingerprint(ctx, visitedSchemas);
+    }
+
+    std::uint64_t Schema::fingerprint(const LoadingContext &ctx, std::vector<const Schema *> &visitedSchemas) const {
+        // a config can contain a list of its own type
+        const auto visited = std::find(visitedSchemas.begin(), visitedSchemas.end(), this);
+        if (visited != visitedSchemas.end())
+            return mixHash(0, static_cast<std::uint64_t>(visited - visitedSchemas.begin()));
+        visitedSchemas.push_back(this);
+
+        auto hash = mixHash(0, fields_.size());
+        for (const auto &field: fields_) {
+            hash = mixHash(hash, stringHash(field.name));
+            if (field.param) {
+                hash = mixHash(hash, 0);
+                continue;
+            }
+            hash = mixHash(hash, static_cast<std::uint64_t>(field.node->structure()) + 1);
+            if (const auto nestedSchema = field.node->schema(ctx))
+                hash = mixHash(hash, nestedSchema->fingerprint(ctx, visitedSchemas));
+        }
+        visitedSchemas.pop_back();
+        return hash;
+    }
+
+    void Schema::checkRequiredFields(const TreeNode &treeNode, const LoadingContext &ctx) const {
+        const auto &item = treeNode.asItem();
+        for (const auto &field: fields_) {
+            if (field.param) {
+                if (!field.param->isOptional() && !item.hasParam(field.name))
+                    throw LoadingError{"Parameter '" + field.name + "' is missing."};
+                continue;
+            }
+            if (!item.hasNode(field.name)) {
+                if (!field.node->isOptional())
+                    throw LoadingError{"Node '" + field.name + "' is missing."};
+                continue;
+            }
+            // the nodes of a wrong kind are reported when they're loaded
+            const auto &childNode = item.node(field.name);
+            switch (field.node->structure()) {
+                case NodeBinding::Config:
+                    if (childNode.isItem())
+                        checkNestedRequiredFields(*field.node, childNode, "Node '" + field.name + "'", ctx);
+                    break;
+                case NodeBinding::ConfigList: {
+                    if (!childNode.isList())
+                        break;
+                    // the following elements of a copy list are loaded over the first one
+                    const auto &list = childNode.asList();
+                    const auto count = field.node->isCopyList() ? std::min(list.count(), 1) : list.count();
+                    for (auto i = 0; i < count; ++i)
+                        if (list.node(i).isItem())
+                            checkNestedRequiredFields(*field.node, list.node(i), field.node->description(), ctx);
+                    break;
+                }
+                case NodeBinding::ConfigDict:
+                    if (!childNode.isItem())
+                        break;
+                    for (const auto &[key, element]: childNode.asItem().nodes())
+                        if (element.isItem())
+                            checkNestedRequiredFields(
+                                    *field.node,
+                                    element,
+                                    field.node->description() + " element '" + std::string{key} + "'",
+                                    ctx);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void Schema::checkNestedRequiredFields(
+            const INode &node,
+            const TreeNode &treeNode,
+            const std::string &description,
+            const LoadingContext &ctx) {
+        try {
+            node.schema(ctx)->checkRequiredFields(treeNode, ctx);
+        }
+        catch (const LoadingError &e) {
+            throw ConfigError{description + ": " + e.what(), treeNode.position()};
+        }
+    }
+
+    const IConfigEntity &Schema::entity(const Field &field) const {
+        if (field.param)
+            return *field.param;
+        return *field.node;
+    }
+
+    SchemaBuilder::SchemaBuilder(NameFormat nameFormat)
+            : nameFormat_{nameFormat} {
+    }
+
+    void SchemaBuilder::addNode(const FieldName &name, std::unique_ptr<INode> node, const void *nodeValue) {
+        nodes_.emplace(
+                name.converted(nameFormat_),
+                PendingField{name.hash(nameFormat_), nodeValue, std::move(node), nullptr});
+    }
+
+    void SchemaBuilder::addParam(const FieldName &name, std::unique_ptr<IParam> param, const void *paramValue) {
+        params_.emplace(
+                name.converted(nameFormat_),
+                PendingField{name.hash(nameFormat_), paramValue, nullptr, std::move(param)});
+    }
+
+    void SchemaBuilder::addValidator(Validator validator, const IConfigEntity &entity, const void *entityValue) {
+        validators_.push_back({std::move(validator), &entity, entityValue});
+    }
+
+    Schema SchemaBuilder::finish(const void *prototype, std::size_t prototypeSize) {
+        auto prototypeData = static_cast<const char *>(prototype);
+        auto offsetOf = [&](const void *address) {
+            auto offset = static_cast<const char *>(address) - prototypeData;
+            sfun_precondition(offset >= 0 && static_cast<std::size_t>(offset) < prototypeSize);
+            return offset;
+        };
+
+        auto schema = Schema{};
+        // parameters go first to keep the order of the missing fields checks
+        for (auto &[name, pendingParam]: params_) {
+            schema.paramIndex_.insert(name, schema.fields_.size(), pendingParam.hash);
+            schema.fields_.push_back({name, offsetOf(pendingParam.address), nullptr, std::move(pendingParam.param)});
+        }
+        for (auto &[name, pendingNode]: nodes_) {
+            schema.nodeIndex_.insert(name, schema.fields_.size(), pendingNode.hash);
+            schema.fields_.push_back({name, offsetOf(pendingNode.address), std::move(pendingNode.node), nullptr});
+        }
+        schema.paramIndex_.build();
+        schema.nodeIndex_.build();
+
+        auto validators = std::vector<ValidatorTable::BoundValidator>{};
+        validators.reserve(validators_.size());
+        for (auto &pendingValidator: validators_) {
+            for (auto i = std::size_t{}; i < schema.fields_.size(); ++i) {
+                if (&schema.entity(schema.fields_[i]) != pendingValidator.entity)
+                    continue;
+                validators.push_back({std::move(pendingValidator.validator), offsetOf(pendingValidator.address), i});
+                break;
+            }
+        }
+        schema.validators_ = ValidatorTable{std::move(validators)};
+        return schema;
+    }
+
+} //namespace tconf::detail
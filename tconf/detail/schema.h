@@ -0,0 +1,162 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "tconf/detail/config_reader_ptr.h"
+#include "tconf/detail/field_index.h"
+#include "tconf/detail/field_name.h"
+#include "tconf/detail/iconfig_reader.h"
+#include "tconf/detail/inode.h"
+#include "tconf/detail/iparam.h"
+#include "tconf/detail/validator.h"
+#include "tconf/detail/loading_context.h"
+#include <tconf/name_format.h>
+#include <tconf/tree/tree.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace tconf::detail {
+
+    ///
+    /// Loading description of a config type compiled once from a prototype object:
+    /// its fields are stored with their member offsets and bound to the loaded
+    /// object by address, so reading doesn't register anything per call.
+    ///
+    class Schema {
+    public:
+        ///
+        /// Loads the tree through ConfigBinder, missing fields of the tree's root are reported with LoadingError,
+        /// or with ConfigError prefixed by the description of the node if the node of a list element is passed
+        ///
+        void load(void *cfg, const TreeNode &treeNode, const LoadingContext &ctx, const INode *node = nullptr) const;
+
+        ///
+        /// Hash of the config's structure: the names and kinds of its fields and the structure of the nested configs.
+        /// It identifies the config type a tree was validated with, e.g. in a binary snapshot.
+        ///
+        std::uint64_t fingerprint(const LoadingContext &ctx) const;
+
+        ///
+        /// Checks that the tree has the required fields of the config and of its nested configs, list elements
+        /// and dictionary values without loading them, the missing fields of the tree's root are reported
+        /// with LoadingError
+        ///
+        void checkRequiredFields(const TreeNode &treeNode, const LoadingContext &ctx) const;
+
+    private:
+        struct Field {
+            std::string name;
+            std::ptrdiff_t offset = 0;
+            std::unique_ptr<INode> node;
+            std::unique_ptr<IParam> param;
+        };
+
+        const IConfigEntity &entity(const Field &field) const;
+
+        static void checkNestedRequiredFields(
+                const INode &node,
+                const TreeNode &treeNode,
+                const std::string &description,
+                const LoadingContext &ctx);
+
+        std::uint64_t fingerprint(const LoadingContext &ctx, std::vector<const Schema *> &visitedSchemas) const;
+
+    private:
+        std::vector<Field> fields_;
+        FieldIndex nodeIndex_;
+        FieldIndex paramIndex_;
+        ValidatorTable validators_;
+
+        friend class SchemaBuilder;
+
+        friend class ConfigBinder;
+
+        friend class ConfigUpdater;
+    };
+
+    ///
+    /// Collects the fields registered by the prototype object during its construction
+    ///
+    class SchemaBuilder : public IConfigReader {
+    public:
+        explicit SchemaBuilder(NameFormat nameFormat);
+
+        template<typename TCfg>
+        Schema build() {
+            if constexpr (!std::is_aggregate_v<TCfg>)
+                static_assert(
+                        std::is_constructible_v<TCfg, detail::ConfigReaderPtr>,
+                        "Non aggregate config objects must inherit tconf::Config constructors with 'using "
+                        "Config::Config;'");
+            auto prototype = TCfg{makePtr()};
+            return finish(&prototype, sizeof(TCfg));
+        }
+
+    private:
+        void addNode(const FieldName &name, std::unique_ptr<INode> node, const void *nodeValue) override;
+
+        void addParam(const FieldName &name, std::unique_ptr<IParam> param, const void *paramValue) override;
+
+        void addValidator(Validator validator, const IConfigEntity &entity, const void *entityValue) override;
+
+        Schema finish(const void *prototype, std::size_t prototypeSize);
+
+    private:
+        struct PendingField {
+            std::uint64_t hash = 0;
+            const void *address = nullptr;
+            std::unique_ptr<INode> node;
+            std::unique_ptr<IParam> param;
+        };
+
+        struct PendingValidator {
+            Validator validator;
+            const IConfigEntity *entity = nullptr;
+            const void *address = nullptr;
+        };
+
+        NameFormat nameFormat_;
+        std::map<std::string, PendingField> nodes_;
+        std::map<std::string, PendingField> params_;
+        std::vector<PendingValidator> validators_;
+    };
+
+    template<typename TCfg, NameFormat nameFormat>
+    const Schema &schemaOf() {
+        static const auto schema = SchemaBuilder{nameFormat}.build<TCfg>();
+        return schema;
+    }
+
+    template<typename TCfg>
+    const Schema &schemaOf(NameFormat nameFormat) {
+        switch (nameFormat) {
+            case NameFormat::SnakeCase:
+                return schemaOf<TCfg, NameFormat::SnakeCase>();
+            case NameFormat::CamelCase:
+                return schemaOf<TCfg, NameFormat::CamelCase>();
+            case NameFormat::KebabCase:
+                return schemaOf<TCfg, NameFormat::KebabCase>();
+            default:
+                return schemaOf<TCfg, NameFormat::Original>();
+        }
+    }
+
+} //namespace tconf::detail
@@ -18,8 +18,12 @@
 #define TCONF_STRINGCONVERTER_H
 
 #include "tconf/errors.h"
+#include "tconf/tree/arithmetic_converter.h"
 #include "tconf/tree/string_converter.h"
+#include "tconf/tree/tree_value.h"
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 
 namespace tconf::detail {
@@ -28,11 +32,26 @@ struct StringConversionError {
     std::string message;
 };
 
+template<typename T, typename = void>
+struct hasStringViewConverter : std::false_type {};
+
+template<typename T>
+struct hasStringViewConverter<
+        T,
+        std::void_t<decltype(StringConverter<T>::fromString(std::declval<std::string_view>()))>>
+    : std::true_type {};
+
 template<typename T>
-std::variant<T, StringConversionError> convertFromString(const std::string& data)
+std::variant<T, StringConversionError> convertFromString(std::string_view data)
 {
     try {
-        auto result = StringConverter<T>::fromString(data);
+        auto result = [&]
+        {
+            if constexpr (hasStringViewConverter<T>::value)
+                return StringConverter<T>::fromString(data);
+            else
+                return StringConverter<T>::fromString(std::string{data});
+        }();
         if (!result.has_value())
             return StringConversionError{};
         else
@@ -46,6 +65,44 @@ std::variant<T, StringConversionError> convertFromString(const std::string& data
     }
 }
 
+///
+/// Converts a typed value directly if the param's type can hold it: booleans to bool, numbers to the arithmetic
+/// types. Strings and the values of the other types are converted from their text with StringConverter.
+///
+template<typename T>
+std::variant<T, StringConversionError> convertFromValue(const TreeValue& value)
+{
+    using Type = TreeValue::Type;
+    using TValue = sfun::remove_optional_t<T>;
+    if (value.isString())
+        return convertFromString<T>(value.asString());
+
+    try {
+        if constexpr (std::is_same_v<TValue, bool>) {
+            if (value.type() == Type::Bool)
+                return T{value.asBool()};
+        }
+        else if constexpr (isIntegerNumber<TValue>) {
+            if (value.type() == Type::Integer)
+                return T{integerCast<TValue>(value.asInteger())};
+            if (value.type() == Type::Unsigned)
+                return T{integerCast<TValue>(value.asUnsigned())};
+        }
+        else if constexpr (std::is_floating_point_v<TValue>) {
+            if (value.type() == Type::Float)
+                return T{floatCast<TValue>(value.asFloat())};
+            if (value.type() == Type::Integer)
+                return T{static_cast<TValue>(value.asInteger())};
+            if (value.type() == Type::Unsigned)
+                return T{static_cast<TValue>(value.asUnsigned())};
+        }
+    }
+    catch (const ValidationError& error) {
+        return StringConversionError{error.what()};
+    }
+    return convertFromString<T>(value.text());
+}
+
 } //namespace tconf::detail
 
 #endif //TCONF_STRINGCONVERTER_H
@@ -17,7 +17,10 @@
 #ifndef TCONF_SFUN_TYPE_TRAITS_H
 #define TCONF_SFUN_TYPE_TRAITS_H
 
+#include <cstddef>
+#include <memory_resource>
 #include <optional>
+#include <string>
 #include <tuple>
 #include <type_traits>
 
@@ -65,6 +68,17 @@ namespace tconf::sfun {
     template<typename T>
     inline constexpr auto is_dynamic_sequence_container_v = is_dynamic_sequence_container<T>::value;
 
+    template<typename, typename = void>
+    struct has_reserve : std::false_type {
+    };
+
+    template<typename T>
+    struct has_reserve<T, std::void_t<decltype(std::declval<T>().reserve(std::size_t{}))>> : std::true_type {
+    };
+
+    template<typename T>
+    inline constexpr auto has_reserve_v = has_reserve<T>::value;
+
     template<typename, typename = void>
     struct is_associative_container : std::false_type {
     };
@@ -85,6 +99,17 @@ namespace tconf::sfun {
     template<typename T>
     inline constexpr auto is_associative_container_v = is_associative_container<T>::value;
 
+    template<typename, typename = void>
+    struct is_unordered_container : std::false_type {
+    };
+
+    template<typename T>
+    struct is_unordered_container<T, std::void_t<typename T::hasher>> : std::true_type {
+    };
+
+    template<typename T>
+    inline constexpr auto is_unordered_container_v = is_unordered_container<T>::value;
+
     template<typename, typename = void>
     struct provides_member_access : std::false_type {
     };
@@ -118,6 +143,30 @@ namespace tconf::sfun {
     template<typename T>
     inline constexpr auto is_dereferencable_v = is_dereferencable<T>::value;
 
+    /// std::basic_string of char with any traits and allocator
+    template<typename T>
+    struct is_basic_string : std::false_type {
+    };
+
+    template<typename TTraits, typename TAllocator>
+    struct is_basic_string<std::basic_string<char, TTraits, TAllocator>> : std::true_type {
+    };
+
+    template<typename T>
+    inline constexpr auto is_basic_string_v = is_basic_string<T>::value;
+
+    template<typename, typename = void>
+    struct uses_polymorphic_allocator : std::false_type {
+    };
+
+    template<typename T>
+    struct uses_polymorphic_allocator<T, std::void_t<typename T::allocator_type, typename T::value_type>>
+            : std::is_same<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::value_type>> {
+    };
+
+    template<typename T>
+    inline constexpr auto uses_polymorphic_allocator_v = uses_polymorphic_allocator<T>::value;
+
     template<typename T>
     struct type_identity {
         using type = T;
@@ -0,0 +1,97 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "tconf/detail/validator.h"
+#include <algorithm>
+
+namespace tconf::detail {
+
+    ValidatorTable::ValidatorTable(std::vector<BoundValidator> validators) {
+        // the validators are placed one after another with their own alignment
+        auto size = std::size_t{};
+        auto alignment = alignof(std::max_align_t);
+        auto offsets = std::vector<std::size_t>{};
+        offsets.reserve(validators.size());
+        for (const auto &boundValidator: validators) {
+            const auto &ops = boundValidator.validator.ops();
+            size = (size + ops.alignment - 1) / ops.alignment * ops.alignment;
+            offsets.push_back(size);
+            size += ops.size;
+            alignment = std::max(alignment, ops.alignment);
+        }
+        if (validators.empty())
+            return;
+
+        entries_.reserve(validators.size());
+        destructors_.reserve(validators.size());
+        storage_ = ::operator new(size, std::align_val_t{alignment});
+        storageAlignment_ = alignment;
+        // the destructor doesn't run if the constructor throws, so the moved validators and the storage
+        // are released here
+        try {
+            for (auto i = std::size_t{}; i < validators.size(); ++i) {
+                auto &boundValidator = validators[i];
+                const auto &ops = boundValidator.validator.ops();
+                auto validator = static_cast<char *>(storage_) + offsets[i];
+                ops.moveConstruct(boundValidator.validator.get(), validator);
+                entries_.push_back({validator, ops.validate, boundValidator.offset, boundValidator.fieldIndex});
+                destructors_.push_back(ops.destroy);
+            }
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    ValidatorTable::ValidatorTable(ValidatorTable &&other) noexcept
+            : entries_{std::move(other.entries_)},
+              destructors_{std::move(other.destructors_)},
+              storage_{std::exchange(other.storage_, nullptr)},
+              storageAlignment_{other.storageAlignment_} {
+        other.entries_.clear();
+        other.destructors_.clear();
+    }
+
+    ValidatorTable &ValidatorTable::operator=(ValidatorTable &&other) noexcept {
+        if (this == &other)
+            return *this;
+        clear();
+        entries_ = std::move(other.entries_);
+        destructors_ = std::move(other.destructors_);
+        storage_ = std::exchange(other.storage_, nullptr);
+        storageAlignment_ = other.storageAlignment_;
+        other.entries_.clear();
+        other.destructors_.clear();
+        return *this;
+    }
+
+    ValidatorTable::~ValidatorTable() {
+        clear();
+    }
+
+    void ValidatorTable::clear() {
+        for (auto i = std::size_t{}; i < entries_.size(); ++i)
+            // the validators are called as const, but the table owns them
+            destructors_[i](const_cast<void *>(entries_[i].validator));
+        entries_.clear();
+        destructors_.clear();
+        if (storage_)
+            ::operator delete(storage_, std::align_val_t{storageAlignment_});
+        storage_ = nullptr;
+    }
+
+} //namespace tconf::detail
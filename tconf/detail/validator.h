@@ -13,36 +13,143 @@
 // limitations under the License.
 //
 
-
 #pragma once
 
-#include "tconf/detail/iconfig_entity.h"
-#include "tconf/detail/ivalidator.h"
-#include <tconf/errors.h>
-#include <functional>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace tconf::detail {
 
-    template<typename T>
-    class Validator : public IValidator {
+    ///
+    /// Operations of a concrete validator type, a validator is called through them
+    /// without being wrapped into std::function
+    ///
+    struct ValidatorOps {
+        std::size_t size = 0;
+        std::size_t alignment = 0;
+        void (*validate)(const void *validator, const void *entityValue) = nullptr;
+        void (*moveConstruct)(void *validator, void *storage) = nullptr;
+        void (*destroy)(void *validator) = nullptr;
+    };
+
+    template<typename T, typename TValidator>
+    const ValidatorOps &validatorOps() {
+        static const auto ops = ValidatorOps{
+                sizeof(TValidator),
+                alignof(TValidator),
+                [](const void *validator, const void *entityValue) {
+                    (*static_cast<const TValidator *>(validator))(*static_cast<const T *>(entityValue));
+                },
+                [](void *validator, void *storage) {
+                    new (storage) TValidator{std::move(*static_cast<TValidator *>(validator))};
+                },
+                [](void *validator) {
+                    static_cast<TValidator *>(validator)->~TValidator();
+                }};
+        return ops;
+    }
+
+    ///
+    /// Validator registered by a config field, it keeps its concrete type until it's moved into
+    /// the ValidatorTable of the built schema. The schema is shared by all the configs of its type,
+    /// so a validator is called concurrently by the parallel reads and must be callable as const.
+    ///
+    class Validator {
     public:
-        Validator(IConfigEntity &entity, T &entityValue, std::function<void(const T &)> validatingFunc)
-                : entity_(entity), entityValue_(entityValue), validatingFunc_(std::move(validatingFunc)) {
+        template<typename T, typename TValidator>
+        static Validator of(TValidator validator) {
+            using ValidatorType = std::decay_t<TValidator>;
+            static_assert(
+                    std::is_invocable_v<const ValidatorType &, const T &>,
+                    "Validator must have a const call operator: it's shared by the configs read concurrently, "
+                    "so it can't be a mutable lambda or keep a state modified by the validation");
+            return Validator{
+                    new ValidatorType{std::move(validator)},
+                    validatorOps<T, ValidatorType>(),
+                    [](void *validator) {
+                        delete static_cast<ValidatorType *>(validator);
+                    }};
+        }
+
+        const ValidatorOps &ops() const {
+            return *ops_;
+        }
+
+        void *get() const {
+            return validator_.get();
         }
 
     private:
-        void validate() override {
-            try {
-                validatingFunc_(entityValue_);
-            }
-            catch (const ValidationError &e) {
-                throw ConfigError{entity_.description() + ": " + e.what(), entity_.position()};
+        Validator(void *validator, const ValidatorOps &ops, void (*deleter)(void *))
+                : validator_{validator, deleter}, ops_{&ops} {
+        }
+
+    private:
+        std::unique_ptr<void, void (*)(void *)> validator_;
+        const ValidatorOps *ops_;
+    };
+
+    ///
+    /// Validators of a schema stored by value in a single buffer, the binder runs them with one loop
+    /// over the entries, each is a direct call of the validator's type operations
+    ///
+    class ValidatorTable {
+    public:
+        struct Entry {
+            const void *validator = nullptr;
+            void (*validate)(const void *validator, const void *entityValue) = nullptr;
+            std::ptrdiff_t offset = 0;
+            std::size_t fieldIndex = 0;
+
+            void run(const char *cfg) const {
+                validate(validator, cfg + offset);
             }
+        };
+
+        struct BoundValidator {
+            Validator validator;
+            std::ptrdiff_t offset = 0;
+            std::size_t fieldIndex = 0;
+        };
+
+        ValidatorTable() = default;
+
+        explicit ValidatorTable(std::vector<BoundValidator> validators);
+
+        ValidatorTable(ValidatorTable &&other) noexcept;
+
+        ValidatorTable &operator=(ValidatorTable &&other) noexcept;
+
+        ValidatorTable(const ValidatorTable &) = delete;
+
+        ValidatorTable &operator=(const ValidatorTable &) = delete;
+
+        ~ValidatorTable();
+
+        const Entry *begin() const {
+            return entries_.data();
+        }
+
+        const Entry *end() const {
+            return entries_.data() + entries_.size();
+        }
+
+        bool empty() const {
+            return entries_.empty();
         }
 
-        IConfigEntity &entity_;
-        T &entityValue_;
-        std::function<void(const T &)> validatingFunc_;
+    private:
+        void clear();
+
+    private:
+        std::vector<Entry> entries_;
+        std::vector<void (*)(void *)> destructors_;
+        void *storage_ = nullptr;
+        std::size_t storageAlignment_ = 0;
     };
 
-} //namespace tconf::detail
\ No newline at end of file
+} //namespace tconf::detail
@@ -19,6 +19,8 @@
 #include "tconf/tree/stream_position.h"
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace tconf {
 
@@ -29,19 +31,76 @@ namespace tconf {
         }
     };
 
+    ///
+    /// Error collected by ConfigReader::try_read() and the related methods instead of throwing ConfigError,
+    /// text() returns the same message as ConfigError::what()
+    ///
+    struct Diagnostic {
+        std::string message;
+        StreamPosition position;
+
+        std::string text() const {
+            return streamPositionToString(position) + message;
+        }
+    };
+
     class ConfigError : public Error {
     public:
         using Error::Error;
 
         ConfigError(const std::string &errorMsg, const StreamPosition &errorPosition = {})
-                : Error(streamPositionToString(errorPosition) + errorMsg) {
+                : Error(streamPositionToString(errorPosition) + errorMsg), position_{errorPosition} {
+        }
+
+        /// position of the error in the config, it's also written at the start of the message
+        const StreamPosition &position() const {
+            return position_;
+        }
+
+        Diagnostic diagnostic() const {
+            return {std::string{what()}.substr(streamPositionToString(position_).size()), position_};
         }
+
+    private:
+        StreamPosition position_;
     };
 
     class ValidationError : public Error {
         using Error::Error;
     };
 
+    ///
+    /// Errors of the config files read together by ConfigReader::read_many() or ConfigReader::read_files(),
+    /// the message lists each failed file with its error.
+    ///
+    class ConfigFilesError : public ConfigError {
+    public:
+        struct FileError {
+            std::string file;
+            std::string message;
+        };
+
+        explicit ConfigFilesError(std::vector<FileError> errors)
+                : ConfigError(makeMessage(errors)), errors_{std::move(errors)} {
+        }
+
+        /// the failed files in the order they were passed to the reader
+        const std::vector<FileError> &errors() const {
+            return errors_;
+        }
+
+    private:
+        static std::string makeMessage(const std::vector<FileError> &errors) {
+            auto message = std::string{"Couldn't read config files:"};
+            for (const auto &error: errors)
+                message += "\n" + error.file + ": " + error.message;
+            return message;
+        }
+
+    private:
+        std::vector<FileError> errors_;
+    };
+
 }  // namespace tconf
 
 #endif  // TCONF_ERRORS_H_
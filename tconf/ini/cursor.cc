@@ -0,0 +1,47 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "tconf/ini/cursor.h"
+#include <algorithm>
+
+namespace tconf::ini::detail {
+
+    Cursor::Cursor(std::string_view data, const StreamPosition &startPosition)
+            : data_(data), startPosition_(startPosition) {
+    }
+
+    void Cursor::skip(std::size_t size) {
+        read(size);
+    }
+
+    std::string_view Cursor::read(std::size_t size) {
+        size = std::min(size, data_.size() - pos_);
+        const auto result = data_.substr(pos_, size);
+        for (auto i = std::size_t{}; i < size; ++i)
+            if (result[i] == '\n') {
+                ++line_;
+                lineStart_ = pos_ + i + 1;
+            }
+        pos_ += size;
+        return result;
+    }
+
+    StreamPosition Cursor::position() const {
+        auto column = 0;
+        for (auto i = lineStart_; i < pos_; ++i)
+            column += data_[i] == '\t' ? 4 : 1;
+        return {*startPosition_.line + line_, *startPosition_.column + column};
+    }
+
+} //namespace tconf::ini::detail
@@ -0,0 +1,63 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "tconf/tree/stream_position.h"
+#include <cstddef>
+#include <string_view>
+
+namespace tconf::ini::detail {
+
+    ///
+    /// Reading position in a contiguous buffer. The line and the column of the position are counted
+    /// from the start position, a tab character takes 4 columns.
+    ///
+    class Cursor {
+    public:
+        explicit Cursor(std::string_view data, const StreamPosition &startPosition = StreamPosition{1, 1});
+
+        bool atEnd() const {
+            return pos_ == data_.size();
+        }
+
+        /// returns '\0' at the end of the buffer
+        char peek() const {
+            return atEnd() ? '\0' : data_[pos_];
+        }
+
+        void skip(std::size_t size = 1);
+
+        std::string_view read(std::size_t size = 1);
+
+        /// reads the characters until stopPred returns true for the next one or the buffer ends
+        template<typename TPred>
+        std::string_view readUntil(TPred stopPred) {
+            auto end = pos_;
+            while (end < data_.size() && !stopPred(data_[end]))
+                ++end;
+            return read(end - pos_);
+        }
+
+        StreamPosition position() const;
+
+    private:
+        std::string_view data_;
+        std::size_t pos_ = 0;
+        int line_ = 0;
+        std::size_t lineStart_ = 0;
+        StreamPosition startPosition_;
+    };
+
+} //namespace tconf::ini::detail
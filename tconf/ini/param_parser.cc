@@ -14,28 +14,26 @@
 //
 
 #include "tconf/ini/param_parser.h"
-#include "tconf/ini/stream.h"
+#include "tconf/ini/cursor.h"
 #include "tconf/ini/utils.h"
 #include "tconf/errors.h"
-#include "tconf/tree/tree.h"
-#include <sstream>
-#include <utility>
+#include <string>
 
 namespace tconf::ini::detail {
 
-    std::optional<std::string> readParam(
-            Stream &stream,
-            const std::string &wordSeparator,
-            const std::vector<std::string> &paramListValue,
-            const std::string &paramName) {
-        auto quotedParam = readQuotedString(stream);
+    std::optional<std::string_view> readParam(
+            Cursor &cursor,
+            std::string_view wordSeparator,
+            const std::vector<std::string_view> &paramListValue,
+            std::string_view paramName) {
+        auto quotedParam = readQuotedString(cursor);
         if (quotedParam)
             return *quotedParam;
         else {
-            auto result = readWord(stream, wordSeparator);
+            auto result = readWord(cursor, wordSeparator);
             if (result.empty()) {
-                if (stream.peek() == ",")
-                    throw ConfigError{"Parameter list '" + paramName + "' element is missing"};
+                if (cursor.peek() == ',')
+                    throw ConfigError{"Parameter list '" + std::string{paramName} + "' element is missing"};
                 if (paramListValue.empty())
                     return std::nullopt;
             }
@@ -43,45 +41,46 @@ namespace tconf::ini::detail {
         }
     }
 
-    std::optional<std::vector<std::string>> readParamList(const std::string &paramName, const std::string &paramValue) {
-        auto inputStream = std::stringstream{paramValue};
-        auto stream = Stream{inputStream};
-        skipWhitespace(stream, false);
-        if (stream.peek() != "[")
+    std::optional<std::vector<std::string_view>> readParamList(
+            std::string_view paramName,
+            std::string_view paramValue,
+            const StreamPosition &valuePosition) {
+        auto cursor = Cursor{paramValue, valuePosition};
+        skipWhitespace(cursor, false);
+        if (cursor.peek() != '[')
             return std::nullopt;
 
-        stream.skip(1);
-        skipWhitespace(stream);
-        auto paramValueList = std::vector<std::string>{};
-        while (!stream.atEnd()) {
-            auto param = readParam(stream, ",]", paramValueList, paramName);
+        cursor.skip(1);
+        skipWhitespace(cursor);
+        auto paramValueList = std::vector<std::string_view>{};
+        while (!cursor.atEnd()) {
+            auto param = readParam(cursor, ",]", paramValueList, paramName);
             if (param)
-                paramValueList.emplace_back(std::move(*param));
+                paramValueList.emplace_back(*param);
 
-            skipWhitespace(stream, true);
-            const auto endOfList = "]";
-            if (stream.peek() == ",") {
-                stream.skip(1);
-                skipWhitespace(stream, true);
-                if (stream.peek() == endOfList || stream.atEnd())
-                    throw ConfigError{"Parameter list '" + paramName + "' element is missing"};
-            } else if (stream.peek() == endOfList) {
-                stream.skip(1);
+            skipWhitespace(cursor, true);
+            const auto endOfList = ']';
+            if (cursor.peek() == ',') {
+                cursor.skip(1);
+                skipWhitespace(cursor, true);
+                if (cursor.peek() == endOfList || cursor.atEnd())
+                    throw ConfigError{"Parameter list '" + std::string{paramName} + "' element is missing"};
+            } else if (cursor.peek() == endOfList) {
+                cursor.skip(1);
                 return paramValueList;
             }
         }
-        throw ConfigError{"Wrong parameter list '" + paramName + "' format: missing ']' at the end"};
+        throw ConfigError{"Wrong parameter list '" + std::string{paramName} + "' format: missing ']' at the end"};
     }
 
-    std::string readParam(const std::string &paramValue) {
-        auto inputStream = std::stringstream{paramValue};
-        auto stream = Stream{inputStream};
-        skipWhitespace(stream, false);
-        auto quotedParam = detail::readQuotedString(stream);
+    std::string_view readParam(std::string_view paramValue, const StreamPosition &valuePosition) {
+        auto cursor = Cursor{paramValue, valuePosition};
+        skipWhitespace(cursor, false);
+        auto quotedParam = detail::readQuotedString(cursor);
         if (quotedParam)
             return *quotedParam;
         else
             return paramValue;
     }
 
-} //namespace tconf::ini::detail
\ No newline at end of file
+} //namespace tconf::ini::detail
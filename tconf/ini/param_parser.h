@@ -14,21 +14,27 @@
 //
 #pragma once
 
+#include "tconf/tree/stream_position.h"
 #include <optional>
-#include <string>
+#include <string_view>
 #include <vector>
 
 namespace tconf::ini::detail {
-    class Stream;
+    class Cursor;
 
-    std::optional<std::string> readParam(
-            Stream &stream,
-            const std::string &wordSeparator,
-            const std::vector<std::string> &paramListValue,
-            const std::string &paramName);
+    std::optional<std::string_view> readParam(
+            Cursor &cursor,
+            std::string_view wordSeparator,
+            const std::vector<std::string_view> &paramListValue,
+            std::string_view paramName);
 
-    std::optional<std::vector<std::string>> readParamList(const std::string &paramName, const std::string &paramValue);
+    /// the values of the returned list refer to the paramValue buffer,
+    /// valuePosition is the position of paramValue in the config, it's used in the error messages
+    std::optional<std::vector<std::string_view>> readParamList(
+            std::string_view paramName,
+            std::string_view paramValue,
+            const StreamPosition &valuePosition = StreamPosition{1, 1});
 
-    std::string readParam(const std::string &paramValue);
+    std::string_view readParam(std::string_view paramValue, const StreamPosition &valuePosition = StreamPosition{1, 1});
 
-} //namespace tconf::ini::detail
\ No newline at end of file
+} //namespace tconf::ini::detail
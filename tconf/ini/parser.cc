@@ -12,90 +12,90 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
-#include "tconf/ini/param_parser.h"
-#include "tconf/ini/inicpp.h"
 #include "tconf/ini/parser.h"
+#include "tconf/ini/cursor.h"
+#include "tconf/ini/param_parser.h"
+#include "tconf/ini/utils.h"
 #include "tconf/errors.h"
 #include "tconf/tree/tree.h"
-#include "tconf/detail/string_utils.h"
+#include <charconv>
 #include <iterator>
-#include <map>
-#include <regex>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace tconf::ini {
 
     namespace {
-        const auto fakeRootSectionId = std::string{"71cd27eb-7f27-4b61-a2ff-a64c89b275a7"};
-
-        bool isUnsignedInt(const std::string &str) {
-            return std::all_of(str.begin(), str.end(), ::isdigit);
+        bool isBlank(char ch) {
+            return ch == ' ' || ch == '\t' || ch == '\r';
         }
 
-        bool hasRootSection(std::istream &stream) {
-            auto pos = stream.tellg();
-            auto firstWord = std::string{};
-            stream >> firstWord;
-            stream.seekg(pos);
-            return firstWord.front() == '[';
+        std::string_view trim(std::string_view str) {
+            while (!str.empty() && isBlank(str.front()))
+                str.remove_prefix(1);
+            while (!str.empty() && isBlank(str.back()))
+                str.remove_suffix(1);
+            return str;
         }
 
-        std::string getStreamContent(std::istream &stream) {
-            stream >> std::noskipws;
-            return {std::istream_iterator<char>{stream}, std::istream_iterator<char>{}};
-        }
-
-        void parseSection(const ::ini::IniSection &section, tconf::TreeNode &node) {
-            for (const auto &[key, value]: section) {
-                auto paramList = detail::readParamList(key, value.as<std::string>());
-                if (paramList)
-                    node.asItem().addParamList(key, *paramList);
-                else
-                    node.asItem().addParam(key, detail::readParam(value.as<std::string>()));
-            }
+        bool isIndex(std::string_view str) {
+            if (str.empty())
+                return false;
+            for (auto ch: str)
+                if (ch < '0' || ch > '9')
+                    return false;
+            return true;
         }
 
-        std::string beforeLast(const std::string &str, const std::string &delim) {
-            auto pos = str.rfind(delim);
-            if (pos == std::string::npos)
-                return str;
-            return str.substr(0, pos);
+        bool isCommentChar(char ch) {
+            return ch == '#' || ch == ';';
         }
 
-        tconf::ConfigError makeConfigError(const std::exception &e, bool hasFakeRootSection) {
-            auto message = std::string{e.what()};
-            auto regex = std::regex{R"(l\.(\d+): (.*))"};
-            auto match = std::smatch{};
-            if (std::regex_search(message, match, regex)) {
-                auto line = std::stoi(match[1]);
-                if (hasFakeRootSection)
-                    line--;
-                auto error = match[2].str();
-                if (!error.empty())
-                    error[0] = static_cast<char>(std::toupper(error[0]));
-
-                return {error, {line, {}}};
+        ///
+        /// Erases the comment that starts with an unescaped '#' or ';' anywhere in the line.
+        /// The escaped comment characters lose their backslash, such line is copied into the buffer.
+        ///
+        std::string_view eraseComment(std::string_view line, std::string &buffer) {
+            auto hasEscapedChars = false;
+            for (auto i = std::size_t{}; i < line.size(); ++i) {
+                if (!isCommentChar(line[i]))
+                    continue;
+                if (i == 0 || line[i - 1] != '\\') {
+                    line = line.substr(0, i);
+                    break;
+                }
+                hasEscapedChars = true;
             }
-            return {e.what()};
+            if (!hasEscapedChars)
+                return line;
+
+            buffer.clear();
+            for (auto i = std::size_t{}; i < line.size(); ++i)
+                if (line[i] != '\\' || i + 1 == line.size() || !isCommentChar(line[i + 1]))
+                    buffer += line[i];
+            return buffer;
         }
     } //namespace
 
     class Parser::Impl {
     public:
-        void parseSections(const ::ini::IniFile &ini, tconf::TreeNode &node);
+        void parse(std::string_view input, TreeNode &tree);
+
+    private:
+        TreeNode &openSection(std::string_view line, const StreamPosition &pos, TreeNode &tree);
 
-        void createSectionNodes(const ::ini::IniFile &ini, tconf::TreeNode &node);
+        TreeNode &addListElement(TreeNode &list, std::string_view index, const StreamPosition &pos);
 
-        void addSectionTreeNode(
-                const std::string &sectionName,
-                const std::function<tconf::TreeNode *(tconf::TreeNode &)> &nodeMaker);
+        void readParam(std::string_view line, const StreamPosition &pos, TreeNode &node);
 
     private:
-        std::map<std::string, int> sectionArrays_;
-        std::map<std::string, tconf::TreeNode *> sections_;
-        tconf::TreeNode *currentNode_ = nullptr;
+        /// the nodes of the opened sections by the full dotted path, so the section can be continued later
+        std::unordered_map<std::string, TreeNode *> sections_;
+        std::vector<std::string_view> sectionNameParts_;
+        std::string sectionPath_;
+        std::string lineBuffer_;
     };
 
     Parser::Parser()
@@ -105,86 +105,127 @@ namespace tconf::ini {
     Parser::~Parser() = default;
 
     TreeNode Parser::parse(std::istream &stream) {
-        auto fixedInputStream = std::unique_ptr<std::istream>{};
-        auto &input = [&]() -> decltype(auto) {
-            if (hasRootSection(stream))
-                return stream;
-            auto inputStr = "[" + fakeRootSectionId + "]\n" + getStreamContent(stream);
-            fixedInputStream = std::make_unique<std::istringstream>(inputStr);
-            return *fixedInputStream;
-        }();
-
-        auto ini = [&] {
-            try {
-                return ::ini::IniFile{input};
-            }
-            catch (const std::exception &e) {
-                throw makeConfigError(e, fixedInputStream != nullptr);
-            }
-        }();
+        return parseSource(std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}});
+    }
 
+    TreeNode Parser::parse(const char *data, std::size_t size) {
+        // the buffer is copied once into the document, so the names and values are stored as views into it
+        return parseSource(std::string{data, size});
+    }
+
+    TreeNode Parser::parseSource(std::string source) {
         auto tree = tconf::makeTreeRoot();
-        impl_->createSectionNodes(ini, tree);
-        impl_->parseSections(ini, tree);
+        const auto &input = tree.adoptSource(std::move(source));
+        impl_->parse(input, tree);
         return tree;
     }
 
-    void Parser::Impl::parseSections(const ::ini::IniFile &ini, tconf::TreeNode &node) {
-        for (const auto &[sectionName, section]: ini)
-            if (sectionName == fakeRootSectionId)
-                parseSection(section, node);
-            else if (!sectionArrays_.count(sectionName))
-                parseSection(section, *sections_.at(sectionName));
+    void Parser::Impl::parse(std::string_view input, TreeNode &tree) {
+        sections_.clear();
+        auto *node = &tree;
+        auto cursor = detail::Cursor{input};
+        while (!cursor.atEnd()) {
+            detail::skipWhitespace(cursor, false);
+            const auto linePos = cursor.position();
+            const auto line = trim(eraseComment(
+                    cursor.readUntil(
+                            [](char ch) {
+                                return ch == '\n';
+                            }),
+                    lineBuffer_));
+            cursor.skip();
+
+            if (line.empty())
+                continue;
+            if (line.front() == '[')
+                node = &openSection(line, linePos, tree);
+            else
+                readParam(line, linePos, *node);
+        }
     }
 
-    void Parser::Impl::createSectionNodes(const ::ini::IniFile &ini, tconf::TreeNode &node) {
-        for (const auto &[sectionName, section]: ini) {
-            currentNode_ = &node;
-            if (sectionName == fakeRootSectionId)
-                continue;
-            auto newSectionName = std::string{};
-            auto sectionParts = sfun::split(sectionName, ".");
-            for (auto sectionPartIt = sectionParts.begin(); sectionPartIt != sectionParts.end(); ++sectionPartIt) {
-                auto sectionPart = std::string{*sectionPartIt};
-                newSectionName += sectionPart;
-                if (std::next(sectionPartIt) != sectionParts.end() &&
-                    isUnsignedInt(std::string{*std::next(sectionPartIt)})) {
-                    addSectionTreeNode(
-                            newSectionName,
-                            [&](auto &parentNode) {
-                                sectionArrays_[newSectionName] = 0;
-                                return &parentNode.asItem().addNodeList(sectionPart);
-                            });
-                } else if (isUnsignedInt(sectionPart)) {
-                    addSectionTreeNode(
-                            newSectionName,
-                            [&](auto &parentNode) {
-                                auto listSectionName = beforeLast(newSectionName, ".");
-                                auto sectionArrayIndex = std::stoi(sectionPart);
-                                if (sectionArrayIndex != sectionArrays_[listSectionName]) {
-                                    if (sectionArrayIndex != ++sectionArrays_[listSectionName])
-                                        throw tconf::ConfigError{"Section array index mismatch"};
-                                }
-                                return &parentNode.asList().addNode();
-                            });
-                } else {
-                    addSectionTreeNode(
-                            newSectionName,
-                            [&](auto &parentNode) {
-                                return &parentNode.asItem().addNode(sectionPart);
-                            });
-                }
-                newSectionName += ".";
+    TreeNode &Parser::Impl::openSection(std::string_view line, const StreamPosition &pos, TreeNode &tree) {
+        const auto nameEnd = line.find(']');
+        if (nameEnd == std::string_view::npos)
+            throw ConfigError{"Section isn't closed", pos};
+        const auto name = trim(line.substr(1, nameEnd - 1));
+        if (name.empty())
+            throw ConfigError{"Section name is empty", pos};
+
+        sectionNameParts_.clear();
+        for (auto partPos = std::size_t{};;) {
+            const auto partEnd = name.find('.', partPos);
+            const auto part = trim(name.substr(partPos, partEnd - partPos));
+            if (part.empty())
+                throw ConfigError{"Section name '" + std::string{name} + "' contains an empty part", pos};
+            sectionNameParts_.emplace_back(part);
+            if (partEnd == std::string_view::npos)
+                break;
+            partPos = partEnd + 1;
+        }
+
+        auto *node = &tree;
+        sectionPath_.clear();
+        for (auto i = std::size_t{}; i < sectionNameParts_.size(); ++i) {
+            const auto part = sectionNameParts_[i];
+            if (i)
+                sectionPath_ += '.';
+            sectionPath_ += part;
+
+            const auto isNodeList = i + 1 < sectionNameParts_.size() && isIndex(sectionNameParts_[i + 1]);
+            auto sectionIt = sections_.find(sectionPath_);
+            if (sectionIt != sections_.end())
+                node = sectionIt->second;
+            else {
+                if (node->isList())
+                    node = &addListElement(*node, part, pos);
+                else if (isNodeList)
+                    node = &node->asItem().addNodeList(part, pos);
+                else
+                    node = &node->asItem().addNode(part, pos);
+                sections_.emplace(sectionPath_, node);
             }
+
+            if (node->isList() && !isNodeList)
+                throw ConfigError{"Section '" + sectionPath_ + "' is a node list, its elements must be indexed", pos};
+            if (!node->isList() && isNodeList)
+                throw ConfigError{"Section '" + sectionPath_ + "' isn't a node list", pos};
+        }
+        return *node;
+    }
+
+    TreeNode &Parser::Impl::addListElement(TreeNode &list, std::string_view index, const StreamPosition &pos) {
+        const auto expectedIndex = list.asList().count();
+        auto value = -1;
+        std::from_chars(index.data(), index.data() + index.size(), value);
+        if (value != expectedIndex) {
+            const auto listPath = sectionPath_.substr(0, sectionPath_.size() - index.size() - 1);
+            throw ConfigError{
+                    "Section array '" + listPath + "' index mismatch: expected " + std::to_string(expectedIndex) +
+                    ", but got " + std::string{index}, pos};
         }
+        return list.asList().addNode(pos);
     }
 
-    void Parser::Impl::addSectionTreeNode(
-            const std::string &sectionName,
-            const std::function<tconf::TreeNode *(tconf::TreeNode &)> &nodeMaker) {
-        if (!sections_.count(sectionName))
-            sections_[sectionName] = nodeMaker(*currentNode_);
-        currentNode_ = sections_[sectionName];
+    void Parser::Impl::readParam(std::string_view line, const StreamPosition &pos, TreeNode &node) {
+        const auto separatorPos = line.find('=');
+        if (separatorPos == std::string_view::npos)
+            throw ConfigError{"Parameter '" + std::string{line} + "' must be followed by '=' and a value", pos};
+        const auto name = trim(line.substr(0, separatorPos));
+        if (name.empty())
+            throw ConfigError{"Parameter name is empty", pos};
+
+        auto valueCursor = detail::Cursor{line, pos};
+        valueCursor.skip(separatorPos + 1);
+        detail::skipWhitespace(valueCursor, false);
+        const auto valuePos = valueCursor.position();
+        const auto value = trim(line.substr(separatorPos + 1));
+
+        auto paramList = detail::readParamList(name, value, valuePos);
+        if (paramList)
+            node.asItem().addParamList(name, *paramList, pos);
+        else
+            node.asItem().addParam(name, detail::readParam(value, valuePos), pos);
     }
 
 } //namespace tconf::ini
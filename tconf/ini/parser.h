@@ -17,13 +17,17 @@
 #define TCONF_INI_INI_PARSER_H_
 
 #include "tconf/tree/iparser.h"
-#include <functional>
-#include <map>
+#include <cstddef>
 #include <memory>
 #include <string>
 
 namespace tconf::ini {
 
+    ///
+    /// Reads an INI config in a single pass over the buffer and builds the tree directly.
+    /// The params before the first section belong to the root node, dotted section names
+    /// describe the nested nodes and the indices in them describe the node list elements.
+    ///
     class Parser : public IParser {
         class Impl;
 
@@ -32,6 +36,8 @@ namespace tconf::ini {
 
         TreeNode parse(std::istream &stream) override;
 
+        TreeNode parse(const char *data, std::size_t size) override;
+
         ~Parser() override;
 
         Parser(const Parser &) = delete;
@@ -42,6 +48,9 @@ namespace tconf::ini {
 
         Parser &operator=(Parser &&) = delete;
 
+    private:
+        TreeNode parseSource(std::string source);
+
     private:
         std::unique_ptr<Impl> impl_;
     };
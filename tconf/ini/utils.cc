@@ -13,60 +13,50 @@
 // limitations under the License.
 //
 #include "utils.h"
-#include "stream.h"
+#include "cursor.h"
 #include "tconf/errors.h"
+#include <cctype>
 
 namespace tconf::ini::detail {
 
-    void skipWhitespace(Stream &stream, bool withNewLine) {
-        while (!stream.atEnd()) {
-            auto nextChar = stream.peek().front();
-            if (!withNewLine && nextChar == '\n')
-                return;
-
-            if (std::isspace(nextChar))
-                stream.skip(1);
-            else
-                return;
+    namespace {
+        bool isSpace(char ch) {
+            return std::isspace(static_cast<unsigned char>(ch));
         }
-    }
+    } //namespace
 
-    std::string readUntil(Stream &stream, std::function<bool(char)> stopPred) {
-        auto result = std::string{};
-        while (!stream.atEnd()) {
-            if (stopPred(stream.peek().front()))
-                return result;
-            result += stream.read();
-        }
-        return result;
+    void skipWhitespace(Cursor &cursor, bool withNewLine) {
+        cursor.readUntil(
+                [withNewLine](char ch) {
+                    return (!withNewLine && ch == '\n') || !isSpace(ch);
+                });
     }
 
-    std::string readWord(Stream &stream, const std::string &stopChars) {
-        return readUntil(
-                stream,
-                [&stopChars](char ch) {
-                    return std::isspace(ch) || stopChars.find(ch) != std::string::npos;
+    std::string_view readWord(Cursor &cursor, std::string_view stopChars) {
+        return cursor.readUntil(
+                [stopChars](char ch) {
+                    return isSpace(ch) || stopChars.find(ch) != std::string_view::npos;
                 });
     }
 
-    std::optional<std::string> readQuotedString(Stream &stream) {
-        if (stream.atEnd())
+    std::optional<std::string_view> readQuotedString(Cursor &cursor) {
+        if (cursor.atEnd())
             return {};
 
-        auto quotationMark = stream.peek().front();
+        auto quotationMark = cursor.peek();
         if (quotationMark != '\'' && quotationMark != '"')
             return {};
-        auto pos = stream.position();
-        stream.skip(1);
+        auto pos = cursor.position();
+        cursor.skip(1);
 
-        auto result = std::string{};
-        while (!stream.atEnd()) {
-            auto ch = stream.read().front();
-            if (ch == quotationMark)
-                return result;
-            result += ch;
-        }
-        throw ConfigError{"String isn't closed", pos};
+        auto result = cursor.readUntil(
+                [quotationMark](char ch) {
+                    return ch == quotationMark;
+                });
+        if (cursor.atEnd())
+            throw ConfigError{"String isn't closed", pos};
+        cursor.skip(1);
+        return result;
     }
 
 } //namespace tconf::ini::detail
@@ -14,19 +14,16 @@
 //
 #pragma once
 
-#include <functional>
 #include <optional>
-#include <string>
+#include <string_view>
 
 namespace tconf::ini::detail {
-    class Stream;
+    class Cursor;
 
-    void skipWhitespace(Stream &stream, bool withNewLine = true);
+    void skipWhitespace(Cursor &cursor, bool withNewLine = true);
 
-    std::string readUntil(Stream &stream, std::function<bool(char)> stopPred);
+    std::string_view readWord(Cursor &cursor, std::string_view stopChars = {});
 
-    std::string readWord(Stream &stream, const std::string &stopChars = {});
-
-    std::optional<std::string> readQuotedString(Stream &stream);
+    std::optional<std::string_view> readQuotedString(Cursor &cursor);
 
 } //namespace tconf::ini::detail
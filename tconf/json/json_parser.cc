@@ -15,63 +15,225 @@
 
 #include "json_parser.h"
 #include "tconf/errors.h"
+#include "tconf/tree/tree_builder.h"
 #include "nlohmann/json.hpp"
-#include <regex>
+#include <cctype>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace tconf {
 
     namespace {
-        void parseJson(const nlohmann::json &json, tconf::TreeNode &node) {
-            for (auto &[key, value]: json.items()) {
-                if (value.is_object()) {
-                    auto &newNode = node.asItem().addNode(key);
-                    parseJson(value, newNode);
-                } else if (value.is_array()) {
-                    if (!value.empty() && value.front().is_object()) {
-                        auto &newNode = node.asItem().addNodeList(key);
-                        for (auto &item: value)
-                            parseJson(item, newNode.asList().addNode());
-                    } else {
-                        auto valuesList = std::vector<std::string>{};
-                        for (auto &item: value)
-                            valuesList.emplace_back(item.get<std::string>());
-
-                        node.asItem().addParamList(key, valuesList);
-                    }
-                } else
-                    node.asItem().addParam(key, value.get<std::string>());
+        ConfigError makeConfigError(const std::exception &e);
+
+        ///
+        /// nlohmann::json SAX handler forwarding the parsed document to ITreeVisitor.
+        /// An array is held until its first element shows whether it's a node list or a param list.
+        ///
+        class JsonEventHandler {
+        public:
+            using json = nlohmann::json;
+
+            explicit JsonEventHandler(ITreeVisitor &visitor)
+                    : visitor_{visitor} {
+            }
+
+            bool null() {
+                return unsupportedValue("null");
+            }
+
+            bool boolean(bool value) {
+                return scalar(TreeValue{value}, "boolean");
+            }
+
+            bool number_integer(json::number_integer_t value) {
+                return scalar(TreeValue{static_cast<std::int64_t>(value)}, "number");
+            }
+
+            bool number_unsigned(json::number_unsigned_t value) {
+                return scalar(TreeValue{static_cast<std::uint64_t>(value)}, "number");
+            }
+
+            bool number_float(json::number_float_t value, const json::string_t &) {
+                return scalar(TreeValue{static_cast<double>(value)}, "number");
+            }
+
+            bool binary(json::binary_t &) {
+                return unsupportedValue("binary");
+            }
+
+            bool string(json::string_t &value) {
+                return scalar(TreeValue{value}, "string");
+            }
+
+            bool start_object(std::size_t) {
+                if (stack_.empty()) {
+                    stack_.push_back({ScopeType::Object, {}});
+                    return true;
+                }
+                switch (stack_.back().type) {
+                    case ScopeType::Object:
+                        visitor_.beginNode(key_, {});
+                        break;
+                    case ScopeType::Array:
+                        stack_.back().type = ScopeType::NodeList;
+                        visitor_.beginNodeList(stack_.back().name, {});
+                        [[fallthrough]];
+                    case ScopeType::NodeList:
+                        visitor_.beginListElement({});
+                        break;
+                    case ScopeType::ParamList:
+                        throw ConfigError{"Parameter list '" + stack_.back().name + "': type must be string, but is object"};
+                }
+                stack_.push_back({ScopeType::Object, {}});
+                return true;
+            }
+
+            bool key(json::string_t &key) {
+                key_ = key;
+                return true;
+            }
+
+            bool end_object() {
+                stack_.pop_back();
+                if (!stack_.empty())
+                    visitor_.endNode();
+                return true;
             }
+
+            bool start_array(std::size_t) {
+                if (stack_.empty())
+                    throw ConfigError{"Root node must be an object"};
+                if (stack_.back().type != ScopeType::Object)
+                    throw ConfigError{"List '" + stack_.back().name + "': nested arrays aren't supported"};
+
+                stack_.push_back({ScopeType::Array, key_});
+                values_.clear();
+                strings_.clear();
+                return true;
+            }
+
+            bool end_array() {
+                auto &scope = stack_.back();
+                if (scope.type == ScopeType::NodeList)
+                    visitor_.endNode();
+                else
+                    visitor_.paramList(scope.name, {values_.data(), values_.size()}, {});
+                stack_.pop_back();
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &e) {
+                throw makeConfigError(e);
+            }
+
+        private:
+            enum class ScopeType {
+                Object,
+                Array,
+                NodeList,
+                ParamList
+            };
+
+            struct Scope {
+                ScopeType type;
+                std::string name;
+            };
+
+            bool scalar(const TreeValue &value, const char *typeName) {
+                if (stack_.empty())
+                    throw ConfigError{"Root node must be an object"};
+
+                switch (stack_.back().type) {
+                    case ScopeType::Object:
+                        visitor_.param(key_, value, {});
+                        break;
+                    case ScopeType::Array:
+                        stack_.back().type = ScopeType::ParamList;
+                        [[fallthrough]];
+                    case ScopeType::ParamList:
+                        if (value.isString()) {
+                            // the parser reuses the string's buffer, so the list keeps a copy
+                            const auto &str = strings_.emplace_back(value.asString());
+                            values_.emplace_back(str);
+                        } else
+                            values_.emplace_back(value);
+                        break;
+                    case ScopeType::NodeList:
+                        throw ConfigError{
+                                "Node list '" + stack_.back().name + "': type must be object, but is " + typeName};
+                }
+                return true;
+            }
+
+            bool unsupportedValue(const char *typeName) {
+                if (stack_.empty())
+                    throw ConfigError{"Root node must be an object"};
+
+                const auto &name = stack_.back().type == ScopeType::Object ? key_ : stack_.back().name;
+                throw ConfigError{"Parameter '" + name + "': " + typeName + " values aren't supported"};
+            }
+
+        private:
+            ITreeVisitor &visitor_;
+            std::vector<Scope> stack_;
+            std::string key_;
+            std::vector<TreeValue> values_;
+            std::deque<std::string> strings_;
+        };
+
+        /// Reads the decimal number at the position and moves past it, nullopt is returned if there's none
+        std::optional<int> readNumber(std::string_view text, std::size_t &pos) {
+            const auto start = pos;
+            auto value = 0;
+            while (pos < text.size() && pos - start < 9 && std::isdigit(static_cast<unsigned char>(text[pos])))
+                value = value * 10 + (text[pos++] - '0');
+            if (pos == start)
+                return std::nullopt;
+            return value;
         }
 
         ConfigError makeConfigError(const std::exception &e) {
-            auto message = std::string{e.what()};
-            auto regex = std::regex{R"(.*\line (\d+), column (\d+): (.*))"};
-            auto match = std::smatch{};
-            if (std::regex_search(message, match, regex)) {
-                auto line = std::stoi(match[1]);
-                auto column = std::stoi(match[2]);
-                auto error = match[3].str();
+            // the position isn't matched with std::regex, its recursive matching overflows the stack
+            // on the long input quoted in the message, e.g. a string cut off by the end of a truncated file
+            const auto message = std::string_view{e.what()};
+            constexpr auto linePrefix = std::string_view{"line "};
+            for (auto pos = message.find(linePrefix); pos != std::string_view::npos;
+                 pos = message.find(linePrefix, pos + 1)) {
+                auto numberPos = pos + linePrefix.size();
+                const auto line = readNumber(message, numberPos);
+                if (!line || message.substr(numberPos, 9) != ", column ")
+                    continue;
+                numberPos += 9;
+                const auto column = readNumber(message, numberPos);
+                if (!column || message.substr(numberPos, 2) != ": ")
+                    continue;
+                const auto errorPos = numberPos + 2;
+                auto error = std::string{message.substr(errorPos, message.find('\n', errorPos) - errorPos)};
                 if (!error.empty())
-                    error[0] = static_cast<char>(std::toupper(error[0]));
+                    error[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(error[0])));
 
-                return {error, tconf::StreamPosition{line, column}};
+                return {error, tconf::StreamPosition{*line, *column}};
             }
             return {e.what()};
         }
     } //namespace
 
     TreeNode JsonParser::parse(std::istream &stream) {
-        auto json = nlohmann::json{};
-        try {
-            stream >> json;
-        }
-        catch (const std::exception &e) {
-            throw makeConfigError(e);
-        }
-
         auto tree = tconf::makeTreeRoot();
-        parseJson(json, tree);
+        auto builder = TreeBuilder{tree};
+        auto handler = JsonEventHandler{builder};
+        nlohmann::json::sax_parse(stream, &handler, nlohmann::json::input_format_t::json, false);
         return tree;
     }
 
-} // namespace tconf
\ No newline at end of file
+    void JsonParser::visit(const char *data, std::size_t size, ITreeVisitor &visitor) {
+        auto handler = JsonEventHandler{visitor};
+        nlohmann::json::sax_parse(data, data + size, &handler, nlohmann::json::input_format_t::json, false);
+    }
+
+} // namespace tconf
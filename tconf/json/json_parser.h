@@ -24,7 +24,10 @@
 namespace tconf {
     class JsonParser : public IParser {
     public:
+        using IParser::parse;
+
         TreeNode parse(std::istream &stream) override;
+        void visit(const char *data, std::size_t size, ITreeVisitor &visitor) override;
     };
 
 } //namespace tconf
@@ -0,0 +1,228 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_LAZY_H_
+#define TCONF_LAZY_H_
+
+#include "tconf/detail/config_reader_ptr.h"
+#include "tconf/detail/loading_context.h"
+#include "tconf/detail/loading_error.h"
+#include "tconf/detail/schema.h"
+#include "tconf/detail/string_converter.h"
+#include "tconf/errors.h"
+#include "tconf/tree/stream_position.h"
+#include "tconf/tree/tree.h"
+#include "tconf/tree/tree_value.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace tconf {
+
+    class Config;
+
+    namespace detail {
+        template<typename TCfg>
+        class LazyNode;
+
+        template<typename T>
+        class LazyParam;
+    } //namespace detail
+
+    ///
+    /// Config node that is loaded on the first access. Reading the config only copies the node's subtree
+    /// and checks that the required fields of its config and of the nested nodes are present,
+    /// the values are converted and validated by get() which reports the errors with tconf::ConfigError.
+    /// The copies of a lazy node share the loaded config, the loading is thread safe.
+    /// A node that is missing from the config file gives a default constructed config.
+    ///
+    template<typename TCfg>
+    class lazy {
+        static_assert(std::is_base_of_v<Config, TCfg>, "TConfig must be a subclass of tconf::Config.");
+
+    public:
+        using value_type = TCfg;
+
+        lazy() = default;
+
+        const TCfg &get() const {
+            if (!state_)
+                return defaultValue();
+            std::call_once(state_->loadedFlag, [this] { load(*state_); });
+            return *state_->cfg;
+        }
+
+        const TCfg &operator*() const {
+            return get();
+        }
+
+        const TCfg *operator->() const {
+            return &get();
+        }
+
+        /// returns true if the config has been loaded or doesn't need loading
+        bool is_loaded() const {
+            return !state_ || state_->isLoaded.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct State {
+            State(std::shared_ptr<const TreeNode> node, const std::string &name, const detail::LoadingContext &ctx)
+                    : node{std::move(node)}, name{name}, ctx{ctx} {
+                // the config is loaded after the read has finished, so its errors are thrown on access,
+                // and it's loaded with the default memory resource, as the lazy nodes can be loaded concurrently
+                this->ctx.errors = nullptr;
+                this->ctx.memoryResource = nullptr;
+            }
+
+            std::once_flag loadedFlag;
+            std::atomic<bool> isLoaded = false;
+            std::optional<TCfg> cfg;
+            std::shared_ptr<const TreeNode> node;
+            /// the name is owned by the field's schema which is never destroyed
+            const std::string &name;
+            detail::LoadingContext ctx;
+        };
+
+        static void load(State &state) {
+            auto cfg = TCfg{detail::ConfigReaderPtr{}};
+            try {
+                detail::schemaOf<TCfg>(state.ctx.nameFormat).load(&cfg, *state.node, state.ctx);
+            }
+            catch (const detail::LoadingError &e) {
+                throw ConfigError{"Node '" + state.name + "': " + e.what(), state.node->position()};
+            }
+            state.cfg.emplace(std::move(cfg));
+            state.isLoaded.store(true, std::memory_order_release);
+        }
+
+        static const TCfg &defaultValue() {
+            static const auto cfg = TCfg{detail::ConfigReaderPtr{}};
+            return cfg;
+        }
+
+    private:
+        std::shared_ptr<State> state_;
+
+        friend class detail::LazyNode<lazy<TCfg>>;
+    };
+
+    ///
+    /// Config parameter that is converted on the first access, it's worth using for the types with
+    /// an expensive conversion that aren't needed by every run. Reading the config only copies
+    /// the parameter's value, get() converts it and reports the errors with tconf::ConfigError.
+    /// The copies share the converted value, the conversion is thread safe.
+    ///
+    template<typename T>
+    class lazy_param {
+    public:
+        using value_type = T;
+
+        lazy_param() = default;
+
+        /// the default value of an optional parameter
+        lazy_param(T value)
+                : value_{std::move(value)} {
+        }
+
+        const T &get() const {
+            if (!state_)
+                return value_;
+            std::call_once(state_->convertedFlag, [this] { convert(*state_); });
+            return *state_->value;
+        }
+
+        const T &operator*() const {
+            return get();
+        }
+
+        const T *operator->() const {
+            return &get();
+        }
+
+        /// returns true if the value has been converted or doesn't need the conversion
+        bool is_loaded() const {
+            return !state_ || state_->isConverted.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct State {
+            State(const std::string &name, const TreeValue &paramValue, const StreamPosition &position)
+                    : text{paramValue.isString() ? std::string{paramValue.asString()} : std::string{}},
+                      treeValue{paramValue.isString() ? TreeValue{text} : paramValue}, position{position}, name{name} {
+            }
+
+            std::once_flag convertedFlag;
+            std::atomic<bool> isConverted = false;
+            std::optional<T> value;
+            std::string text;
+            TreeValue treeValue;
+            StreamPosition position;
+            /// the name is owned by the field's schema which is never destroyed
+            const std::string &name;
+        };
+
+        static void convert(State &state) {
+            auto result = detail::convertFromValue<T>(state.treeValue);
+            if (auto error = std::get_if<detail::StringConversionError>(&result))
+                throw ConfigError{
+                        "Couldn't set parameter '" + state.name + "' value from '" + state.treeValue.text() + "'" +
+                                (!error->message.empty() ? ": " + error->message : ""),
+                        state.position};
+            state.value.emplace(std::move(std::get<T>(result)));
+            state.isConverted.store(true, std::memory_order_release);
+        }
+
+    private:
+        T value_{};
+        std::shared_ptr<State> state_;
+
+        friend class detail::LazyParam<lazy_param<T>>;
+    };
+
+    namespace detail {
+
+        template<typename T>
+        struct is_lazy : std::false_type {
+        };
+
+        template<typename TCfg>
+        struct is_lazy<lazy<TCfg>> : std::true_type {
+        };
+
+        template<typename T>
+        inline constexpr auto is_lazy_v = is_lazy<T>::value;
+
+        template<typename T>
+        struct is_lazy_param : std::false_type {
+        };
+
+        template<typename T>
+        struct is_lazy_param<lazy_param<T>> : std::true_type {
+        };
+
+        template<typename T>
+        inline constexpr auto is_lazy_param_v = is_lazy_param<T>::value;
+
+    } //namespace detail
+
+} //namespace tconf
+
+#endif // TCONF_LAZY_H_
@@ -0,0 +1,105 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef TCONF_READ_RESULT_H_
+#define TCONF_READ_RESULT_H_
+
+#include "tconf/errors.h"
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tconf {
+
+    ///
+    /// Result of ConfigReader::try_read() and the related methods: the config if it was read without errors,
+    /// otherwise all the errors found in the config file in the order they were reported
+    ///
+    template<typename TCfg>
+    class ReadResult {
+    public:
+        explicit ReadResult(TCfg cfg)
+                : cfg_{std::move(cfg)} {
+        }
+
+        explicit ReadResult(std::vector<Diagnostic> errors)
+                : errors_{std::move(errors)} {
+        }
+
+        bool has_value() const {
+            return cfg_.has_value();
+        }
+
+        explicit operator bool() const {
+            return has_value();
+        }
+
+        /// throws ConfigError with the messages of all the errors if the config wasn't read
+        const TCfg &value() const & {
+            checkValue();
+            return *cfg_;
+        }
+
+        TCfg &value() & {
+            checkValue();
+            return *cfg_;
+        }
+
+        TCfg &&value() && {
+            checkValue();
+            return std::move(*cfg_);
+        }
+
+        const TCfg &operator*() const & {
+            return *cfg_;
+        }
+
+        TCfg &operator*() & {
+            return *cfg_;
+        }
+
+        const TCfg *operator->() const {
+            return &*cfg_;
+        }
+
+        TCfg *operator->() {
+            return &*cfg_;
+        }
+
+        const std::vector<Diagnostic> &errors() const {
+            return errors_;
+        }
+
+    private:
+        void checkValue() const {
+            if (cfg_)
+                return;
+            auto message = std::string{};
+            for (const auto &error: errors_) {
+                if (!message.empty())
+                    message += '\n';
+                message += error.text();
+            }
+            throw ConfigError{message};
+        }
+
+    private:
+        std::optional<TCfg> cfg_;
+        std::vector<Diagnostic> errors_;
+    };
+
+}  // namespace tconf
+
+#endif  // TCONF_READ_RESULT_H_
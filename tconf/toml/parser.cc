@@ -16,8 +16,12 @@
 #include <toml.hpp>
 #include "tconf/toml/parser.h"
 #include <tconf/errors.h>
+#include "tconf/tree/tree_builder.h"
+#include <cstdint>
+#include <deque>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tconf::toml {
@@ -33,46 +37,78 @@ namespace tconf::toml {
             return stream.str();
         }
 
-        void parseToml(const ::toml::value &toml, TreeNode &node) {
+        /// values of date and time types are passed as strings, their text is stored in the dateTimeText
+        TreeValue treeValue(const ::toml::value &val, std::string &dateTimeText) {
+            if (val.is_string())
+                return TreeValue{val.as_string().str};
+            if (val.is_boolean())
+                return TreeValue{static_cast<bool>(val.as_boolean())};
+            if (val.is_integer())
+                return TreeValue{static_cast<std::int64_t>(val.as_integer())};
+            if (val.is_floating())
+                return TreeValue{static_cast<double>(val.as_floating())};
+
+            dateTimeText = str(val);
+            return TreeValue{dateTimeText};
+        }
+
+        void visitToml(const ::toml::value &toml, ITreeVisitor &visitor) {
             for (auto &[key, value]: toml.as_table()) {
                 if (value.is_table()) {
-                    auto &newNode = node.asItem().addNode(key);
-                    parseToml(value, newNode);
+                    visitor.beginNode(key, {});
+                    visitToml(value, visitor);
+                    visitor.endNode();
                 } else if (value.is_array()) {
                     if (!value.as_array().empty() && value.as_array().front().is_table()) {
-                        auto &newNode = node.asItem().addNodeList(key);;
-                        for (auto &item: value.as_array())
-                            parseToml(item, newNode.asList().addNode());
+                        visitor.beginNodeList(key, {});
+                        for (auto &item: value.as_array()) {
+                            visitor.beginListElement({});
+                            visitToml(item, visitor);
+                            visitor.endNode();
+                        }
+                        visitor.endNode();
                     } else {
-                        auto valuesList = std::vector<std::string>{};
+                        auto values = std::vector<TreeValue>{};
+                        auto dateTimeTexts = std::deque<std::string>{};
                         for (auto &item: value.as_array()) {
                             if (item.is_array())
                                 throw tconf::ConfigError{
                                         "Array '" + key + "': toml doesn't support nested arrays"};
-                            valuesList.emplace_back(str(item));
+                            values.emplace_back(treeValue(item, dateTimeTexts.emplace_back()));
                         }
 
-                        node.asItem().addParamList(key, valuesList);
+                        visitor.paramList(key, {values.data(), values.size()}, {});
                     }
-                } else
-                    node.asItem().addParam(key, str(value));
+                } else {
+                    auto dateTimeText = std::string{};
+                    visitor.param(key, treeValue(value, dateTimeText), {});
+                }
             }
         }
-    } //namespace
 
-    TreeNode Parser::parse(std::istream &stream) {
-        const auto toml = [&] {
+        ::toml::value parseToml(std::istream &stream) {
             try {
                 return ::toml::parse(stream);
             }
             catch (const ::toml::exception &e) {
                 throw tconf::ConfigError{e.what(), {e.location().line(), e.location().column()}};
             }
-        }();
+        }
+    } //namespace
 
+    TreeNode Parser::parse(std::istream &stream) {
+        const auto toml = parseToml(stream);
         auto tree = tconf::makeTreeRoot();
-        parseToml(toml, tree);
+        auto builder = TreeBuilder{tree};
+        visitToml(toml, builder);
         return tree;
     }
 
-} //namespace tconf::toml
\ No newline at end of file
+    void Parser::visit(const char *data, std::size_t size, ITreeVisitor &visitor) {
+        auto buffer = tconf::detail::StringViewBuf{std::string_view{data, size}};
+        auto stream = std::istream{&buffer};
+        const auto toml = parseToml(stream);
+        visitToml(toml, visitor);
+    }
+
+} //namespace tconf::toml
@@ -23,7 +23,10 @@
 namespace tconf::toml {
     class Parser : public IParser {
     public:
+        using IParser::parse;
+
         TreeNode parse(std::istream &stream) override;
+        void visit(const char *data, std::size_t size, ITreeVisitor &visitor) override;
     };
 
 } //namespace tconf::toml
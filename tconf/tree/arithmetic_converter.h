@@ -0,0 +1,216 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_TREE_ARITHMETIC_CONVERTER_H_
+#define TCONF_TREE_ARITHMETIC_CONVERTER_H_
+
+#include "tconf/errors.h"
+#include "tconf/tree/string_view_buf.h"
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace tconf::detail {
+
+    /// Character types are read as characters, the other integral types as numbers
+    template<typename T>
+    inline constexpr bool isIntegerNumber = std::is_integral_v<T> &&
+                                            !std::is_same_v<T, bool> &&
+                                            !std::is_same_v<T, char> &&
+                                            !std::is_same_v<T, wchar_t> &&
+                                            !std::is_same_v<T, char16_t> &&
+                                            !std::is_same_v<T, char32_t>;
+
+    inline bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (auto i = std::size_t{}; i < lhs.size(); ++i) {
+            auto ch = lhs[i];
+            if (ch >= 'A' && ch <= 'Z')
+                ch = static_cast<char>(ch - 'A' + 'a');
+            if (ch != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    inline std::optional<bool> boolFromString(std::string_view data) {
+        static constexpr auto trueWords = std::array<std::string_view, 4>{"1", "true", "yes", "on"};
+        static constexpr auto falseWords = std::array<std::string_view, 4>{"0", "false", "no", "off"};
+        for (auto word: trueWords)
+            if (equalsIgnoreCase(data, word))
+                return true;
+        for (auto word: falseWords)
+            if (equalsIgnoreCase(data, word))
+                return false;
+        return {};
+    }
+
+    template<typename T>
+    [[noreturn]] void throwOutOfRange() {
+        throw ValidationError{
+                "value is out of range [" + std::to_string(std::numeric_limits<T>::min()) + ", " +
+                std::to_string(std::numeric_limits<T>::max()) + "]"};
+    }
+
+    ///
+    /// Reads a decimal number or a literal with 0x, 0o or 0b prefix, all of them can have a sign.
+    /// A leading zero doesn't make the number octal, "010" is read as 10.
+    ///
+    template<typename T>
+    std::optional<T> integerFromString(std::string_view data) {
+        auto negative = false;
+        if (!data.empty() && (data.front() == '-' || data.front() == '+')) {
+            negative = data.front() == '-';
+            data.remove_prefix(1);
+        }
+        auto base = 10;
+        if (data.size() > 2 && data.front() == '0') {
+            switch (data[1]) {
+                case 'x':
+                case 'X':
+                    base = 16;
+                    break;
+                case 'o':
+                case 'O':
+                    base = 8;
+                    break;
+                case 'b':
+                case 'B':
+                    base = 2;
+                    break;
+                default:
+                    break;
+            }
+            if (base != 10)
+                data.remove_prefix(2);
+        }
+        // from_chars doesn't accept '+', but it reads '-' which mustn't follow the sign or the prefix
+        if (data.empty() || data.front() == '-')
+            return {};
+
+        auto magnitude = std::uintmax_t{};
+        const auto end = data.data() + data.size();
+        const auto [ptr, error] = std::from_chars(data.data(), end, magnitude, base);
+        if (error == std::errc::result_out_of_range)
+            throwOutOfRange<T>();
+        if (error != std::errc{} || ptr != end)
+            return {};
+
+        if (!negative) {
+            if (magnitude > static_cast<std::uintmax_t>(std::numeric_limits<T>::max()))
+                throwOutOfRange<T>();
+            return static_cast<T>(magnitude);
+        }
+        if (magnitude == 0)
+            return T{};
+        if constexpr (std::is_unsigned_v<T>)
+            throwOutOfRange<T>();
+        else {
+            if (magnitude - 1 > static_cast<std::uintmax_t>(std::numeric_limits<T>::max()))
+                throwOutOfRange<T>();
+            return static_cast<T>(-static_cast<std::intmax_t>(magnitude - 1) - 1);
+        }
+    }
+
+    /// Converts an integer reported by a typed format parser, it must fit the target type
+    template<typename T, typename TValue>
+    T integerCast(TValue value) {
+        if constexpr (std::is_signed_v<TValue>) {
+            if (value < 0) {
+                if constexpr (std::is_unsigned_v<T>)
+                    throwOutOfRange<T>();
+                else if (value < static_cast<std::intmax_t>(std::numeric_limits<T>::min()))
+                    throwOutOfRange<T>();
+                return static_cast<T>(value);
+            }
+        }
+        if (static_cast<std::uintmax_t>(value) > static_cast<std::uintmax_t>(std::numeric_limits<T>::max()))
+            throwOutOfRange<T>();
+        return static_cast<T>(value);
+    }
+
+    template<typename T>
+    T floatCast(double value) {
+        if (std::isfinite(value) && std::abs(value) > static_cast<double>(std::numeric_limits<T>::max()))
+            throw ValidationError{"value is out of range"};
+        return static_cast<T>(value);
+    }
+
+    template<typename T>
+    std::optional<T> streamFromString(std::string_view data) {
+        auto value = T{};
+        auto buffer = StringViewBuf{data};
+        auto stream = std::istream{&buffer};
+        stream >> value;
+
+        if (stream.bad() || stream.fail() || !stream.eof())
+            return {};
+        return value;
+    }
+
+    template<typename T>
+    std::optional<T> floatFromString(std::string_view data) {
+#if defined(__cpp_lib_to_chars)
+        if (!data.empty() && data.front() == '+') {
+            data.remove_prefix(1);
+            if (!data.empty() && data.front() == '-')
+                return {};
+        }
+        auto value = T{};
+        const auto end = data.data() + data.size();
+        const auto [ptr, error] = std::from_chars(data.data(), end, value);
+        if (error == std::errc::result_out_of_range)
+            throw ValidationError{"value is out of range"};
+        if (error != std::errc{} || ptr != end)
+            return {};
+        return value;
+#else
+        return streamFromString<T>(data);
+#endif
+    }
+
+    ///
+    /// Reads the value of a non-string type: arithmetic types are parsed with std::from_chars,
+    /// char is read as a single character, the other types are read from a stream with operator>>.
+    ///
+    template<typename T>
+    std::optional<T> valueFromString(std::string_view data) {
+        if constexpr (std::is_same_v<T, bool>)
+            return boolFromString(data);
+        else if constexpr (isIntegerNumber<T>)
+            return integerFromString<T>(data);
+        else if constexpr (std::is_floating_point_v<T>)
+            return floatFromString<T>(data);
+        else if constexpr (std::is_same_v<T, char>) {
+            if (data.size() != 1)
+                return {};
+            return data.front();
+        }
+        else
+            return streamFromString<T>(data);
+    }
+
+} //namespace tconf::detail
+
+#endif // TCONF_TREE_ARITHMETIC_CONVERTER_H_
@@ -17,8 +17,12 @@
 #ifndef TCONF_CONFIG_TREE_IPARSER_H_
 #define TCONF_CONFIG_TREE_IPARSER_H_
 
+#include "tconf/tree/itree_visitor.h"
+#include "tconf/tree/string_view_buf.h"
 #include "tconf/tree/tree.h"
+#include <cstddef>
 #include <istream>
+#include <string_view>
 
 namespace tconf {
     class IParser {
@@ -26,6 +30,27 @@ namespace tconf {
         virtual ~IParser() = default;
 
         virtual TreeNode parse(std::istream &stream) = 0;
+
+        ///
+        /// Parses the config from a contiguous buffer, it's used by ConfigReader for the file and string input.
+        /// The buffer is valid only during the call. The default implementation reads it through a stream
+        /// without copying, parsers that benefit from direct access to the data can override it.
+        ///
+        virtual TreeNode parse(const char *data, std::size_t size) {
+            auto buffer = detail::StringViewBuf{std::string_view{data, size}};
+            auto stream = std::istream{&buffer};
+            return parse(stream);
+        }
+
+        ///
+        /// Parses the config from a contiguous buffer and reports its structure to the visitor,
+        /// ConfigReader uses it to load the config without building an intermediate tree.
+        /// The default implementation visits the tree returned by parse().
+        ///
+        virtual void visit(const char *data, std::size_t size, ITreeVisitor &visitor) {
+            const auto tree = parse(data, size);
+            visitTree(tree, visitor);
+        }
     };
 
 } //namespace tconf
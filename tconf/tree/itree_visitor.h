@@ -0,0 +1,76 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_TREE_ITREE_VISITOR_H_
+#define TCONF_TREE_ITREE_VISITOR_H_
+
+#include "tconf/tree/stream_position.h"
+#include "tconf/tree/tree.h"
+#include <cstddef>
+#include <string_view>
+
+namespace tconf {
+
+    ///
+    /// Receiver of the config structure reported by IParser::visit() or visitTree().
+    /// Nodes, node lists and node list elements are closed with endNode(),
+    /// the names and values passed to the handlers are valid only during the call.
+    ///
+    class ITreeVisitor {
+    public:
+        virtual ~ITreeVisitor() = default;
+
+        virtual void beginNode(std::string_view name, const StreamPosition &position) = 0;
+
+        virtual void beginNodeList(std::string_view name, const StreamPosition &position) = 0;
+
+        virtual void beginListElement(const StreamPosition &position) = 0;
+
+        virtual void endNode() = 0;
+
+        virtual void param(std::string_view name, const TreeValue &value, const StreamPosition &position) = 0;
+
+        virtual void paramList(std::string_view name, TreeValueList valueList, const StreamPosition &position) = 0;
+
+        /// Called by the parsers knowing the size of the current node before its child nodes are reported,
+        /// the count is an upper bound the visitor can pre-size its storage with
+        virtual void expectNodes(std::size_t) {
+        }
+
+        /// Called by the parsers knowing the size of the current node before its params are reported
+        virtual void expectParams(std::size_t) {
+        }
+
+        /// Called by visitTree() before a child node or node list is reported. The visitor which has
+        /// consumed the whole subtree at once returns true and the subtree's content isn't reported.
+        virtual bool visitSubtree(std::string_view, const TreeNode &) {
+            return false;
+        }
+    };
+
+    ///
+    /// Reports the children of the item node to the visitor: the nodes go first, then the params,
+    /// both in the order they were added to the tree.
+    ///
+    void visitTree(const TreeNode &node, ITreeVisitor &visitor);
+
+    /// Reports the named child node with its content, the visitor's visitSubtree() is tried first
+    void visitNode(std::string_view name, const TreeNode &node, ITreeVisitor &visitor);
+
+    void visitParam(std::string_view name, const TreeParam &param, ITreeVisitor &visitor);
+
+} //namespace tconf
+
+#endif // TCONF_TREE_ITREE_VISITOR_H_
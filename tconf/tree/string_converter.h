@@ -18,35 +18,37 @@
 
 #include "tconf/errors.h"
 #include "tconf/detail/type_traits.h"
+#include "tconf/tree/arithmetic_converter.h"
 #include <optional>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace tconf {
 
+    ///
+    /// Specializations of StringConverter can take either `const std::string&` or `std::string_view`
+    /// in fromString(), the latter avoids copying of the parsed value.
+    /// The primary template reads bool and numbers with std::from_chars (see arithmetic_converter.h),
+    /// the other types with operator>>.
+    ///
     template<typename T>
     struct StringConverter {
-        static std::optional<T> fromString(const std::string &data) {
-            [[maybe_unused]] auto setValue = [](auto &value, const std::string &data) -> std::optional<T> {
-                auto stream = std::stringstream{data};
-                stream >> value;
-
-                if (stream.bad() || stream.fail() || !stream.eof())
-                    return {};
-                return value;
-            };
-
+        static std::optional<T> fromString(std::string_view data) {
             if constexpr (std::is_convertible_v<std::string, sfun::remove_optional_t < T>>) {
-                return data;
+                return std::string{data};
             }
-            else if constexpr (sfun::is_optional_v < T >) {
-                auto value = T{};
-                value.emplace();
-                return setValue(*value, data);
-            } else {
-                auto value = T{};
-                return setValue(value, data);
+            else if constexpr (sfun::is_basic_string_v<sfun::remove_optional_t<T>>) {
+                // the strings with other allocators, e.g. std::pmr::string
+                return T{sfun::remove_optional_t<T>{data}};
             }
+            else if constexpr (sfun::is_optional_v < T >) {
+                auto value = detail::valueFromString<sfun::remove_optional_t<T>>(data);
+                if (!value)
+                    return {};
+                return T{std::move(*value)};
+            } else
+                return detail::valueFromString<T>(data);
         }
     };
 
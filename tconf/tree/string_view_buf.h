@@ -0,0 +1,58 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_TREE_STRING_VIEW_BUF_H_
+#define TCONF_TREE_STRING_VIEW_BUF_H_
+
+#include <ios>
+#include <streambuf>
+#include <string_view>
+
+namespace tconf::detail {
+
+    ///
+    /// Read only seekable stream buffer over a string_view, used to read the data through std::istream without copying it
+    ///
+    class StringViewBuf : public std::streambuf {
+    public:
+        explicit StringViewBuf(std::string_view data) {
+            auto begin = const_cast<char *>(data.data());
+            setg(begin, begin, begin + data.size());
+        }
+
+    protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+            if (!(which & std::ios_base::in))
+                return pos_type(off_type(-1));
+            auto base = off_type{};
+            if (dir == std::ios_base::cur)
+                base = gptr() - eback();
+            else if (dir == std::ios_base::end)
+                base = egptr() - eback();
+            return seekpos(pos_type(base + offset), which);
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+            const auto offset = off_type(pos);
+            if (!(which & std::ios_base::in) || offset < 0 || offset > egptr() - eback())
+                return pos_type(off_type(-1));
+            setg(eback(), eback() + offset, egptr());
+            return pos;
+        }
+    };
+
+} //namespace tconf::detail
+
+#endif // TCONF_TREE_STRING_VIEW_BUF_H_
@@ -0,0 +1,434 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/tree/tree.h"
+#include "tconf/tree/itree_visitor.h"
+#include "tconf/tree/tree_builder.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace tconf {
+
+    namespace {
+        constexpr auto arenaChunkSize = std::size_t{16384};
+
+        std::uint64_t childKey(std::uint32_t itemId, bool isNode) {
+            return (std::uint64_t{itemId} << 1) | (isNode ? 1u : 0u);
+        }
+
+        std::uint64_t childHash(std::uint64_t key, std::string_view name) {
+            // FNV-1a of the name mixed with the parent item key
+            auto hash = std::uint64_t{14695981039346656037ull};
+            for (auto ch: name) {
+                hash ^= static_cast<unsigned char>(ch);
+                hash *= 1099511628211ull;
+            }
+            hash ^= key * 0x9e3779b97f4a7c15ull;
+            return hash ^ (hash >> 29);
+        }
+
+        std::string toString(std::string_view name) {
+            return std::string{name};
+        }
+
+        std::uint64_t mixHash(std::uint64_t hash) {
+            hash ^= hash >> 30;
+            hash *= 0xbf58476d1ce4e5b9ull;
+            hash ^= hash >> 27;
+            hash *= 0x94d049bb133111ebull;
+            return hash ^ (hash >> 31);
+        }
+
+        std::uint64_t combineHash(std::uint64_t seed, std::uint64_t hash) {
+            return mixHash(seed ^ (hash + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+        }
+
+        std::uint64_t stringHash(std::string_view str) {
+            auto hash = std::uint64_t{14695981039346656037ull};
+            for (auto ch: str) {
+                hash ^= static_cast<unsigned char>(ch);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        std::uint64_t valueHash(const TreeValue &value) {
+            const auto seed = static_cast<std::uint64_t>(value.type());
+            switch (value.type()) {
+                case TreeValue::Type::String:
+                    return combineHash(seed, stringHash(value.asString()));
+                case TreeValue::Type::Integer:
+                    return combineHash(seed, static_cast<std::uint64_t>(value.asInteger()));
+                case TreeValue::Type::Unsigned:
+                    return combineHash(seed, value.asUnsigned());
+                case TreeValue::Type::Float: {
+                    auto bits = std::uint64_t{};
+                    const auto floatValue = value.asFloat();
+                    std::memcpy(&bits, &floatValue, sizeof(bits));
+                    return combineHash(seed, bits);
+                }
+                case TreeValue::Type::Bool:
+                    return combineHash(seed, value.asBool() ? 1u : 0u);
+            }
+            return seed;
+        }
+
+        /// named children are combined by a sum, so their order doesn't change the hash
+        std::uint64_t namedChildHash(std::string_view name, std::uint64_t hash) {
+            return mixHash(combineHash(stringHash(name), hash));
+        }
+    } //namespace
+
+    TreeNode::TreeNode(TreeDocumentKey, TreeDocument &document, bool isList, const StreamPosition &position)
+            : data_{isList ? std::variant<Item, List>{List{&document}}
+                           : std::variant<Item, List>{Item{&document, document.makeItemId()}}}, position_{position} {
+    }
+
+    std::shared_ptr<const TreeNode> TreeNode::retain() const {
+        if (isRoot_)
+            return {};
+        const auto document = isItem() ? asItem().document_ : asList().document_;
+        return {document->shared_from_this(), this};
+    }
+
+    std::string &TreeNode::adoptSource(std::string source) {
+        if (!document_)
+            throw std::logic_error{"Only the tree root node can adopt a source buffer"};
+        return document_->adoptSource(std::move(source));
+    }
+
+    std::uint64_t TreeNode::contentHash() const {
+        if (hash_)
+            return *hash_;
+        auto hash = std::uint64_t{};
+        if (isItem()) {
+            const auto &item = asItem();
+            auto paramsHash = std::uint64_t{};
+            for (const auto &[name, param]: item.params())
+                paramsHash += namedChildHash(name, param.contentHash());
+            auto nodesHash = std::uint64_t{};
+            for (const auto &[name, node]: item.nodes())
+                nodesHash += namedChildHash(name, node.contentHash());
+            hash = combineHash(paramsHash, nodesHash);
+        } else {
+            const auto &list = asList();
+            hash = std::uint64_t{1} + static_cast<std::uint64_t>(list.count());
+            for (auto i = 0; i < list.count(); ++i)
+                hash = combineHash(hash, list.node(i).contentHash());
+        }
+        hash_ = hash;
+        return hash;
+    }
+
+    TreeNode &TreeNode::List::addNode(const StreamPosition &pos) {
+        auto &node = document_->makeNode({}, false, pos);
+        nodeList_.push_back(&node);
+        return node;
+    }
+
+    bool TreeNode::Item::hasParam(std::string_view name) const {
+        return document_->findChild(id_, false, name) != nullptr;
+    }
+
+    bool TreeNode::Item::hasNode(std::string_view name) const {
+        return document_->findChild(id_, true, name) != nullptr;
+    }
+
+    const TreeParam &TreeNode::Item::param(std::string_view name) const {
+        auto param = document_->findChild(id_, false, name);
+        if (!param)
+            throw std::out_of_range{"Tree node doesn't have param '" + toString(name) + "'"};
+        return *static_cast<const TreeParam *>(param);
+    }
+
+    const TreeNode &TreeNode::Item::node(std::string_view name) const {
+        auto node = document_->findChild(id_, true, name);
+        if (!node)
+            throw std::out_of_range{"Tree node doesn't have node '" + toString(name) + "'"};
+        return *static_cast<const TreeNode *>(node);
+    }
+
+    TreeNode &TreeNode::Item::addNode(std::string_view name, const StreamPosition &pos) {
+        if (document_->findChild(id_, true, name))
+            throw ConfigError{"Node '" + toString(name) + "' already exists", pos};
+        return addChildNode(name, pos, false);
+    }
+
+    TreeNode &TreeNode::Item::addNodeList(std::string_view name, const StreamPosition &pos) {
+        if (document_->findChild(id_, true, name))
+            throw ConfigError{"Node list '" + toString(name) + "' already exists", pos};
+        return addChildNode(name, pos, true);
+    }
+
+    TreeNode &TreeNode::Item::addChildNode(std::string_view name, const StreamPosition &pos, bool isList) {
+        auto &node = document_->makeNode(name, isList, pos);
+        document_->addChild(id_, true, node.name_, &node);
+        if (lastNode_)
+            lastNode_->next_ = &node;
+        else
+            firstNode_ = &node;
+        lastNode_ = &node;
+        ++nodesCount_;
+        return node;
+    }
+
+    void TreeNode::Item::addParam(std::string_view name, const TreeValue &value, const StreamPosition &pos) {
+        if (document_->findChild(id_, false, name))
+            throw ConfigError{"Parameter '" + toString(name) + "' already exists", pos};
+        addChildParam(document_->makeParam(name, value, pos));
+    }
+
+    void TreeNode::Item::addParamList(
+            std::string_view name,
+            const std::vector<std::string> &valueList,
+            const StreamPosition &pos) {
+        addParamList(name, valueList.begin(), valueList.end(), pos);
+    }
+
+    void TreeNode::Item::addParamList(
+            std::string_view name,
+            const std::vector<std::string_view> &valueList,
+            const StreamPosition &pos) {
+        addParamList(name, valueList.begin(), valueList.end(), pos);
+    }
+
+    void TreeNode::Item::addParamList(
+            std::string_view name,
+            std::initializer_list<std::string_view> valueList,
+            const StreamPosition &pos) {
+        addParamList(name, valueList.begin(), valueList.end(), pos);
+    }
+
+    void TreeNode::Item::addParamList(std::string_view name, TreeValueList valueList, const StreamPosition &pos) {
+        addParamList(name, valueList.begin(), valueList.end(), pos);
+    }
+
+    template<typename TIt>
+    void TreeNode::Item::addParamList(std::string_view name, TIt begin, TIt end, const StreamPosition &pos) {
+        if (document_->findChild(id_, false, name))
+            throw ConfigError{"Parameter list '" + toString(name) + "' already exists", pos};
+        addChildParam(document_->makeParam(name, document_->storeValueList(begin, end), pos));
+    }
+
+    void TreeNode::Item::addChildParam(TreeParam &param) {
+        document_->addChild(id_, false, param.name_, &param);
+        if (lastParam_)
+            lastParam_->next_ = &param;
+        else
+            firstParam_ = &param;
+        lastParam_ = &param;
+        ++paramsCount_;
+    }
+
+    TreeNode &TreeDocument::makeNode(std::string_view name, bool isList, const StreamPosition &pos) {
+        auto &node = nodes_.emplace(TreeDocumentKey{}, *this, isList, pos);
+        node.name_ = storeString(name);
+        return node;
+    }
+
+    TreeParam &TreeDocument::makeParam(std::string_view name, const TreeValue &value, const StreamPosition &pos) {
+        const auto storedValue = storeValue(value);
+        const auto text = storedValue.isString() ? storedValue.asString() : storeString(value.text());
+        auto &param = params_.emplace(TreeDocumentKey{}, storedValue, text, pos);
+        param.name_ = storeString(name);
+        param.hash_ = valueHash(storedValue);
+        return param;
+    }
+
+    TreeParam &TreeDocument::makeParam(std::string_view name, TreeValueList valueList, const StreamPosition &pos) {
+        auto &param = params_.emplace(TreeDocumentKey{}, valueList, pos);
+        param.name_ = storeString(name);
+        auto hash = std::uint64_t{valueList.size()};
+        for (const auto &value: valueList)
+            hash = combineHash(hash, valueHash(value));
+        param.hash_ = mixHash(~hash);
+        return param;
+    }
+
+    std::string &TreeDocument::adoptSource(std::string source) {
+        return *sources_.emplace_back(std::make_unique<std::string>(std::move(source)));
+    }
+
+    bool TreeDocument::isSourceView(std::string_view str) const {
+        auto less = std::less<const char *>{};
+        for (const auto &source: sources_) {
+            const auto sourceBegin = source->data();
+            const auto sourceEnd = source->data() + source->size();
+            if (!less(str.data(), sourceBegin) && !less(sourceEnd, str.data() + str.size()))
+                return true;
+        }
+        return false;
+    }
+
+    std::string_view TreeDocument::storeString(std::string_view str) {
+        if (str.empty())
+            return {};
+        if (isSourceView(str))
+            return str;
+        auto data = static_cast<char *>(allocate(str.size(), 1));
+        std::memcpy(data, str.data(), str.size());
+        return {data, str.size()};
+    }
+
+    TreeValue TreeDocument::storeValue(const TreeValue &value) {
+        if (!value.isString())
+            return value;
+        return TreeValue{storeString(value.asString())};
+    }
+
+    void *TreeDocument::allocate(std::size_t size, std::size_t alignment) {
+        auto padding = (alignment - reinterpret_cast<std::uintptr_t>(arenaPos_) % alignment) % alignment;
+        if (size + padding > arenaSpace_) {
+            auto chunkSize = std::max(arenaChunkSize, size + alignment);
+            arenaChunks_.emplace_back(new char[chunkSize]);
+            arenaPos_ = arenaChunks_.back().get();
+            arenaSpace_ = chunkSize;
+            padding = (alignment - reinterpret_cast<std::uintptr_t>(arenaPos_) % alignment) % alignment;
+        }
+        auto result = arenaPos_ + padding;
+        arenaPos_ += padding + size;
+        arenaSpace_ -= padding + size;
+        return result;
+    }
+
+    bool TreeDocument::addChild(std::uint32_t itemId, bool isNode, std::string_view name, const void *child) {
+        if ((indexSize_ + 1) * 2 > index_.size())
+            growIndex();
+        const auto key = childKey(itemId, isNode);
+        const auto hash = childHash(key, name);
+        const auto mask = index_.size() - 1;
+        for (auto pos = static_cast<std::size_t>(hash) & mask;; pos = (pos + 1) & mask) {
+            auto &entry = index_[pos];
+            if (!entry.child) {
+                entry = IndexEntry{hash, key, name, child};
+                ++indexSize_;
+                return true;
+            }
+            if (entry.hash == hash && entry.key == key && entry.name == name)
+                return false;
+        }
+    }
+
+    const void *TreeDocument::findChild(std::uint32_t itemId, bool isNode, std::string_view name) const {
+        if (index_.empty())
+            return nullptr;
+        const auto key = childKey(itemId, isNode);
+        const auto hash = childHash(key, name);
+        const auto mask = index_.size() - 1;
+        for (auto pos = static_cast<std::size_t>(hash) & mask;; pos = (pos + 1) & mask) {
+            const auto &entry = index_[pos];
+            if (!entry.child)
+                return nullptr;
+            if (entry.hash == hash && entry.key == key && entry.name == name)
+                return entry.child;
+        }
+    }
+
+    void TreeDocument::growIndex() {
+        auto oldIndex = std::move(index_);
+        index_ = std::vector<IndexEntry>(std::max(std::size_t{64}, oldIndex.size() * 2));
+        const auto mask = index_.size() - 1;
+        for (const auto &entry: oldIndex) {
+            if (!entry.child)
+                continue;
+            auto pos = static_cast<std::size_t>(entry.hash) & mask;
+            while (index_[pos].child)
+                pos = (pos + 1) & mask;
+            index_[pos] = entry;
+        }
+    }
+
+    TreeNode makeTreeRoot() {
+        auto document = std::make_shared<TreeDocument>();
+        auto root = TreeNode{TreeDocumentKey{}, *document, false, {1, 1}};
+        root.isRoot_ = true;
+        root.document_ = std::move(document);
+        return root;
+    }
+
+    void visitTree(const TreeNode &node, ITreeVisitor &visitor) {
+        const auto &item = node.asItem();
+        visitor.expectNodes(static_cast<std::size_t>(item.nodesCount()));
+        for (const auto &[name, child]: item.nodes())
+            visitNode(name, child, visitor);
+        visitor.expectParams(static_cast<std::size_t>(item.paramsCount()));
+        for (const auto &[name, param]: item.params())
+            visitParam(name, param, visitor);
+    }
+
+    void visitNode(std::string_view name, const TreeNode &node, ITreeVisitor &visitor) {
+        if (visitor.visitSubtree(name, node))
+            return;
+        if (node.isItem()) {
+            visitor.beginNode(name, node.position());
+            visitTree(node, visitor);
+            visitor.endNode();
+            return;
+        }
+        visitor.beginNodeList(name, node.position());
+        const auto &list = node.asList();
+        for (auto i = 0; i < list.count(); ++i) {
+            const auto &element = list.node(i);
+            visitor.beginListElement(element.position());
+            visitTree(element, visitor);
+            visitor.endNode();
+        }
+        visitor.endNode();
+    }
+
+    void visitParam(std::string_view name, const TreeParam &param, ITreeVisitor &visitor) {
+        if (param.isItem())
+            visitor.param(name, param.typedValue(), param.position());
+        else
+            visitor.paramList(name, param.valueListView(), param.position());
+    }
+
+    TreeBuilder::TreeBuilder(TreeNode &node)
+            : nodes_{&node} {
+    }
+
+    bool TreeBuilder::hasOpenNodes() const {
+        return nodes_.size() > 1;
+    }
+
+    void TreeBuilder::beginNode(std::string_view name, const StreamPosition &position) {
+        nodes_.push_back(&nodes_.back()->asItem().addNode(name, position));
+    }
+
+    void TreeBuilder::beginNodeList(std::string_view name, const StreamPosition &position) {
+        nodes_.push_back(&nodes_.back()->asItem().addNodeList(name, position));
+    }
+
+    void TreeBuilder::beginListElement(const StreamPosition &position) {
+        nodes_.push_back(&nodes_.back()->asList().addNode(position));
+    }
+
+    void TreeBuilder::endNode() {
+        if (!hasOpenNodes())
+            throw std::logic_error{"TreeBuilder: no open node to end"};
+        nodes_.pop_back();
+    }
+
+    void TreeBuilder::param(std::string_view name, const TreeValue &value, const StreamPosition &position) {
+        nodes_.back()->asItem().addParam(name, value, position);
+    }
+
+    void TreeBuilder::paramList(std::string_view name, TreeValueList valueList, const StreamPosition &position) {
+        nodes_.back()->asItem().addParamList(name, valueList, position);
+    }
+
+} //namespace tconf
@@ -18,29 +18,91 @@
 
 #include "tconf/errors.h"
 #include "tconf/tree/stream_position.h"
-#include <map>
+#include "tconf/tree/tree_value.h"
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <new>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
 namespace tconf {
 
+    class TreeNode;
+
+    class TreeDocument;
+
+    ///
+    /// Grants the construction of tree nodes and params to their document
+    ///
+    class TreeDocumentKey {
+        explicit TreeDocumentKey() = default;
+
+        friend class TreeDocument;
+
+        friend TreeNode makeTreeRoot();
+    };
+
+    ///
+    /// Values of a param list, they refer to the memory of the tree's document
+    /// or to the buffers of the parser that reports them to ITreeVisitor
+    ///
+    class TreeValueList {
+    public:
+        TreeValueList() = default;
+
+        TreeValueList(const TreeValue *values, std::size_t size)
+                : values_{values}, size_{size} {
+        }
+
+        const TreeValue *begin() const {
+            return values_;
+        }
+
+        const TreeValue *end() const {
+            return values_ + size_;
+        }
+
+        std::size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        const TreeValue &operator[](std::size_t index) const {
+            return values_[index];
+        }
+
+    private:
+        const TreeValue *values_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
     class TreeParam {
         struct Item {
-            std::string value;
+            TreeValue value;
+            std::string_view text;
         };
         struct List {
-            std::vector<std::string> valueList;
+            TreeValueList valueList;
         };
 
     public:
-        TreeParam(std::string value, const StreamPosition &position = {})
-                : position_(position), data_(Item{std::move(value)}) {
+        TreeParam(TreeDocumentKey, const TreeValue &value, std::string_view text, const StreamPosition &position)
+                : position_(position), data_(Item{value, text}) {
         }
 
-        TreeParam(std::vector<std::string> valueList, const StreamPosition &position = {})
-                : position_(position), data_(List{std::move(valueList)}) {
+        TreeParam(TreeDocumentKey, TreeValueList valueList, const StreamPosition &position)
+                : position_(position), data_(List{valueList}) {
         }
 
         bool isItem() const {
@@ -51,21 +113,124 @@ namespace tconf {
             return std::holds_alternative<List>(data_);
         }
 
-        const std::string &value() const {
+        /// the value refers to the source buffer or the arena of the tree's document,
+        /// typed values added by the parser are returned in their text representation
+        std::string_view value() const {
+            return std::get<Item>(data_).text;
+        }
+
+        const TreeValue &typedValue() const {
             return std::get<Item>(data_).value;
         }
 
-        const std::vector<std::string> valueList() const {
+        TreeValueList valueListView() const {
             return std::get<List>(data_).valueList;
         }
 
+        std::vector<std::string> valueList() const {
+            const auto &valueList = std::get<List>(data_).valueList;
+            auto result = std::vector<std::string>{};
+            result.reserve(valueList.size());
+            for (const auto &value: valueList)
+                result.emplace_back(value.text());
+            return result;
+        }
+
         StreamPosition position() const {
             return position_;
         }
 
+        /// hash of the param's value or value list computed when the param is added to the tree
+        std::uint64_t contentHash() const {
+            return hash_;
+        }
+
     private:
         StreamPosition position_;
         std::variant<Item, List> data_;
+        std::string_view name_;
+        const TreeParam *next_ = nullptr;
+        std::uint64_t hash_ = 0;
+
+        friend class TreeNode;
+
+        friend class TreeDocument;
+
+        template<typename>
+        friend class TreeChildRange;
+    };
+
+    ///
+    /// Insertion ordered range of the named children of a tree node,
+    /// it's iterated with `for (const auto &[name, child]: range)`
+    ///
+    template<typename TChild>
+    class TreeChildRange {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<std::string_view, const TChild &>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            iterator() = default;
+
+            explicit iterator(const TChild *child)
+                    : child_{child} {
+            }
+
+            value_type operator*() const {
+                return {child_->name_, *child_};
+            }
+
+            iterator &operator++() {
+                child_ = child_->next_;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool operator==(const iterator &other) const {
+                return child_ == other.child_;
+            }
+
+            bool operator!=(const iterator &other) const {
+                return child_ != other.child_;
+            }
+
+        private:
+            const TChild *child_ = nullptr;
+        };
+
+        TreeChildRange(const TChild *first, int size)
+                : first_{first}, size_{size} {
+        }
+
+        iterator begin() const {
+            return iterator{first_};
+        }
+
+        iterator end() const {
+            return iterator{};
+        }
+
+        int size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+    private:
+        const TChild *first_;
+        int size_;
     };
 
     class TreeNode {
@@ -80,93 +245,100 @@ namespace tconf {
                 return *nodeList_.at(static_cast<std::size_t>(index));
             }
 
-            TreeNode &addNode(const StreamPosition &pos = {}) {
-                auto node = std::make_unique<TreeNode>();
-                node->position_ = pos;
-                node->data_.emplace<TreeNode::Item>();
-                return *nodeList_.emplace_back(std::move(node));
-            }
+            TreeNode &addNode(const StreamPosition &pos = {});
 
         private:
-            std::vector<std::unique_ptr<TreeNode>> nodeList_;
+            explicit List(TreeDocument *document)
+                    : document_{document} {
+            }
+
+            TreeDocument *document_;
+            std::vector<TreeNode *> nodeList_;
+
+            friend class TreeNode;
         };
 
         class Item {
         public:
             int paramsCount() const {
-                return static_cast<int>(params_.size());
+                return paramsCount_;
             }
 
             int nodesCount() const {
-                return static_cast<int>(nodes_.size());
+                return nodesCount_;
             }
 
-            bool hasParam(const std::string &name) const {
-                return params_.find(name) != params_.end();
-            }
+            bool hasParam(std::string_view name) const;
 
-            bool hasNode(const std::string &name) const {
-                return nodes_.find(name) != nodes_.end();
-            }
+            bool hasNode(std::string_view name) const;
 
-            const TreeParam &param(const std::string &name) const {
-                return params_.at(name);
-            }
+            const TreeParam &param(std::string_view name) const;
 
-            const std::map<std::string, TreeParam> &params() const {
-                return params_;
+            TreeChildRange<TreeParam> params() const {
+                return {firstParam_, paramsCount_};
             }
 
-            const TreeNode &node(const std::string &name) const {
-                return nodes_.at(name);
-            }
+            const TreeNode &node(std::string_view name) const;
 
-            const std::map<std::string, TreeNode> &nodes() const {
-                return nodes_;
+            TreeChildRange<TreeNode> nodes() const {
+                return {firstNode_, nodesCount_};
             }
 
-            TreeNode &addNode(const std::string &name, const StreamPosition &pos = {}) {
-                auto node = TreeNode{};
-                node.position_ = pos;
-                node.data_.emplace<Item>();
-                auto [it, ok] = nodes_.emplace(name, std::move(node));
-                if (!ok)
-                    throw ConfigError{"Node '" + name + "' already exists", pos};
+            TreeNode &addNode(std::string_view name, const StreamPosition &pos = {});
 
-                return it->second;
-            }
+            TreeNode &addNodeList(std::string_view name, const StreamPosition &pos = {});
 
-            TreeNode &addNodeList(const std::string &name, const StreamPosition &pos = {}) {
-                auto node = TreeNode{};
-                node.position_ = pos;
-                node.data_.emplace<List>();
-                auto [it, ok] = nodes_.emplace(name, std::move(node));
-                if (!ok)
-                    throw ConfigError{"Node list '" + name + "' already exists", pos};
+            /// string values that don't refer to the document's source buffer are copied into its arena
+            void addParam(std::string_view name, const TreeValue &value, const StreamPosition &pos = {});
 
-                return it->second;
-            }
+            void addParamList(
+                    std::string_view name,
+                    const std::vector<std::string> &valueList,
+                    const StreamPosition &pos = {});
 
-            void addParam(const std::string &name, const std::string &value, const StreamPosition &pos = {}) {
-                auto [_, ok] = params_.emplace(name, TreeParam{value, pos});
-                if (!ok)
-                    throw ConfigError{"Parameter '" + name + "' already exists", pos};
-            }
+            void addParamList(
+                    std::string_view name,
+                    const std::vector<std::string_view> &valueList,
+                    const StreamPosition &pos = {});
 
             void addParamList(
-                    const std::string &name,
-                    const std::vector<std::string> &valueList,
-                    const StreamPosition &pos = {}) {
-                auto [_, ok] = params_.emplace(name, TreeParam{valueList, pos});
-                if (!ok)
-                    throw ConfigError{"Parameter list '" + name + "' already exists", pos};
-            }
+                    std::string_view name,
+                    std::initializer_list<std::string_view> valueList,
+                    const StreamPosition &pos = {});
+
+            void addParamList(std::string_view name, TreeValueList valueList, const StreamPosition &pos = {});
 
         private:
-            std::map<std::string, TreeParam> params_;
-            std::map<std::string, TreeNode> nodes_;
+            Item(TreeDocument *document, std::uint32_t id)
+                    : document_{document}, id_{id} {
+            }
+
+            TreeNode &addChildNode(std::string_view name, const StreamPosition &pos, bool isList);
+
+            template<typename TIt>
+            void addParamList(std::string_view name, TIt begin, TIt end, const StreamPosition &pos);
+
+            void addChildParam(TreeParam &param);
+
+            TreeDocument *document_;
+            std::uint32_t id_;
+            TreeParam *firstParam_ = nullptr;
+            TreeParam *lastParam_ = nullptr;
+            TreeNode *firstNode_ = nullptr;
+            TreeNode *lastNode_ = nullptr;
+            int paramsCount_ = 0;
+            int nodesCount_ = 0;
+
+            friend class TreeNode;
         };
 
+        /// constructs a node owned by a TreeDocument, use makeTreeRoot() to create a tree
+        TreeNode(TreeDocumentKey, TreeDocument &document, bool isList, const StreamPosition &position);
+
+        TreeNode(TreeNode &&) = default;
+
+        TreeNode &operator=(TreeNode &&) = default;
+
         bool isItem() const {
             return std::holds_alternative<Item>(data_);
         }
@@ -199,19 +371,140 @@ namespace tconf {
             return isRoot_;
         }
 
+        ///
+        /// Hash of the node's content: the names and the values of its params and the content of its child nodes.
+        /// The order of the named children doesn't affect the hash, the order of the list elements does.
+        /// Positions aren't hashed. It's computed on the first call and cached, so the tree must be complete by then.
+        ///
+        std::uint64_t contentHash() const;
+
+        ///
+        /// Returns a pointer to the node that keeps the tree's document alive after the root node is destroyed,
+        /// the tree mustn't be modified while the pointer is held. The root node isn't stored in the document,
+        /// an empty pointer is returned for it.
+        ///
+        std::shared_ptr<const TreeNode> retain() const;
+
+        ///
+        /// Moves the parsed text into the document of a root node. Values and names added to the tree
+        /// that refer to this buffer aren't copied. The buffer can be modified in place during the parsing
+        /// but must not be resized.
+        ///
+        std::string &adoptSource(std::string source);
+
     private:
         std::variant<Item, List> data_;
         bool isRoot_ = false;
         StreamPosition position_{1, 1};
+        std::string_view name_;
+        const TreeNode *next_ = nullptr;
+        mutable std::optional<std::uint64_t> hash_;
+        std::shared_ptr<TreeDocument> document_;
+
+        friend class TreeDocument;
+
+        template<typename>
+        friend class TreeChildRange;
+
+        friend TreeNode makeTreeRoot();
+    };
+
+    ///
+    /// Storage of a parsed tree: nodes and params are kept in chunked arrays with
+    /// stable addresses, names and values either refer to the adopted source buffers
+    /// or are copied into a byte arena, and the children of all nodes are looked up
+    /// by name through a single open addressing hash index.
+    /// The document is owned by the root node returned from makeTreeRoot().
+    ///
+    class TreeDocument : public std::enable_shared_from_this<TreeDocument> {
+    public:
+        TreeDocument() = default;
+
+        TreeDocument(const TreeDocument &) = delete;
+
+        TreeDocument &operator=(const TreeDocument &) = delete;
+
+    private:
+        TreeNode &makeNode(std::string_view name, bool isList, const StreamPosition &pos);
+
+        TreeParam &makeParam(std::string_view name, const TreeValue &value, const StreamPosition &pos);
+
+        TreeParam &makeParam(std::string_view name, TreeValueList valueList, const StreamPosition &pos);
+
+        std::uint32_t makeItemId() {
+            return nextItemId_++;
+        }
+
+        std::string &adoptSource(std::string source);
+
+        bool isSourceView(std::string_view str) const;
+
+        std::string_view storeString(std::string_view str);
+
+        TreeValue storeValue(const TreeValue &value);
+
+        template<typename TIt>
+        TreeValueList storeValueList(TIt begin, TIt end) {
+            const auto size = static_cast<std::size_t>(std::distance(begin, end));
+            if (!size)
+                return {};
+            auto values = static_cast<TreeValue *>(allocate(size * sizeof(TreeValue), alignof(TreeValue)));
+            for (auto i = std::size_t{}; begin != end; ++begin, ++i)
+                new(values + i) TreeValue{storeValue(TreeValue{*begin})};
+            return {values, size};
+        }
+
+        void *allocate(std::size_t size, std::size_t alignment);
+
+        /// returns false if the item already has a child with this name
+        bool addChild(std::uint32_t itemId, bool isNode, std::string_view name, const void *child);
+
+        const void *findChild(std::uint32_t itemId, bool isNode, std::string_view name) const;
+
+        void growIndex();
+
+    private:
+        /// stores elements in chunks of growing size which are never reallocated
+        template<typename T>
+        class Pool {
+        public:
+            template<typename... TArgs>
+            T &emplace(TArgs &&... args) {
+                if (chunks_.empty() || chunks_.back().size() == chunks_.back().capacity()) {
+                    auto chunkSize = chunks_.empty() ? std::size_t{16}
+                                                     : std::min(chunks_.back().capacity() * 2, std::size_t{4096});
+                    chunks_.emplace_back().reserve(chunkSize);
+                }
+                return chunks_.back().emplace_back(std::forward<TArgs>(args)...);
+            }
+
+        private:
+            std::vector<std::vector<T>> chunks_;
+        };
+
+        struct IndexEntry {
+            std::uint64_t hash = 0;
+            std::uint64_t key = 0;
+            std::string_view name;
+            const void *child = nullptr;
+        };
+
+        Pool<TreeNode> nodes_;
+        Pool<TreeParam> params_;
+        std::vector<std::unique_ptr<std::string>> sources_;
+        std::vector<std::unique_ptr<char[]>> arenaChunks_;
+        char *arenaPos_ = nullptr;
+        std::size_t arenaSpace_ = 0;
+        std::vector<IndexEntry> index_;
+        std::size_t indexSize_ = 0;
+        std::uint32_t nextItemId_ = 0;
+
+        friend class TreeNode;
 
         friend TreeNode makeTreeRoot();
     };
 
-    inline TreeNode makeTreeRoot() {
-        auto root = TreeNode{};
-        root.isRoot_ = true;
-        return root;
-    }
+    TreeNode makeTreeRoot();
 
 } //namespace tconf
 
@@ -0,0 +1,55 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_TREE_TREE_BUILDER_H_
+#define TCONF_TREE_TREE_BUILDER_H_
+
+#include "tconf/tree/itree_visitor.h"
+#include "tconf/tree/tree.h"
+#include <string_view>
+#include <vector>
+
+namespace tconf {
+
+    ///
+    /// Visitor adding the visited nodes and params to the children of an item node,
+    /// it lets a parser implement both IParser::parse() and IParser::visit() with the same code.
+    ///
+    class TreeBuilder : public ITreeVisitor {
+    public:
+        explicit TreeBuilder(TreeNode &node);
+
+        /// returns false when all the nodes opened by the visited events are closed
+        bool hasOpenNodes() const;
+
+        void beginNode(std::string_view name, const StreamPosition &position) override;
+
+        void beginNodeList(std::string_view name, const StreamPosition &position) override;
+
+        void beginListElement(const StreamPosition &position) override;
+
+        void endNode() override;
+
+        void param(std::string_view name, const TreeValue &value, const StreamPosition &position) override;
+
+        void paramList(std::string_view name, TreeValueList valueList, const StreamPosition &position) override;
+
+    private:
+        std::vector<TreeNode *> nodes_;
+    };
+
+} //namespace tconf
+
+#endif // TCONF_TREE_TREE_BUILDER_H_
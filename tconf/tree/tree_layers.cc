@@ -0,0 +1,175 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/tree/tree_layers.h"
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+#include <utility>
+
+namespace tconf {
+
+    namespace {
+
+        /// The same node of the merged layers, from the lowest layer to the top one
+        struct LayerNode {
+            std::size_t layer = 0;
+            const TreeNode *node = nullptr;
+        };
+
+        using LayerNodes = std::vector<LayerNode>;
+
+        ///
+        /// Collects the child nodes with the given name that make the merged child, starting with the top layer
+        /// that has a child with this name. A param or a node list hides the children of the lower layers,
+        /// the result is empty if the top child with this name is a param.
+        ///
+        LayerNodes mergedChild(const LayerNodes &nodes, std::string_view name) {
+            auto result = LayerNodes{};
+            for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+                const auto &item = it->node->asItem();
+                if (!item.hasNode(name)) {
+                    if (item.hasParam(name))
+                        break;
+                    continue;
+                }
+                const auto &child = item.node(name);
+                if (child.isList() && !result.empty())
+                    break;
+                result.push_back({it->layer, &child});
+                if (child.isList() || item.hasParam(name))
+                    break;
+            }
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+
+        /// Returns the top layer that has a child with the given name if this child is a param
+        const LayerNode *paramOwner(const LayerNodes &nodes, std::string_view name) {
+            for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+                const auto &item = it->node->asItem();
+                if (item.hasParam(name))
+                    return &*it;
+                if (item.hasNode(name))
+                    return nullptr;
+            }
+            return nullptr;
+        }
+
+        bool hasLowerChild(const LayerNodes &nodes, std::size_t index, std::string_view name, bool isNode) {
+            for (auto i = std::size_t{}; i < index; ++i) {
+                const auto &item = nodes[i].node->asItem();
+                if (isNode ? item.hasNode(name) : item.hasParam(name))
+                    return true;
+            }
+            return false;
+        }
+
+        void visitMerged(const LayerNodes &nodes, ITreeVisitor &visitor);
+
+        void visitMergedNode(std::string_view name, const LayerNodes &nodes, ITreeVisitor &visitor) {
+            const auto &top = *nodes.back().node;
+            if (nodes.size() == 1) {
+                visitNode(name, top, visitor);
+                return;
+            }
+            visitor.beginNode(name, top.position());
+            visitMerged(nodes, visitor);
+            visitor.endNode();
+        }
+
+        void visitMerged(const LayerNodes &nodes, ITreeVisitor &visitor) {
+            if (nodes.size() == 1) {
+                visitTree(*nodes.front().node, visitor);
+                return;
+            }
+            // a name is reported once, when it's met in the lowest layer, with the merged content of all layers
+            for (auto i = std::size_t{}; i < nodes.size(); ++i)
+                for (const auto &[name, child]: nodes[i].node->asItem().nodes()) {
+                    if (hasLowerChild(nodes, i, name, true))
+                        continue;
+                    const auto mergedNodes = mergedChild(nodes, name);
+                    if (!mergedNodes.empty())
+                        visitMergedNode(name, mergedNodes, visitor);
+                }
+            for (auto i = std::size_t{}; i < nodes.size(); ++i)
+                for (const auto &[name, param]: nodes[i].node->asItem().params()) {
+                    if (hasLowerChild(nodes, i, name, false))
+                        continue;
+                    if (const auto owner = paramOwner(nodes, name))
+                        visitParam(name, owner->node->asItem().param(name), visitor);
+                }
+        }
+
+        std::optional<int> elementIndex(std::string_view name) {
+            auto index = 0;
+            const auto end = name.data() + name.size();
+            const auto [ptr, error] = std::from_chars(name.data(), end, index);
+            if (error != std::errc{} || ptr != end || index < 0)
+                return {};
+            return index;
+        }
+
+    } //namespace
+
+    void TreeLayers::add(TreeNode tree, std::string name) {
+        if (!tree.isItem())
+            throw ConfigError{"Tree layer '" + name + "': root node must be an item.", tree.position()};
+        layers_.push_back({std::move(tree), std::move(name)});
+    }
+
+    void TreeLayers::visit(ITreeVisitor &visitor) const {
+        if (layers_.empty())
+            return;
+        auto nodes = LayerNodes{};
+        nodes.reserve(layers_.size());
+        for (auto i = std::size_t{}; i < layers_.size(); ++i)
+            nodes.push_back({i, &layers_[i].tree});
+        visitMerged(nodes, visitor);
+    }
+
+    std::optional<std::size_t> TreeLayers::origin(std::string_view path) const {
+        auto nodes = LayerNodes{};
+        for (auto i = std::size_t{}; i < layers_.size(); ++i)
+            nodes.push_back({i, &layers_[i].tree});
+
+        while (!nodes.empty()) {
+            const auto separatorPos = path.find('.');
+            const auto name = path.substr(0, separatorPos);
+            const auto isLast = separatorPos == std::string_view::npos;
+            const auto &top = nodes.back();
+            if (top.node->isList()) {
+                const auto index = elementIndex(name);
+                if (!index || *index >= top.node->asList().count())
+                    return {};
+                if (isLast)
+                    return top.layer;
+                nodes = {{top.layer, &top.node->asList().node(*index)}};
+            }
+            else {
+                if (isLast) {
+                    if (const auto owner = paramOwner(nodes, name))
+                        return owner->layer;
+                }
+                nodes = mergedChild(nodes, name);
+                if (isLast)
+                    return nodes.empty() ? std::nullopt : std::optional{nodes.back().layer};
+            }
+            path.remove_prefix(separatorPos + 1);
+        }
+        return {};
+    }
+
+} //namespace tconf
@@ -0,0 +1,82 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_TREE_TREE_LAYERS_H_
+#define TCONF_TREE_TREE_LAYERS_H_
+
+#include "tconf/tree/itree_visitor.h"
+#include "tconf/tree/tree.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tconf {
+
+    ///
+    /// Stack of config trees where each added tree overrides the previous ones, e.g. a base config
+    /// and the environment and host specific overrides, possibly parsed from different formats.
+    /// The layers are merged by the following rules:
+    ///  - a param or a param list replaces the child with the same name of the lower layers;
+    ///  - a node list replaces the child with the same name of the lower layers, its elements aren't merged;
+    ///  - a node is merged with the nodes of the same name of the lower layers down to the first layer
+    ///    where this name belongs to a param or a node list. Dictionaries are nodes, so they're merged by key.
+    /// The merged tree isn't built: visit() reports it while walking the layers, the subtrees that are present
+    /// in a single layer are reported as they are, so the merging work depends only on the size of the overrides.
+    ///
+    class TreeLayers {
+    public:
+        /// Adds the tree over the previously added ones, the name identifies the layer for origin()
+        void add(TreeNode tree, std::string name = {});
+
+        std::size_t size() const {
+            return layers_.size();
+        }
+
+        bool empty() const {
+            return layers_.empty();
+        }
+
+        const TreeNode &tree(std::size_t index) const {
+            return layers_.at(index).tree;
+        }
+
+        const std::string &name(std::size_t index) const {
+            return layers_.at(index).name;
+        }
+
+        /// Reports the children of the merged root node to the visitor like visitTree() does
+        void visit(ITreeVisitor &visitor) const;
+
+        ///
+        /// Index of the layer which the merged value at the path comes from. The path consists of the names of
+        /// the nodes and the param separated with '.', the elements of node lists are addressed by their indexes,
+        /// e.g. "servers.1.port". Returns an empty optional if the merged tree doesn't have such a field.
+        ///
+        std::optional<std::size_t> origin(std::string_view path) const;
+
+    private:
+        struct Layer {
+            TreeNode tree;
+            std::string name;
+        };
+
+        std::vector<Layer> layers_;
+    };
+
+} //namespace tconf
+
+#endif // TCONF_TREE_TREE_LAYERS_H_
@@ -0,0 +1,54 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "tconf/tree/tree_value.h"
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <system_error>
+
+namespace tconf {
+
+    namespace {
+        std::string floatToString(double value) {
+            auto buffer = std::array<char, 32>{};
+#if defined(__cpp_lib_to_chars)
+            // the shortest representation that reads back to the same value
+            const auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+            if (error == std::errc{})
+                return {buffer.data(), end};
+#endif
+            const auto size = std::snprintf(buffer.data(), buffer.size(), "%.17g", value);
+            return {buffer.data(), static_cast<std::size_t>(size)};
+        }
+    } //namespace
+
+    std::string TreeValue::text() const {
+        switch (type()) {
+            case Type::String:
+                return std::string{asString()};
+            case Type::Integer:
+                return std::to_string(asInteger());
+            case Type::Unsigned:
+                return std::to_string(asUnsigned());
+            case Type::Float:
+                return floatToString(asFloat());
+            case Type::Bool:
+                return asBool() ? "true" : "false";
+        }
+        return {};
+    }
+
+} //namespace tconf
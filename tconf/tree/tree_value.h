@@ -0,0 +1,109 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_TREE_TREE_VALUE_H_
+#define TCONF_TREE_TREE_VALUE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace tconf {
+
+    ///
+    /// Scalar value of a config parameter: either a string or a number or a boolean
+    /// reported by a parser of a typed format, so it can be loaded without formatting it to a string.
+    /// The string value doesn't own its data.
+    ///
+    class TreeValue {
+    public:
+        enum class Type {
+            String,
+            Integer,
+            Unsigned,
+            Float,
+            Bool
+        };
+
+        TreeValue() = default;
+
+        TreeValue(std::string_view value)
+                : data_{value} {
+        }
+
+        TreeValue(const char *value)
+                : data_{std::string_view{value}} {
+        }
+
+        TreeValue(const std::string &value)
+                : data_{std::string_view{value}} {
+        }
+
+        explicit TreeValue(std::int64_t value)
+                : data_{value} {
+        }
+
+        explicit TreeValue(std::uint64_t value)
+                : data_{value} {
+        }
+
+        explicit TreeValue(double value)
+                : data_{value} {
+        }
+
+        explicit TreeValue(bool value)
+                : data_{value} {
+        }
+
+        Type type() const {
+            return static_cast<Type>(data_.index());
+        }
+
+        bool isString() const {
+            return type() == Type::String;
+        }
+
+        std::string_view asString() const {
+            return std::get<std::string_view>(data_);
+        }
+
+        std::int64_t asInteger() const {
+            return std::get<std::int64_t>(data_);
+        }
+
+        std::uint64_t asUnsigned() const {
+            return std::get<std::uint64_t>(data_);
+        }
+
+        double asFloat() const {
+            return std::get<double>(data_);
+        }
+
+        bool asBool() const {
+            return std::get<bool>(data_);
+        }
+
+        /// the string value or the text representation of a typed one, it's used for the conversion
+        /// to the non-arithmetic types and in the error messages
+        std::string text() const;
+
+    private:
+        std::variant<std::string_view, std::int64_t, std::uint64_t, double, bool> data_;
+    };
+
+} //namespace tconf
+
+#endif // TCONF_TREE_TREE_VALUE_H_
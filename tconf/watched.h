@@ -0,0 +1,220 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef TCONF_WATCHED_H_
+#define TCONF_WATCHED_H_
+
+#include "tconf/config_changes.h"
+#include "tconf/config_reader.h"
+#include "tconf/errors.h"
+#include "tconf/name_format.h"
+#include "tconf/detail/file_watcher.h"
+#include "tconf/tree/iparser.h"
+#include "turbo/files/filesystem.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace tconf {
+
+    struct WatchOptions {
+        /// the changes that follow each other within this period are handled by a single reload
+        std::chrono::milliseconds debounce{100};
+        /// the period of checking the file's modification time when the change notifications aren't available
+        std::chrono::milliseconds poll_interval{1000};
+        /// each snapshot's pmr containers and strings are placed in its own std::pmr::monotonic_buffer_resource,
+        /// which is released at once with the retired snapshot
+        bool snapshot_arena = false;
+        /// called by the watching thread after a new snapshot is published, each reload reads the whole config,
+        /// so it's reported with ConfigChanges::isFullReload; an exception thrown by the handler is stored
+        /// as last_error()
+        std::function<void(const ConfigChanges &changes)> on_change;
+    };
+
+    ///
+    /// Config file that is read again on each change. Every successfully read config is published
+    /// as an immutable snapshot, the snapshots that are held by the readers stay valid after the reload.
+    /// If a changed file can't be read, the previous snapshot is kept and the error is available
+    /// through last_error(). The file is read into memory, so a writer truncating it during the reload
+    /// only causes a parse error. The file is watched by a background thread until the object is destroyed.
+    ///
+    template<typename TCfg, NameFormat nameFormat = NameFormat::Original>
+    class Watched {
+    public:
+        using Snapshot = std::shared_ptr<const TCfg>;
+
+        ///
+        /// Cached access to the current snapshot for a single thread. While the config isn't reloaded,
+        /// get() only checks the snapshot version and never blocks or touches the shared reference counter.
+        /// A reader must not outlive the watched config.
+        ///
+        class Reader {
+        public:
+            explicit Reader(const Watched &watched)
+                    : watched_{&watched}, version_{watched.version()}, snapshot_{watched.snapshot()} {
+            }
+
+            const TCfg &get() {
+                const auto version = watched_->version();
+                if (version != version_) {
+                    snapshot_ = watched_->snapshot();
+                    version_ = version;
+                }
+                return *snapshot_;
+            }
+
+            const TCfg *operator->() {
+                return &get();
+            }
+
+        private:
+            const Watched *watched_;
+            std::uint64_t version_;
+            Snapshot snapshot_;
+        };
+
+        /// reads the config file, the errors of the initial reading are thrown as ConfigError
+        Watched(const turbo::filesystem::path &configFile,
+                std::unique_ptr<IParser> parser,
+                const WatchOptions &options = {})
+                : configFile_{configFile},
+                  parser_{std::move(parser)},
+                  options_{options},
+                  watcher_{configFile, options.poll_interval},
+                  snapshot_{read()} {
+            thread_ = std::thread{[this] { watch(); }};
+        }
+
+        ~Watched() {
+            watcher_.interrupt();
+            thread_.join();
+        }
+
+        Watched(const Watched &) = delete;
+
+        Watched &operator=(const Watched &) = delete;
+
+        Watched(Watched &&) = delete;
+
+        Watched &operator=(Watched &&) = delete;
+
+        Snapshot snapshot() const {
+            return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+        }
+
+        Reader reader() const {
+            return Reader{*this};
+        }
+
+        /// the number of the successful reloads, it changes after the new snapshot is published
+        std::uint64_t version() const {
+            return version_.load(std::memory_order_acquire);
+        }
+
+        /// the error of the last reload or nullopt if it has succeeded
+        std::optional<std::string> last_error() const {
+            auto lock = std::lock_guard{errorMutex_};
+            return lastError_;
+        }
+
+    private:
+        /// the config is destroyed before its arena
+        struct ArenaSnapshot {
+            std::pmr::monotonic_buffer_resource arena;
+            std::optional<TCfg> cfg;
+        };
+
+        Snapshot read() {
+            auto reader = ConfigReader<nameFormat>{};
+            if (options_.snapshot_arena) {
+                auto arenaSnapshot = std::make_shared<ArenaSnapshot>();
+                arenaSnapshot->cfg.emplace(
+                        reader.template read_file<TCfg>(configFile_, *parser_, &arenaSnapshot->arena));
+                return Snapshot{arenaSnapshot, &*arenaSnapshot->cfg};
+            }
+            return std::make_shared<const TCfg>(reader.template read_file<TCfg>(configFile_, *parser_));
+        }
+
+        ConfigChanges reload() {
+            publish(read());
+            return ConfigChanges{{}, true};
+        }
+
+        void publish(Snapshot snapshot) {
+            std::atomic_store_explicit(&snapshot_, std::move(snapshot), std::memory_order_release);
+            version_.fetch_add(1, std::memory_order_release);
+        }
+
+        void watch() {
+            while (watcher_.waitForChange(options_.debounce)) {
+                auto error = std::optional<std::string>{};
+                try {
+                    const auto changes = reload();
+                    if (options_.on_change)
+                        options_.on_change(changes);
+                }
+                catch (const std::exception &e) {
+                    error = e.what();
+                }
+                auto lock = std::lock_guard{errorMutex_};
+                lastError_ = std::move(error);
+            }
+        }
+
+    private:
+        turbo::filesystem::path configFile_;
+        std::unique_ptr<IParser> parser_;
+        WatchOptions options_;
+        // the file is watched before the initial reading, so the changes made during it aren't missed
+        detail::FileWatcher watcher_;
+        Snapshot snapshot_;
+        std::atomic<std::uint64_t> version_ = 0;
+        mutable std::mutex errorMutex_;
+        std::optional<std::string> lastError_;
+        std::thread thread_;
+    };
+
+    template<typename TCfg, NameFormat nameFormat = NameFormat::Original>
+    Watched<TCfg, nameFormat> watch_json_file(const turbo::filesystem::path &configFile, const WatchOptions &options = {}) {
+        return {configFile, std::make_unique<JsonParser>(), options};
+    }
+
+    template<typename TCfg, NameFormat nameFormat = NameFormat::Original>
+    Watched<TCfg, nameFormat> watch_yaml_file(const turbo::filesystem::path &configFile, const WatchOptions &options = {}) {
+        return {configFile, std::make_unique<yaml::Parser>(), options};
+    }
+
+    template<typename TCfg, NameFormat nameFormat = NameFormat::Original>
+    Watched<TCfg, nameFormat> watch_toml_file(const turbo::filesystem::path &configFile, const WatchOptions &options = {}) {
+        return {configFile, std::make_unique<toml::Parser>(), options};
+    }
+
+    template<typename TCfg, NameFormat nameFormat = NameFormat::Original>
+    Watched<TCfg, nameFormat> watch_ini_file(const turbo::filesystem::path &configFile, const WatchOptions &options = {}) {
+        return {configFile, std::make_unique<ini::Parser>(), options};
+    }
+
+}  // namespace tconf
+
+#endif  // TCONF_WATCHED_H_
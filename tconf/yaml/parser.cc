@@ -16,9 +16,13 @@
 #include "tconf/yaml/rapidyaml.h"
 #include "tconf/errors.h"
 #include "tconf/tree/iparser.h"
+#include "tconf/tree/tree_builder.h"
 #include <iterator>
+#include <memory>
+#include <optional>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tconf::yaml::detail {
@@ -27,53 +31,121 @@ namespace tconf::yaml::detail {
             throw tconf::ConfigError{std::string{msg, len}, {loc.line, loc.col}};
         }
 
-        ryml::Callbacks errorCallback() {
+        ryml::Callbacks errorCallbacks() {
             return {nullptr, nullptr, nullptr, on_error};
         }
 
-        void parseYaml(const ryml::ConstNodeRef &yaml, tconf::TreeNode &node) {
-            auto str = [](const auto &yamlstr) {
-                return std::string{yamlstr.data(), yamlstr.size()};
-            };
+        std::string_view view(ryml::csubstr yamlstr) {
+            return {yamlstr.data(), yamlstr.size()};
+        }
+
+        /// valueList is a buffer reused for the param lists
+        void visitYaml(
+                const ryml::ConstNodeRef &yaml,
+                tconf::ITreeVisitor &visitor,
+                std::vector<TreeValue> &valueList) {
             if (yaml.is_stream()) {
-                parseYaml(yaml[0], node);
+                visitYaml(yaml[0], visitor, valueList);
                 return;
             }
             for (const auto &child: yaml.children()) {
                 if (child.is_map()) {
-                    auto &newNode = node.asItem().addNode(str(child.key()));
-                    parseYaml(child, newNode);
+                    visitor.beginNode(view(child.key()), {});
+                    visitYaml(child, visitor, valueList);
+                    visitor.endNode();
                 } else if (child.is_container()) {
                     if (child.has_children() && child.first_child().is_map()) {
-                        auto &newNode = node.asItem().addNodeList(str(child.key()));
-                        for (const auto &item: child.children())
-                            parseYaml(item, newNode.asList().addNode());
+                        visitor.beginNodeList(view(child.key()), {});
+                        for (const auto &item: child.children()) {
+                            visitor.beginListElement({});
+                            visitYaml(item, visitor, valueList);
+                            visitor.endNode();
+                        }
+                        visitor.endNode();
                     } else {
-                        auto valuesList = std::vector<std::string>{};
+                        valueList.clear();
                         for (auto item: child.children())
-                            valuesList.emplace_back(str(item.val()));
+                            valueList.emplace_back(view(item.val()));
 
-                        node.asItem().addParamList(str(child.key()), valuesList);
+                        visitor.paramList(view(child.key()), {valueList.data(), valueList.size()}, {});
                     }
                 } else if (child.is_keyval())
-                    node.asItem().addParam(str(child.key()), str(child.val()));
+                    visitor.param(view(child.key()), view(child.val()), {});
             }
         }
     } //namespace
 } //namespace tconf::yaml::detail
 
 namespace tconf::yaml {
+    // The callbacks are set on the parser and its tree instead of the global rapidyaml state,
+    // so the errors are reported the same way regardless of other rapidyaml users and threads
+    class Parser::Impl {
+    public:
+        Impl()
+                : tree_{detail::errorCallbacks()} {
+            parser_.emplace(detail::errorCallbacks());
+        }
+
+        const ryml::Tree &parse(ryml::substr input) {
+            tree_.clear();
+            tree_.clear_arena();
+            try {
+                parser_->parse_in_place({}, input, &tree_);
+            }
+            catch (...) {
+                // rapidyaml's parser can't be reused after an error
+                parser_.emplace(detail::errorCallbacks());
+                throw;
+            }
+            return tree_;
+        }
+
+        void visit(const ryml::Tree &yaml, ITreeVisitor &visitor) {
+            detail::visitYaml(yaml.rootref(), visitor, valueList_);
+        }
+
+        /// mutable copy of the visited input, it's kept to reuse its memory
+        std::string &buffer() {
+            return buffer_;
+        }
+
+    private:
+        std::optional<ryml::Parser> parser_;
+        ryml::Tree tree_;
+        std::string buffer_;
+        std::vector<TreeValue> valueList_;
+    };
+
+    Parser::Parser()
+            : impl_{std::make_unique<Parser::Impl>()} {
+    }
+
+    Parser::~Parser() = default;
+
     TreeNode Parser::parse(std::istream &stream) {
-        stream >> std::noskipws;
+        return parseSource(std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}});
+    }
 
-        auto input = std::string{std::istream_iterator<char>{stream}, std::istream_iterator<char>{}};
-        auto yaml = ryml::Tree{};
-        ryml::set_callbacks(detail::errorCallback());
-        yaml = ryml::parse_in_arena(ryml::to_csubstr(input));
+    TreeNode Parser::parse(const char *data, std::size_t size) {
+        // rapidyaml parses in place, so the buffer is copied once into the document
+        return parseSource(std::string{data, size});
+    }
 
-        auto tree = tconf::makeTreeRoot();
-        detail::parseYaml(yaml.rootref(), tree);
+    void Parser::visit(const char *data, std::size_t size, ITreeVisitor &visitor) {
+        auto &input = impl_->buffer();
+        input.assign(data, size);
+        const auto &yaml = impl_->parse(ryml::substr{input.data(), input.size()});
+        impl_->visit(yaml, visitor);
+    }
 
+    TreeNode Parser::parseSource(std::string source) {
+        auto tree = tconf::makeTreeRoot();
+        // The document keeps the input, so the scalars parsed in place are stored as views into it.
+        // Scalars that rapidyaml has to place into its own arena are copied by the tree.
+        auto &input = tree.adoptSource(std::move(source));
+        const auto &yaml = impl_->parse(ryml::substr{input.data(), input.size()});
+        auto builder = TreeBuilder{tree};
+        impl_->visit(yaml, builder);
         return tree;
     }
 
@@ -18,11 +18,43 @@
 
 #include "tconf/tree/iparser.h"
 #include "tconf/tree/tree.h"
+#include <cstddef>
+#include <memory>
+#include <string>
 
 namespace tconf::yaml {
+    ///
+    /// Keeps the rapidyaml parser and tree between the calls of parse() and visit(), so reading the same or
+    /// a similar document again reuses their memory. A Parser object must not be used by several threads
+    /// simultaneously, different objects can be used concurrently.
+    ///
     class Parser : public IParser {
+        class Impl;
+
     public:
+        Parser();
+
+        ~Parser() override;
+
+        Parser(const Parser &) = delete;
+
+        Parser(Parser &&) = delete;
+
+        Parser &operator=(const Parser &) = delete;
+
+        Parser &operator=(Parser &&) = delete;
+
         TreeNode parse(std::istream &stream) override;
+
+        TreeNode parse(const char *data, std::size_t size) override;
+
+        void visit(const char *data, std::size_t size, ITreeVisitor &visitor) override;
+
+    private:
+        TreeNode parseSource(std::string source);
+
+    private:
+        std::unique_ptr<Impl> impl_;
     };
 
 } //namespace tconf::yaml
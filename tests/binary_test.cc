@@ -0,0 +1,331 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/binary/compile.h"
+#include "tconf/binary/format.h"
+#include "tconf/binary/parser.h"
+#include "tconf/binary/writer.h"
+#include "tconf/config.h"
+#include "tconf/config_reader.h"
+#include "tconf/yaml/parser.h"
+#include "turbo/files/filesystem.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test_binary {
+
+    struct ItemCfg : public tconf::Config {
+        TCONF_PARAM(name, std::string);
+        TCONF_PARAM(weight, double)(1.0);
+    };
+
+    struct TestCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testBool, bool)();
+        TCONF_PARAM_LIST(testList, std::vector<int>)();
+        TCONF_NODE_LIST(items, std::vector<ItemCfg>)();
+    };
+
+    struct OtherCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testStr, std::string)();
+    };
+
+    class TempFile {
+    public:
+        TempFile(const std::string &name, const std::string &content)
+                : path_{turbo::filesystem::temp_directory_path() / name} {
+            write(content);
+        }
+
+        ~TempFile() {
+            auto error = std::error_code{};
+            turbo::filesystem::remove(path_, error);
+        }
+
+        void write(const std::string &content) {
+            auto stream = std::ofstream{path_, std::ios_base::binary | std::ios_base::trunc};
+            stream << content;
+        }
+
+        const turbo::filesystem::path &path() const {
+            return path_;
+        }
+
+    private:
+        turbo::filesystem::path path_;
+    };
+
+    const auto configText = std::string{R"(
+testInt: 42
+testBool: true
+testList: [1, 2, 3]
+items:
+  - name: first
+    weight: 0.5
+  - name: "second"
+)"};
+
+    tconf::TreeNode parseYaml(const std::string &content) {
+        auto stream = std::istringstream{content};
+        return tconf::yaml::Parser{}.parse(stream);
+    }
+
+    TEST_CASE("TestBinary, RoundTrip") {
+        const auto tree = parseYaml(configText);
+        const auto snapshot = tconf::binary::write(tree);
+        const auto header = tconf::binary::readHeader(snapshot.data(), snapshot.size());
+        REQUIRE(header.has_value());
+        REQUIRE_EQ(header->version, tconf::binary::version);
+        REQUIRE_EQ(header->fingerprint, 0);
+
+        auto parser = tconf::binary::Parser{};
+        const auto restoredTree = parser.parse(snapshot.data(), snapshot.size());
+        REQUIRE_EQ(restoredTree.contentHash(), tree.contentHash());
+        const auto &param = restoredTree.asItem().param("testInt");
+        REQUIRE(param.typedValue().type() == tree.asItem().param("testInt").typedValue().type());
+        REQUIRE_EQ(param.position().line, tree.asItem().param("testInt").position().line);
+        const auto &items = restoredTree.asItem().node("items").asList();
+        REQUIRE_EQ(items.count(), 2);
+        REQUIRE_EQ(items.node(1).asItem().param("name").value(), "second");
+    }
+
+    TEST_CASE("TestBinary, CorruptedData") {
+        auto snapshot = tconf::binary::write(parseYaml(configText));
+        auto parser = tconf::binary::Parser{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    parser.parse(snapshot.data(), snapshot.size() - 1);
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Binary config: the data isn't a tconf snapshot");
+                });
+        // the kind of the first node record follows its name and position
+        snapshot[tconf::binary::headerSize + 4 + 4 + 5 + 8] = 7;
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    parser.parse(snapshot.data(), snapshot.size());
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Binary config: the data is corrupted");
+                });
+    }
+
+    TEST_CASE("TestBinary, NestingDepth") {
+        // a crafted snapshot of nested nodes with empty names, each level takes 25 bytes
+        const auto depth = std::uint32_t{100000};
+        auto snapshot = tconf::binary::write(parseYaml("testInt: 1\n"));
+        snapshot.resize(tconf::binary::headerSize);
+        const auto append = [&](std::uint32_t value) {
+            snapshot.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        };
+        for (auto i = std::uint32_t{}; i < depth; ++i) {
+            append(1);
+            append(0);
+            append(0);
+            append(0);
+            snapshot.push_back(static_cast<char>(tconf::binary::RecordKind::Item));
+            append(8 + (depth - i - 1) * 25 + 4);
+        }
+        append(0);
+        append(0);
+        for (auto i = std::uint32_t{}; i < depth; ++i)
+            append(0);
+        const auto bodySize = static_cast<std::uint64_t>(snapshot.size() - tconf::binary::headerSize);
+        std::memcpy(snapshot.data() + 24, &bodySize, sizeof(bodySize));
+
+        auto parser = tconf::binary::Parser{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    parser.parse(snapshot.data(), snapshot.size());
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Binary config: the data is corrupted");
+                });
+
+        auto nestedConfig = std::string{};
+        for (auto i = std::size_t{}; i <= tconf::binary::maxNestingDepth; ++i)
+            nestedConfig += std::string(i * 2, ' ') + "node:\n";
+        nestedConfig += std::string((tconf::binary::maxNestingDepth + 1) * 2, ' ') + "param: 1\n";
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    tconf::binary::write(parseYaml(nestedConfig));
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Binary config: the tree is nested too deeply to be serialized");
+                });
+    }
+
+    TEST_CASE("TestBinary, SchemaFingerprint") {
+        auto reader = tconf::ConfigReader{};
+        REQUIRE(reader.schema_fingerprint<TestCfg>() != 0);
+        REQUIRE(reader.schema_fingerprint<TestCfg>() != reader.schema_fingerprint<OtherCfg>());
+        REQUIRE(reader.schema_fingerprint<TestCfg>() != reader.schema_fingerprint<ItemCfg>());
+        auto snakeCaseReader = tconf::ConfigReader<tconf::NameFormat::SnakeCase>{};
+        REQUIRE(reader.schema_fingerprint<TestCfg>() != snakeCaseReader.schema_fingerprint<TestCfg>());
+    }
+
+    TEST_CASE("TestBinary, ReadSnapshotFile") {
+        auto reader = tconf::ConfigReader{};
+        auto snapshotFile = TempFile{"tconf_test_snapshot.bin", ""};
+        reader.write_snapshot_file<TestCfg>(snapshotFile.path(), parseYaml(configText));
+
+        auto cfg = reader.read_snapshot_file<TestCfg>(snapshotFile.path());
+        REQUIRE_EQ(cfg.testInt, 42);
+        REQUIRE_EQ(cfg.testBool, true);
+        REQUIRE_EQ(cfg.testList, (std::vector<int>{1, 2, 3}));
+        REQUIRE_EQ(cfg.items.size(), 2);
+        REQUIRE_EQ(cfg.items.at(0).weight, 0.5);
+        REQUIRE_EQ(cfg.items.at(1).name, "second");
+        REQUIRE_EQ(cfg.items.at(1).weight, 1.0);
+
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_snapshot_file<OtherCfg>(snapshotFile.path());
+                },
+                [&](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Binary config file " + snapshotFile.path().string() +
+                                    " was written for a config with another schema");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.write_snapshot_file<OtherCfg>(snapshotFile.path(), parseYaml("testInt: 1\ntestBool: true\n"));
+                },
+                [&](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Unknown param 'testBool'");
+                });
+    }
+
+    TEST_CASE("TestBinary, ReadSnapshotFileWithFallback") {
+        auto reader = tconf::ConfigReader{};
+        auto parser = tconf::yaml::Parser{};
+        auto configFile = TempFile{"tconf_test_snapshot_source.yaml", configText};
+        auto snapshotFile = TempFile{"tconf_test_snapshot_source.bin", ""};
+        reader.write_snapshot_file<TestCfg>(snapshotFile.path(), parseYaml("testInt: 1\n"));
+        const auto now = turbo::filesystem::file_time_type::clock::now();
+        turbo::filesystem::last_write_time(configFile.path(), now - std::chrono::hours{1});
+        turbo::filesystem::last_write_time(snapshotFile.path(), now);
+
+        // the snapshot is used while the config file isn't newer
+        REQUIRE_EQ(reader.read_snapshot_file<TestCfg>(snapshotFile.path(), configFile.path(), parser).testInt, 1);
+
+        // the config file is read if the snapshot is stale
+        turbo::filesystem::last_write_time(configFile.path(), now + std::chrono::hours{1});
+        REQUIRE_EQ(reader.read_snapshot_file<TestCfg>(snapshotFile.path(), configFile.path(), parser).testInt, 42);
+        turbo::filesystem::last_write_time(configFile.path(), now - std::chrono::hours{1});
+
+        // or if it was written for another schema
+        auto otherReader = tconf::ConfigReader{};
+        otherReader.write_snapshot_file<OtherCfg>(snapshotFile.path(), parseYaml("testInt: 2\n"));
+        turbo::filesystem::last_write_time(snapshotFile.path(), now);
+        REQUIRE_EQ(reader.read_snapshot_file<TestCfg>(snapshotFile.path(), configFile.path(), parser).testInt, 42);
+
+        // or if it's corrupted
+        snapshotFile.write("TCONFBIN");
+        turbo::filesystem::last_write_time(snapshotFile.path(), now);
+        REQUIRE_EQ(reader.read_snapshot_file<TestCfg>(snapshotFile.path(), configFile.path(), parser).testInt, 42);
+
+        // or if it has no fingerprint
+        tconf::binary::writeFile(snapshotFile.path(), parseYaml("testInt: 3\n"));
+        turbo::filesystem::last_write_time(snapshotFile.path(), now);
+        REQUIRE_EQ(reader.read_snapshot_file<TestCfg>(snapshotFile.path(), configFile.path(), parser).testInt, 42);
+    }
+
+    TEST_CASE("TestBinary, ReadUnboundSnapshotFile") {
+        auto reader = tconf::ConfigReader{};
+        auto snapshotFile = TempFile{"tconf_test_unbound_snapshot.bin", ""};
+        tconf::binary::writeFile(snapshotFile.path(), parseYaml("testInt: 3\ntestStr: other\n"));
+
+        // the snapshot of another config doesn't bind to a config without the explicit opt-in
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_snapshot_file<TestCfg>(snapshotFile.path());
+                },
+                [&](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Binary config file " + snapshotFile.path().string() +
+                                    " has no schema fingerprint, write it for the config type or pass "
+                                    "UnboundSnapshot::Accept");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_snapshot_file<OtherCfg>(snapshotFile.path());
+                },
+                [&](const tconf::ConfigError &) {});
+
+        auto cfg = reader.read_snapshot_file<OtherCfg>(snapshotFile.path(), tconf::UnboundSnapshot::Accept);
+        REQUIRE_EQ(cfg.testInt, 3);
+        REQUIRE_EQ(cfg.testStr, "other");
+        // the accepted snapshot is still read by the config structure
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_snapshot_file<TestCfg>(snapshotFile.path(), tconf::UnboundSnapshot::Accept);
+                },
+                [&](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Unknown param 'testStr'");
+                });
+
+        // a snapshot written with the passed fingerprint is bound to its config
+        tconf::binary::writeFile(
+                snapshotFile.path(),
+                parseYaml("testInt: 3\ntestStr: other\n"),
+                reader.schema_fingerprint<OtherCfg>());
+        REQUIRE_EQ(reader.read_snapshot_file<OtherCfg>(snapshotFile.path()).testInt, 3);
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_snapshot_file<TestCfg>(snapshotFile.path(), tconf::UnboundSnapshot::Accept);
+                },
+                [&](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Binary config file " + snapshotFile.path().string() +
+                                    " was written for a config with another schema");
+                });
+    }
+
+    TEST_CASE("TestBinary, CompileMain") {
+        auto reader = tconf::ConfigReader{};
+        auto configFile = TempFile{"tconf_test_compile.yaml", configText};
+        auto snapshotFile = TempFile{"tconf_test_compile.bin", ""};
+        auto configPath = configFile.path().string();
+        auto snapshotPath = snapshotFile.path().string();
+        auto name = std::string{"tconf-compile"};
+        char *argv[] = {name.data(), configPath.data(), snapshotPath.data()};
+
+        REQUIRE_EQ(tconf::binary::compile_main<TestCfg>(3, argv), 0);
+        REQUIRE_EQ(reader.read_snapshot_file<TestCfg>(snapshotFile.path()).testInt, 42);
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_snapshot_file<OtherCfg>(snapshotFile.path());
+                },
+                [&](const tconf::ConfigError &) {});
+
+        // the config is checked against its type
+        REQUIRE_EQ(tconf::binary::compile_main<OtherCfg>(3, argv), 1);
+        REQUIRE_EQ(tconf::binary::compile_main<TestCfg>(2, argv), 2);
+    }
+
+} //namespace test_binary
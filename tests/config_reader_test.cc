@@ -0,0 +1,514 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/config.h"
+#include "tconf/config_reader.h"
+#include "tconf/json/json_parser.h"
+#include "tconf/short_macros.h"
+#include "tconf/yaml/parser.h"
+#include "turbo/files/filesystem.h"
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace test_config_reader {
+
+    struct TestCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testStr, std::string)();
+        TCONF_PARAM_LIST(testList, std::vector<int>)();
+    };
+
+    class TempFile {
+    public:
+        TempFile(const std::string &name, const std::string &content)
+                : path_{turbo::filesystem::temp_directory_path() / name} {
+            auto stream = std::ofstream{path_, std::ios_base::binary};
+            stream << content;
+        }
+
+        ~TempFile() {
+            auto error = std::error_code{};
+            turbo::filesystem::remove(path_, error);
+        }
+
+        const turbo::filesystem::path &path() const {
+            return path_;
+        }
+
+    private:
+        turbo::filesystem::path path_;
+    };
+
+    TEST_CASE("TestConfigReader, ReadFile") {
+        auto reader = tconf::ConfigReader{};
+        {
+            auto file = TempFile{"tconf_test_config.json", R"({"testInt": "5", "testStr": "Hello", "testList": ["1", "2"]})"};
+            auto cfg = reader.read_json_file<TestCfg>(file.path());
+            REQUIRE_EQ(cfg.testInt, 5);
+            REQUIRE_EQ(cfg.testStr, "Hello");
+            REQUIRE_EQ(cfg.testList, (std::vector<int>{1, 2}));
+        }
+        {
+            auto file = TempFile{"tconf_test_config.yaml", "testInt: 5\ntestStr: \"Hello\"\ntestList: [1, 2]\n"};
+            auto cfg = reader.read_yaml_file<TestCfg>(file.path());
+            REQUIRE_EQ(cfg.testInt, 5);
+            REQUIRE_EQ(cfg.testStr, "Hello");
+            REQUIRE_EQ(cfg.testList, (std::vector<int>{1, 2}));
+        }
+        {
+            auto file = TempFile{"tconf_test_config.ini", "testInt = 5\ntestStr = Hello\ntestList = [1, 2]\n"};
+            auto cfg = reader.read_ini_file<TestCfg>(file.path());
+            REQUIRE_EQ(cfg.testInt, 5);
+            REQUIRE_EQ(cfg.testStr, "Hello");
+            REQUIRE_EQ(cfg.testList, (std::vector<int>{1, 2}));
+        }
+    }
+
+    TEST_CASE("TestConfigReader, ReadEmptyFile") {
+        auto reader = tconf::ConfigReader{};
+        auto file = TempFile{"tconf_test_empty_config.yaml", ""};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_yaml_file<TestCfg>(file.path());
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "[line:1, column:1] Root node: Parameter 'testInt' is missing.");
+                });
+    }
+
+    TEST_CASE("TestConfigReader, ReadMissingFile") {
+        auto reader = tconf::ConfigReader{};
+        const auto path = turbo::filesystem::temp_directory_path() / "tconf_test_missing_config.json";
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json_file<TestCfg>(path);
+                },
+                [&](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Config file " + path.string() + " doesn't exist");
+                });
+    }
+
+    struct TestOtherCfg : public tconf::Config {
+        TCONF_PARAM(testDouble, double);
+    };
+
+    TEST_CASE("TestConfigReader, ReadManyFiles") {
+        auto reader = tconf::ConfigReader{};
+        auto files = std::vector<TempFile>{};
+        auto paths = std::vector<turbo::filesystem::path>{};
+        files.reserve(8);
+        for (auto i = 0; i < 8; ++i) {
+            const auto &file = files.emplace_back(
+                    "tconf_test_config_" + std::to_string(i) + ".yaml",
+                    "testInt: " + std::to_string(i) + "\n");
+            paths.push_back(file.path());
+        }
+        auto cfgs = reader.read_many<TestCfg, tconf::yaml::Parser>(paths, 3);
+        REQUIRE_EQ(cfgs.size(), 8);
+        for (auto i = 0; i < 8; ++i)
+            REQUIRE_EQ(cfgs.at(i).testInt, i);
+
+        auto [cfg, otherCfg] = reader.read_files<tconf::yaml::Parser, TestCfg, TestOtherCfg>(
+                {files.at(1).path(), TempFile{"tconf_test_other_config.yaml", "testDouble: 1.5\n"}.path()});
+        REQUIRE_EQ(cfg.testInt, 1);
+        REQUIRE_EQ(otherCfg.testDouble, 1.5);
+    }
+
+    TEST_CASE("TestConfigReader, ReadManyFilesErrors") {
+        auto reader = tconf::ConfigReader{};
+        auto validFile = TempFile{"tconf_test_valid_config.json", R"({"testInt": 1})"};
+        auto invalidFile = TempFile{"tconf_test_invalid_config.json", R"({"testInt": "x"})"};
+        const auto missingPath = turbo::filesystem::temp_directory_path() / "tconf_test_missing_config.json";
+        assert_exception<tconf::ConfigFilesError>(
+                [&] {
+                    reader.read_many<TestCfg, tconf::JsonParser>({missingPath, validFile.path(), invalidFile.path()});
+                },
+                [&](const tconf::ConfigFilesError &error) {
+                    REQUIRE_EQ(error.errors().size(), 2);
+                    REQUIRE_EQ(error.errors().at(0).file, missingPath.string());
+                    REQUIRE_EQ(error.errors().at(1).file, invalidFile.path().string());
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Couldn't read config files:\n" + missingPath.string() + ": Config file " +
+                                    missingPath.string() + " doesn't exist\n" + invalidFile.path().string() +
+                                    ": Couldn't set parameter 'testInt' value from 'x'");
+                });
+    }
+
+    class SeekingParser : public tconf::IParser {
+    public:
+        tconf::TreeNode parse(std::istream &stream) override {
+            stream.seekg(0, std::ios_base::end);
+            const auto size = stream.tellg();
+            stream.seekg(5);
+            auto value = std::string{};
+            stream >> value;
+
+            auto tree = tconf::makeTreeRoot();
+            tree.asItem().addParam("testInt", std::to_string(static_cast<int>(size)));
+            tree.asItem().addParam("testStr", value);
+            return tree;
+        }
+    };
+
+    TEST_CASE("TestConfigReader, ParseBufferAsStream") {
+        auto reader = tconf::ConfigReader{};
+        auto parser = SeekingParser{};
+        auto cfg = reader.read<TestCfg>(std::string{"skip Hello"}, parser);
+        REQUIRE_EQ(cfg.testInt, 10);
+        REQUIRE_EQ(cfg.testStr, "Hello");
+    }
+
+    struct TestNodeCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+    };
+
+    struct TestTreeCfg : public tconf::Config {
+        TCONF_NODE(testNode, TestNodeCfg);
+        TCONF_NODE_LIST(testNodeList, std::vector<TestNodeCfg>);
+        TCONF_PARAM_LIST(testList, std::vector<int>);
+    };
+
+    class EventParser : public tconf::IParser {
+    public:
+        tconf::TreeNode parse(std::istream &) override {
+            throw tconf::ConfigError{"Parsing into a tree isn't expected"};
+        }
+
+        void visit(const char *, std::size_t, tconf::ITreeVisitor &visitor) override {
+            visitor.beginNode("testNode", {1, 1});
+            visitor.param("testInt", "1", {2, 3});
+            visitor.endNode();
+            visitor.beginNodeList("testNodeList", {3, 1});
+            for (auto value: {"2", "3"}) {
+                visitor.beginListElement({4, 3});
+                visitor.param("testInt", value, {4, 5});
+                visitor.endNode();
+            }
+            visitor.endNode();
+            const auto values = std::vector<tconf::TreeValue>{"4", "5"};
+            visitor.paramList("testList", {values.data(), values.size()}, {5, 1});
+        }
+    };
+
+    TEST_CASE("TestConfigReader, ReadParserEvents") {
+        auto reader = tconf::ConfigReader{};
+        auto parser = EventParser{};
+        auto cfg = reader.read<TestTreeCfg>(std::string{}, parser);
+        REQUIRE_EQ(cfg.testNode.testInt, 1);
+        REQUIRE_EQ(cfg.testNodeList.size(), 2);
+        REQUIRE_EQ(cfg.testNodeList.at(0).testInt, 2);
+        REQUIRE_EQ(cfg.testNodeList.at(1).testInt, 3);
+        REQUIRE_EQ(cfg.testList, (std::vector<int>{4, 5}));
+    }
+
+    TEST_CASE("TestConfigReader, ReadJsonDuplicateParam") {
+        auto reader = tconf::ConfigReader{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<TestCfg>(R"({"testInt": "5", "testInt": "6"})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Parameter 'testInt' already exists");
+                });
+    }
+
+    struct TestTypedCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testDouble, double);
+        TCONF_PARAM(testBool, bool);
+        TCONF_PARAM(testStr, std::string);
+        TCONF_PARAM_LIST(testList, std::vector<double>);
+    };
+
+    TEST_CASE("TestConfigReader, ReadJsonTypedValues") {
+        auto reader = tconf::ConfigReader{};
+        auto cfg = reader.read_json<TestTypedCfg>(
+                R"({"testInt": -5, "testDouble": 1, "testBool": true, "testStr": 2.5, "testList": [1, 2.5, "3"]})");
+        REQUIRE_EQ(cfg.testInt, -5);
+        REQUIRE_EQ(cfg.testDouble, 1.0);
+        REQUIRE_EQ(cfg.testBool, true);
+        REQUIRE_EQ(cfg.testStr, "2.5");
+        REQUIRE_EQ(cfg.testList, (std::vector<double>{1.0, 2.5, 3.0}));
+
+        auto input = std::istringstream{R"({"testInt": -7, "testList": [false]})"};
+        const auto tree = tconf::JsonParser{}.parse(input);
+        REQUIRE(tree.asItem().param("testInt").typedValue().type() == tconf::TreeValue::Type::Integer);
+        REQUIRE_EQ(tree.asItem().param("testInt").value(), "-7");
+        REQUIRE_EQ(tree.asItem().param("testList").valueList(), (std::vector<std::string>{"false"}));
+    }
+
+    TEST_CASE("TestConfigReader, ReadJsonTypedValueErrors") {
+        auto reader = tconf::ConfigReader{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<TestCfg>(R"({"testInt": 3000000000})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Couldn't set parameter 'testInt' value from '3000000000': "
+                            "value is out of range [-2147483648, 2147483647]");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<TestCfg>(R"({"testInt": 1.5})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Couldn't set parameter 'testInt' value from '1.5'");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<TestCfg>(R"({"testInt": null})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Parameter 'testInt': null values aren't supported");
+                });
+    }
+
+    struct TestCopyElementCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testStr, std::string);
+        TCONF_PARAM_LIST(testList, std::vector<int>);
+        TCONF_NODE_LIST(testNodeList, std::vector<TestCfg>)();
+    };
+
+    struct TestCopyListCfg : public tconf::Config {
+        TCONF_COPY_NODE_LIST(testCopyList, std::vector<TestCopyElementCfg>);
+    };
+
+    TEST_CASE("TestConfigReader, ReadJsonCopyNodeList") {
+        auto reader = tconf::ConfigReader{};
+        auto cfg = reader.read_json<TestCopyListCfg>(R"({"testCopyList": [
+            {"testInt": 1, "testStr": "a", "testList": [1, 2], "testNodeList": [{"testInt": 10}]},
+            {"testInt": 2},
+            {"testStr": "c", "testNodeList": [{"testInt": 30}, {"testInt": 31}]},
+            {"testList": [4]}
+        ]})");
+        REQUIRE_EQ(cfg.testCopyList.size(), 4);
+        for (auto i = 0; i < 4; ++i) {
+            const auto &element = cfg.testCopyList.at(i);
+            REQUIRE_EQ(element.testInt, i == 1 ? 2 : 1);
+            REQUIRE_EQ(element.testStr, i == 2 ? "c" : "a");
+            REQUIRE_EQ(element.testList, (i == 3 ? std::vector<int>{4} : std::vector<int>{1, 2}));
+        }
+        REQUIRE_EQ(cfg.testCopyList.at(1).testNodeList.size(), 1);
+        REQUIRE_EQ(cfg.testCopyList.at(1).testNodeList.at(0).testInt, 10);
+        REQUIRE_EQ(cfg.testCopyList.at(2).testNodeList.size(), 2);
+        REQUIRE_EQ(cfg.testCopyList.at(2).testNodeList.at(1).testInt, 31);
+        REQUIRE_EQ(cfg.testCopyList.at(3).testNodeList.size(), 1);
+    }
+
+    struct TestParallelListCfg : public tconf::Config {
+        TCONF_NODE_LIST(testNodeList, std::vector<TestCfg>)().parallel(4);
+        TCONF_COPY_NODE_LIST(testCopyList, std::deque<TestCfg>)().parallel(4);
+    };
+
+    std::string makeParallelListJson(int count, int invalidIndex = -1) {
+        auto json = std::string{R"({"testCopyList": [{"testInt": 0, "testStr": "copied"}], "testNodeList": [)"};
+        for (auto i = 0; i < count; ++i) {
+            if (i)
+                json += ",";
+            json += R"({"testInt": )" + (i == invalidIndex ? std::string{R"("x")"} : std::to_string(i)) + "}";
+        }
+        json += "]}";
+        return json;
+    }
+
+    TEST_CASE("TestConfigReader, ReadJsonParallelNodeList") {
+        auto reader = tconf::ConfigReader{};
+        {
+            auto cfg = reader.read_json<TestParallelListCfg>(makeParallelListJson(1000));
+            REQUIRE_EQ(cfg.testNodeList.size(), 1000);
+            for (auto i = 0; i < 1000; ++i)
+                REQUIRE_EQ(cfg.testNodeList.at(i).testInt, i);
+            REQUIRE_EQ(cfg.testCopyList.size(), 1);
+
+            // the lists of a parsed tree are loaded without collecting their copies
+            auto input = std::istringstream{makeParallelListJson(1000)};
+            const auto tree = tconf::JsonParser{}.parse(input);
+            auto treeCfg = reader.read<TestParallelListCfg>(tree);
+            REQUIRE_EQ(treeCfg.testNodeList.size(), 1000);
+            REQUIRE_EQ(treeCfg.testNodeList.at(999).testInt, 999);
+            REQUIRE_EQ(treeCfg.testCopyList.at(0).testStr, "copied");
+        }
+        {
+            auto json = std::string{R"({"testCopyList": [{"testInt": -1, "testStr": "copied"})"};
+            for (auto i = 1; i < 500; ++i)
+                json += R"(, {"testInt": )" + std::to_string(i) + "}";
+            json += "]}";
+            auto cfg = reader.read_json<TestParallelListCfg>(json);
+            REQUIRE(cfg.testNodeList.empty());
+            REQUIRE_EQ(cfg.testCopyList.size(), 500);
+            REQUIRE_EQ(cfg.testCopyList.at(0).testInt, -1);
+            for (auto i = 1; i < 500; ++i) {
+                REQUIRE_EQ(cfg.testCopyList.at(i).testInt, i);
+                REQUIRE_EQ(cfg.testCopyList.at(i).testStr, "copied");
+            }
+        }
+    }
+
+    TEST_CASE("TestConfigReader, ReadJsonParallelNodeListError") {
+        auto reader = tconf::ConfigReader{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    auto json = makeParallelListJson(1000, 900);
+                    json.replace(json.find(R"({"testInt": 100})"), 16, R"({"testStr": "a"})");
+                    reader.read_json<TestParallelListCfg>(json);
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Node list 'testNodeList': Parameter 'testInt' is missing.");
+                });
+    }
+
+    struct PmrItemCfg : public tconf::Config {
+        TCONF_PARAM(name, std::pmr::string);
+    };
+
+    struct PmrCfg : public tconf::Config {
+        TCONF_PARAM(testStr, std::pmr::string);
+        TCONF_PARAM(testOptStr, std::optional<std::pmr::string>);
+        TCONF_PARAM_LIST(testList, std::pmr::vector<std::pmr::string>);
+        TCONF_NODE_LIST(testNodeList, std::pmr::vector<PmrItemCfg>);
+        using PmrMap = std::pmr::map<std::pmr::string, std::pmr::string>;
+        TCONF_DICT(testDict, PmrMap);
+    };
+
+    TEST_CASE("TestConfigReader, MemoryResource") {
+        const auto content = std::string{R"({
+            "testStr": "a string that doesn't fit the small string buffer",
+            "testOptStr": "another string that doesn't fit the small string buffer",
+            "testList": ["a", "b"],
+            "testNodeList": [{"name": "first"}, {"name": "second"}],
+            "testDict": {"foo": "bar"}
+        })"};
+        auto reader = tconf::ConfigReader{};
+        auto parser = tconf::JsonParser{};
+        auto arena = std::pmr::monotonic_buffer_resource{};
+        const auto cfg = reader.read<PmrCfg>(content, parser, &arena);
+        REQUIRE_EQ(cfg.testStr, "a string that doesn't fit the small string buffer");
+        REQUIRE_EQ(cfg.testStr.get_allocator().resource(), &arena);
+        REQUIRE_EQ(cfg.testOptStr->get_allocator().resource(), &arena);
+        REQUIRE_EQ(cfg.testList.size(), 2);
+        REQUIRE_EQ(cfg.testList.get_allocator().resource(), &arena);
+        REQUIRE_EQ(cfg.testList.at(1), "b");
+        REQUIRE_EQ(cfg.testList.at(1).get_allocator().resource(), &arena);
+        REQUIRE_EQ(cfg.testNodeList.get_allocator().resource(), &arena);
+        REQUIRE_EQ(cfg.testNodeList.at(1).name, "second");
+        REQUIRE_EQ(cfg.testNodeList.at(1).name.get_allocator().resource(), &arena);
+        REQUIRE_EQ(cfg.testDict.get_allocator().resource(), &arena);
+        REQUIRE_EQ(cfg.testDict.at("foo"), "bar");
+        REQUIRE_EQ(cfg.testDict.begin()->first.get_allocator().resource(), &arena);
+
+        const auto defaultCfg = reader.read<PmrCfg>(content, parser);
+        REQUIRE_EQ(defaultCfg.testStr, cfg.testStr);
+        REQUIRE_EQ(defaultCfg.testStr.get_allocator().resource(), std::pmr::get_default_resource());
+        REQUIRE_EQ(defaultCfg.testDict.get_allocator().resource(), std::pmr::get_default_resource());
+    }
+
+    struct DictItemCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testStr, std::string)();
+    };
+
+    struct DictCfg : public tconf::Config {
+        using ItemMap = std::map<std::string, DictItemCfg>;
+        TCONF_DICT(testNodeDict, ItemMap);
+        using HashItemMap = std::unordered_map<std::string, DictItemCfg>;
+        TCONF_DICT(testHashNodeDict, std::optional<HashItemMap>);
+        using HashMap = std::unordered_map<std::string, int>;
+        TCONF_DICT(testHashDict, HashMap)();
+    };
+
+    TEST_CASE("TestConfigReader, ReadConfigDictionary") {
+        const auto content = std::string{R"({
+            "testNodeDict": {"b": {"testInt": 2}, "a": {"testInt": 1, "testStr": "first"}, "c": {"testInt": 3}},
+            "testHashNodeDict": {"x": {"testInt": 10}},
+            "testHashDict": {"one": 1, "two": 2}
+        })"};
+        auto reader = tconf::ConfigReader{};
+        const auto check = [](const DictCfg &cfg) {
+            REQUIRE_EQ(cfg.testNodeDict.size(), 3);
+            REQUIRE_EQ(cfg.testNodeDict.begin()->first, "a");
+            REQUIRE_EQ(cfg.testNodeDict.at("a").testInt, 1);
+            REQUIRE_EQ(cfg.testNodeDict.at("a").testStr, "first");
+            REQUIRE_EQ(cfg.testNodeDict.at("b").testInt, 2);
+            REQUIRE_EQ(cfg.testNodeDict.at("c").testInt, 3);
+            REQUIRE_EQ(cfg.testHashNodeDict->size(), 1);
+            REQUIRE_EQ(cfg.testHashNodeDict->at("x").testInt, 10);
+            REQUIRE_EQ(cfg.testHashDict.size(), 2);
+            REQUIRE_EQ(cfg.testHashDict.at("two"), 2);
+        };
+        check(reader.read_json<DictCfg>(content));
+
+        // the tree reports the sizes of its nodes and the hash dictionaries are pre-sized
+        auto input = std::istringstream{content};
+        const auto tree = tconf::JsonParser{}.parse(input);
+        const auto treeCfg = reader.read<DictCfg>(tree);
+        check(treeCfg);
+        REQUIRE(treeCfg.testHashDict.bucket_count() >= 2);
+    }
+
+    TEST_CASE("TestConfigReader, ReadConfigDictionaryErrors") {
+        auto reader = tconf::ConfigReader{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<DictCfg>(R"({"testNodeDict": {"a": {"testInt": 1}, "b": {"testStr": "x"}}})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Dictionary 'testNodeDict' element 'b': Parameter 'testInt' is missing.");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<DictCfg>(R"({"testNodeDict": {"a": 1}})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Dictionary 'testNodeDict': element 'a' must be a config node.");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<DictCfg>(R"({"testNodeDict": {"a": [{"testInt": 1}]}})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Dictionary 'testNodeDict': element 'a' can't be a list.");
+                });
+
+        auto parser = tconf::JsonParser{};
+        const auto result = reader.try_read<DictCfg>(
+                R"({"testNodeDict": {"a": {"testInt": "x"}, "b": {"testInt": 2}}, "testHashDict": {"one": 1}})",
+                parser);
+        REQUIRE(!result);
+        REQUIRE_EQ(result.errors().size(), 1);
+    }
+
+} //namespace test_config_reader
@@ -0,0 +1,176 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/config.h"
+#include "tconf/config_reader.h"
+#include "tconf/json/json_parser.h"
+#include "tconf/short_macros.h"
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test_config_update {
+
+    struct ItemCfg : public tconf::Config {
+        TCONF_PARAM(name, std::string);
+        TCONF_PARAM(weight, int)(1);
+    };
+
+    struct NestedCfg : public tconf::Config {
+        TCONF_PARAM(testStr, std::string);
+        TCONF_PARAM(testInt, int)(0);
+    };
+
+    struct TestCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int).ensure(
+                [](int value) {
+                    if (value < 0)
+                        throw tconf::ValidationError{"value can't be negative."};
+                });
+        TCONF_PARAM(testDouble, double)(0.0);
+        TCONF_PARAM_LIST(testList, std::vector<int>)();
+        TCONF_NODE(nested, NestedCfg);
+        TCONF_NODE_LIST(items, std::vector<ItemCfg>)();
+        using StringMap = std::map<std::string, std::string>;
+        TCONF_DICT(testDict, StringMap)();
+    };
+
+    tconf::TreeNode parse(const std::string &str) {
+        auto input = std::istringstream{str};
+        auto parser = tconf::JsonParser{};
+        return parser.parse(input);
+    }
+
+    const auto baseConfig = std::string{R"({
+        "testInt": 1,
+        "testDouble": 1.5,
+        "testList": [1, 2],
+        "nested": {"testStr": "Hello", "testInt": 5},
+        "items": [{"name": "first"}, {"name": "second", "weight": 2}],
+        "testDict": {"a": "1"}
+    })"};
+
+    TEST_CASE("TestConfigUpdate, Unchanged")
+    {
+        auto reader = tconf::ConfigReader{};
+        const auto previousTree = parse(baseConfig);
+        auto cfg = reader.read<TestCfg>(previousTree);
+        // the fields of the unchanged subtrees aren't loaded again
+        cfg.nested.testInt = 42;
+
+        const auto tree = parse(baseConfig);
+        REQUIRE_EQ(tree.contentHash(), previousTree.contentHash());
+        const auto changes = reader.update(cfg, previousTree, tree);
+        REQUIRE(changes.empty());
+        REQUIRE_EQ(cfg.nested.testInt, 42);
+    }
+
+    TEST_CASE("TestConfigUpdate, ChangedFields")
+    {
+        auto reader = tconf::ConfigReader{};
+        const auto previousTree = parse(baseConfig);
+        auto cfg = reader.read<TestCfg>(previousTree);
+        cfg.items[0].weight = 42;
+
+        const auto tree = parse(R"({
+            "testInt": 2,
+            "testDouble": 1.5,
+            "testList": [1, 2, 3],
+            "nested": {"testStr": "World", "testInt": 5},
+            "items": [{"name": "first"}, {"name": "third", "weight": 2}],
+            "testDict": {"a": "1", "b": "2"}
+        })");
+        const auto changes = reader.update(cfg, previousTree, tree);
+        REQUIRE(!changes.isFullReload);
+        REQUIRE_EQ(changes.fields,
+                   (std::vector<std::string>{"testInt", "testList", "nested.testStr", "items.1.name", "testDict"}));
+        REQUIRE_EQ(cfg.testInt, 2);
+        REQUIRE_EQ(cfg.testDouble, 1.5);
+        REQUIRE_EQ(cfg.testList, (std::vector<int>{1, 2, 3}));
+        REQUIRE_EQ(cfg.nested.testStr, "World");
+        REQUIRE_EQ(cfg.nested.testInt, 5);
+        REQUIRE_EQ(cfg.items.size(), 2);
+        REQUIRE_EQ(cfg.items[0].weight, 42);
+        REQUIRE_EQ(cfg.items[1].name, "third");
+        REQUIRE_EQ(cfg.testDict, (std::map<std::string, std::string>{{"a", "1"}, {"b", "2"}}));
+    }
+
+    TEST_CASE("TestConfigUpdate, ResizedNodeList")
+    {
+        auto reader = tconf::ConfigReader{};
+        const auto previousTree = parse(baseConfig);
+        auto cfg = reader.read<TestCfg>(previousTree);
+
+        const auto tree = parse(R"({
+            "testInt": 1,
+            "testDouble": 1.5,
+            "testList": [1, 2],
+            "nested": {"testStr": "Hello", "testInt": 5},
+            "items": [{"name": "first"}],
+            "testDict": {"a": "1"}
+        })");
+        const auto changes = reader.update(cfg, previousTree, tree);
+        REQUIRE_EQ(changes.fields, (std::vector<std::string>{"items"}));
+        REQUIRE_EQ(cfg.items.size(), 1);
+        REQUIRE_EQ(cfg.items[0].name, "first");
+    }
+
+    TEST_CASE("TestConfigUpdate, RemovedField")
+    {
+        auto reader = tconf::ConfigReader{};
+        const auto previousTree = parse(baseConfig);
+        auto cfg = reader.read<TestCfg>(previousTree);
+
+        const auto tree = parse(R"({
+            "testInt": 1,
+            "testList": [1, 2],
+            "nested": {"testStr": "Hello"},
+            "items": [{"name": "first"}, {"name": "second", "weight": 2}],
+            "testDict": {"a": "1"}
+        })");
+        const auto changes = reader.update(cfg, previousTree, tree);
+        REQUIRE(changes.isFullReload);
+        REQUIRE(changes.fields.empty());
+        REQUIRE_EQ(cfg.testDouble, 0.0);
+        REQUIRE_EQ(cfg.nested.testInt, 0);
+    }
+
+    TEST_CASE("TestConfigUpdate, ValidationError")
+    {
+        auto reader = tconf::ConfigReader{};
+        const auto previousTree = parse(baseConfig);
+        auto cfg = reader.read<TestCfg>(previousTree);
+
+        const auto tree = parse(R"({
+            "testInt": -1,
+            "testDouble": 1.5,
+            "testList": [1, 2],
+            "nested": {"testStr": "Hello", "testInt": 5},
+            "items": [{"name": "first"}, {"name": "second", "weight": 2}],
+            "testDict": {"a": "1"}
+        })");
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.update(cfg, previousTree, tree);
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()},
+                               "Parameter 'testInt': value can't be negative.");
+                });
+    }
+
+}
@@ -0,0 +1,55 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/detail/field_index.h"
+#include <string>
+
+namespace test_field_index {
+
+    TEST_CASE("TestFieldIndex, Empty") {
+        auto index = tconf::detail::FieldIndex{};
+        REQUIRE_EQ(index.find("test"), tconf::detail::FieldIndex::npos);
+        index.build();
+        REQUIRE_EQ(index.find("test"), tconf::detail::FieldIndex::npos);
+    }
+
+    TEST_CASE("TestFieldIndex, WideIndex") {
+        auto index = tconf::detail::FieldIndex{};
+        for (auto i = 0; i < 500; ++i)
+            index.insert("field" + std::to_string(i), static_cast<std::size_t>(i) * 2);
+        index.build();
+
+        for (auto i = 0; i < 500; ++i)
+            REQUIRE_EQ(index.find("field" + std::to_string(i)), static_cast<std::size_t>(i) * 2);
+        REQUIRE_EQ(index.find("field500"), tconf::detail::FieldIndex::npos);
+        REQUIRE_EQ(index.find(""), tconf::detail::FieldIndex::npos);
+    }
+
+    TEST_CASE("TestFieldSet, Basic") {
+        for (auto size: {std::size_t{0}, std::size_t{3}, std::size_t{64}, std::size_t{300}}) {
+            auto fields = tconf::detail::FieldSet{size};
+            REQUIRE(fields.all() == (size == 0));
+            for (auto i = std::size_t{}; i < size; ++i) {
+                REQUIRE(!fields.test(i));
+                REQUIRE(!fields.all());
+                fields.set(i);
+                REQUIRE(fields.test(i));
+            }
+            REQUIRE(fields.all());
+        }
+    }
+
+} //namespace test_field_index
@@ -16,6 +16,7 @@
 #include "assert_exception.h"
 #include "tconf/ini/parser.h"
 #include "tconf/errors.h"
+#include <string>
 
 
 namespace test_nodelistparser {
@@ -219,4 +220,65 @@ namespace test_nodelistparser {
         }
     }
 
+    TEST_CASE("TestNodeListParser, ManyElements")
+    {
+        auto config = std::string{};
+        for (auto i = 0; i < 12; ++i)
+            config += "[testNodes." + std::to_string(i) + "]\ntestInt = " + std::to_string(i) + "\n";
+        auto result = parse(config);
+
+        auto &testNodes = result.asItem().node("testNodes").asList();
+        REQUIRE_EQ(testNodes.count(), 12);
+        for (auto i = 0; i < 12; ++i)
+            REQUIRE_EQ(testNodes.node(i).asItem().param("testInt").value(), std::to_string(i));
+    }
+
+    TEST_CASE("TestNodeListParser, ContinuedElement")
+    {
+        auto result = parse(R"(
+    [testNodes.0]
+      testInt = 3
+    [testNodes.1]
+      testInt = 2
+    [testNodes.0.nested]
+      testStr = Hello
+    )");
+
+        auto &testNodes = result.asItem().node("testNodes").asList();
+        REQUIRE_EQ(testNodes.count(), 2);
+        auto &nodeData = testNodes.node(0).asItem();
+        REQUIRE_EQ(nodeData.param("testInt").value(), "3");
+        REQUIRE_EQ(nodeData.node("nested").asItem().param("testStr").value(), "Hello");
+    }
+
+    TEST_CASE("TestNodeListParser, IndexMismatchError")
+    {
+        assert_exception<tconf::ConfigError>([&] {
+            parse(R"(
+    [testNodes.0]
+      testInt = 3
+    [testNodes.2]
+      testInt = 2
+    )");
+        }, [](const tconf::ConfigError &e) {
+            REQUIRE_EQ(std::string{e.what()},
+                       "[line:4, column:5] Section array 'testNodes' index mismatch: expected 1, but got 2");
+        });
+    }
+
+    TEST_CASE("TestNodeListParser, NotIndexedElementError")
+    {
+        assert_exception<tconf::ConfigError>([&] {
+            parse(R"(
+    [testNodes.0]
+      testInt = 3
+    [testNodes]
+      testInt = 2
+    )");
+        }, [](const tconf::ConfigError &e) {
+            REQUIRE_EQ(std::string{e.what()},
+                       "[line:4, column:5] Section 'testNodes' is a node list, its elements must be indexed");
+        });
+    }
+
 }
@@ -119,4 +119,58 @@ namespace test_nodeparser {
         REQUIRE_EQ(bNode.param("testInt").value(), "9");
     }
 
+    TEST_CASE("TestNodeParser, Comments")
+    {
+        auto result = parse(R"(
+    ; comment
+    foo = 5 # comment
+    [a] ; comment
+      testStr = Hello \; world
+    )");
+
+        auto &tree = result.asItem();
+        REQUIRE_EQ(tree.paramsCount(), 1);
+        REQUIRE_EQ(tree.param("foo").value(), "5");
+        REQUIRE_EQ(tree.node("a").asItem().param("testStr").value(), "Hello ; world");
+    }
+
+    TEST_CASE("TestNodeParser, SectionNotClosedError")
+    {
+        assert_exception<tconf::ConfigError>([&] {
+            parse(R"(
+    foo = 5
+      [a
+    )");
+        }, [](const tconf::ConfigError &e) {
+            REQUIRE_EQ(std::string{e.what()}, "[line:3, column:7] Section isn't closed");
+        });
+    }
+
+    TEST_CASE("TestNodeParser, MissingSeparatorError")
+    {
+        assert_exception<tconf::ConfigError>([&] {
+            parse(R"(
+    [a]
+      foo
+    )");
+        }, [](const tconf::ConfigError &e) {
+            REQUIRE_EQ(std::string{e.what()}, "[line:3, column:7] Parameter 'foo' must be followed by '=' and a value");
+        });
+    }
+
+    TEST_CASE("TestNodeParser, DuplicateParamError")
+    {
+        assert_exception<tconf::ConfigError>([&] {
+            parse(R"(
+    [a]
+      foo = 1
+    [b]
+    [a]
+      foo = 2
+    )");
+        }, [](const tconf::ConfigError &e) {
+            REQUIRE_EQ(std::string{e.what()}, "[line:6, column:7] Parameter 'foo' already exists");
+        });
+    }
+
 }
\ No newline at end of file
@@ -146,4 +146,14 @@ namespace test_nodeparser {
                 });
     }
 
+    TEST_CASE("TestNodeParser, ParseBuffer") {
+        const auto content = std::string{R"({"foo": "5", "a": {"testInt": "10"}})"};
+        auto parser = tconf::JsonParser{};
+        const auto result = parser.parse(content.data(), content.size());
+
+        auto &tree = result.asItem();
+        REQUIRE_EQ(tree.param("foo").value(), "5");
+        REQUIRE_EQ(tree.node("a").asItem().param("testInt").value(), "10");
+    }
+
 } //namespace test_nodeparser
\ No newline at end of file
@@ -0,0 +1,220 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/config.h"
+#include "tconf/config_reader.h"
+#include "tconf/json/json_parser.h"
+#include "tconf/lazy.h"
+#include "tconf/yaml/parser.h"
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_lazy {
+
+    struct EndpointCfg : public tconf::Config {
+        TCONF_PARAM(host, std::string);
+        TCONF_PARAM(port, int)(80);
+    };
+
+    struct ReportCfg : public tconf::Config {
+        TCONF_PARAM(title, std::string);
+        TCONF_PARAM(pageCount, int);
+        TCONF_NODE(endpoint, EndpointCfg);
+        TCONF_NODE_LIST(extraEndpoints, std::vector<EndpointCfg>)();
+    };
+
+    struct TestCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testLazyInt, tconf::lazy_param<int>)(7);
+        TCONF_NODE(report, tconf::lazy<ReportCfg>);
+        TCONF_NODE(optionalReport, tconf::lazy<ReportCfg>)();
+    };
+
+    struct CatalogCfg : public tconf::Config {
+        using EndpointMap = std::map<std::string, EndpointCfg>;
+        TCONF_NODE_LIST(endpoints, std::vector<EndpointCfg>)();
+        TCONF_COPY_NODE_LIST(copyEndpoints, std::vector<EndpointCfg>)();
+        TCONF_DICT(endpointMap, EndpointMap)();
+    };
+
+    struct CatalogHolderCfg : public tconf::Config {
+        TCONF_NODE(catalog, tconf::lazy<CatalogCfg>);
+    };
+
+    tconf::TreeNode parseYaml(const std::string &content) {
+        auto stream = std::istringstream{content};
+        return tconf::yaml::Parser{}.parse(stream);
+    }
+
+    TEST_CASE("TestLazy, LoadOnAccess") {
+        auto reader = tconf::ConfigReader{};
+        auto cfg = reader.read_json<TestCfg>(R"({
+            "testInt": 1,
+            "testLazyInt": "2",
+            "report": {"title": "Daily", "pageCount": 3, "endpoint": {"host": "localhost"}}
+        })");
+        REQUIRE_EQ(cfg.testInt, 1);
+        REQUIRE(!cfg.testLazyInt.is_loaded());
+        REQUIRE_EQ(cfg.testLazyInt.get(), 2);
+        REQUIRE(cfg.testLazyInt.is_loaded());
+
+        REQUIRE(!cfg.report.is_loaded());
+        auto reportCopy = cfg.report;
+        REQUIRE_EQ(cfg.report->title, "Daily");
+        REQUIRE_EQ(cfg.report->pageCount, 3);
+        REQUIRE_EQ(cfg.report->endpoint.host, "localhost");
+        REQUIRE_EQ(cfg.report->endpoint.port, 80);
+        REQUIRE(cfg.report.is_loaded());
+        // the copies share the loaded config
+        REQUIRE(reportCopy.is_loaded());
+        REQUIRE_EQ(&reportCopy.get(), &cfg.report.get());
+
+        REQUIRE(cfg.optionalReport.is_loaded());
+        REQUIRE_EQ(cfg.optionalReport->title, "");
+    }
+
+    TEST_CASE("TestLazy, LoadFromTree") {
+        auto reader = tconf::ConfigReader{};
+        const auto tree = parseYaml(R"(
+testInt: 1
+report:
+  title: Daily
+  pageCount: 3
+  endpoint:
+    host: localhost
+    port: 8080
+  extraEndpoints:
+    - host: backup
+)");
+        auto cfg = reader.read<TestCfg>(tree);
+        REQUIRE_EQ(cfg.testLazyInt.get(), 7);
+        REQUIRE_EQ(cfg.report->endpoint.port, 8080);
+        REQUIRE_EQ(cfg.report->extraEndpoints.size(), 1);
+        REQUIRE_EQ(cfg.report->extraEndpoints.at(0).host, "backup");
+    }
+
+    TEST_CASE("TestLazy, ConversionErrorOnAccess") {
+        auto reader = tconf::ConfigReader{};
+        auto cfg = reader.read_json<TestCfg>(R"({
+            "testInt": 1,
+            "testLazyInt": "two",
+            "report": {"title": "Daily", "pageCount": "three", "endpoint": {"host": "localhost"}}
+        })");
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    cfg.testLazyInt.get();
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Couldn't set parameter 'testLazyInt' value from 'two'");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    cfg.report.get();
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Couldn't set parameter 'pageCount' value from 'three'");
+                });
+        REQUIRE(!cfg.report.is_loaded());
+    }
+
+    TEST_CASE("TestLazy, MissingFieldsAreCheckedOnRead") {
+        auto reader = tconf::ConfigReader{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<TestCfg>(R"({"testInt": 1, "report": {"title": "Daily", "endpoint": {}}})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Node 'report': Parameter 'pageCount' is missing.");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read<TestCfg>(parseYaml("testInt: 1\nreport:\n  title: Daily\n  pageCount: 3\n  endpoint:\n    port: 1\n"));
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Node 'endpoint': Parameter 'host' is missing.");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_json<TestCfg>(R"({"testInt": 1})");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "[line:1, column:1] Root node: Node 'report' is missing.");
+                });
+    }
+
+    TEST_CASE("TestLazy, MissingFieldsOfElementsAreCheckedOnRead") {
+        auto reader = tconf::ConfigReader{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read<CatalogHolderCfg>(
+                            parseYaml("catalog:\n  endpoints:\n    - host: a\n    - port: 1\n"));
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Node list 'endpoints': Parameter 'host' is missing.");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read<CatalogHolderCfg>(
+                            parseYaml("catalog:\n  copyEndpoints:\n    - port: 1\n    - port: 2\n"));
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Node list 'copyEndpoints': Parameter 'host' is missing.");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read<CatalogHolderCfg>(parseYaml(
+                            "catalog:\n  endpointMap:\n    main:\n      host: a\n    spare:\n      port: 1\n"));
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "Dictionary 'endpointMap' element 'spare': Parameter 'host' is missing.");
+                });
+
+        // the following elements of a copy list take the missing fields from the first one
+        auto cfg = reader.read<CatalogHolderCfg>(
+                parseYaml("catalog:\n  copyEndpoints:\n    - host: a\n    - port: 2\n"));
+        REQUIRE_EQ(cfg.catalog.get().copyEndpoints.at(1).host, "a");
+        REQUIRE_EQ(cfg.catalog.get().copyEndpoints.at(1).port, 2);
+    }
+
+    TEST_CASE("TestLazy, ConcurrentAccess") {
+        auto reader = tconf::ConfigReader{};
+        auto cfg = reader.read_json<TestCfg>(R"({
+            "testInt": 1,
+            "report": {"title": "Daily", "pageCount": 3, "endpoint": {"host": "localhost"}}
+        })");
+        auto reports = std::vector<const ReportCfg *>(4);
+        auto threads = std::vector<std::thread>{};
+        for (auto i = std::size_t{}; i < reports.size(); ++i)
+            threads.emplace_back([&, i] {
+                reports[i] = &cfg.report.get();
+            });
+        for (auto &thread: threads)
+            thread.join();
+        for (auto report: reports)
+            REQUIRE_EQ(report, &cfg.report.get());
+        REQUIRE_EQ(cfg.report->pageCount, 3);
+    }
+
+} //namespace test_lazy
@@ -0,0 +1,66 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/detail/field_name.h"
+#include "tconf/detail/name_converter.h"
+#include <string>
+
+namespace test_name_converter {
+
+    using tconf::NameFormat;
+    using tconf::detail::NameConverter;
+
+    template<NameFormat nameFormat>
+    constexpr auto fixedName(std::string_view name) {
+        return NameConverter<nameFormat>::template fixedName<32>(name);
+    }
+
+    static_assert(fixedName<NameFormat::Original>("_fooBar_").view() == "fooBar");
+    static_assert(fixedName<NameFormat::SnakeCase>("fooBar").view() == "foo_bar");
+    static_assert(fixedName<NameFormat::CamelCase>("foo_bar").view() == "fooBar");
+    static_assert(fixedName<NameFormat::KebabCase>("foo_barBaz").view() == "foo-bar-baz");
+
+    struct Cfg {
+        int testParam;
+        int m_value_;
+    };
+
+    TEST_CASE("TestNameConverter, RuntimeConversion") {
+        REQUIRE_EQ(NameConverter<NameFormat::Original>::name("m_fooBar_"), "m_fooBar");
+        REQUIRE_EQ(NameConverter<NameFormat::SnakeCase>::name("FooBar"), "foo_bar");
+        REQUIRE_EQ(NameConverter<NameFormat::CamelCase>::name("foo_2bar"), "foo2Bar");
+        REQUIRE_EQ(NameConverter<NameFormat::KebabCase>::name("fooBar_baz"), "foo-bar-baz");
+    }
+
+    TEST_CASE("TestNameConverter, ReflectedNames") {
+        const auto &names = tconf::detail::ReflectedName<&Cfg::testParam>::names;
+        REQUIRE_EQ(names.original, "testParam");
+        REQUIRE_EQ(names.names[static_cast<int>(NameFormat::Original)], "testParam");
+        REQUIRE_EQ(names.names[static_cast<int>(NameFormat::SnakeCase)], "test_param");
+        REQUIRE_EQ(names.names[static_cast<int>(NameFormat::CamelCase)], "testParam");
+        REQUIRE_EQ(names.names[static_cast<int>(NameFormat::KebabCase)], "test-param");
+        REQUIRE_EQ(names.hashes[static_cast<int>(NameFormat::SnakeCase)], tconf::detail::fieldNameHash("test_param"));
+
+        auto fieldName = tconf::detail::reflectedFieldName<&Cfg::m_value_>();
+        auto expectedName = tconf::detail::FieldName{std::string{"m_value_"}};
+        for (auto nameFormat:
+                {NameFormat::Original, NameFormat::SnakeCase, NameFormat::CamelCase, NameFormat::KebabCase}) {
+            REQUIRE_EQ(fieldName.converted(nameFormat), expectedName.converted(nameFormat));
+            REQUIRE_EQ(fieldName.hash(nameFormat), expectedName.hash(nameFormat));
+        }
+    }
+
+} //namespace test_name_converter
@@ -0,0 +1,102 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "assert_exception.h"
+#include "tconf/detail/string_converter.h"
+#include "tconf/tree/string_converter.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <variant>
+
+namespace test_string_converter {
+
+    template<typename T>
+    std::string conversionError(std::string_view data) {
+        auto result = tconf::detail::convertFromString<T>(data);
+        REQUIRE(std::holds_alternative<tconf::detail::StringConversionError>(result));
+        return std::get<tconf::detail::StringConversionError>(result).message;
+    }
+
+    TEST_CASE("TestStringConverter, Integer") {
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("42"), 42);
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("-42"), -42);
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("+42"), 42);
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("010"), 10);
+        REQUIRE_EQ(tconf::StringConverter<std::int64_t>::fromString("-9223372036854775808"),
+                   std::numeric_limits<std::int64_t>::min());
+        REQUIRE_EQ(tconf::StringConverter<std::uint64_t>::fromString("18446744073709551615"),
+                   std::numeric_limits<std::uint64_t>::max());
+        REQUIRE_EQ(tconf::StringConverter<std::uint8_t>::fromString("255"), 255);
+        REQUIRE_EQ(tconf::StringConverter<std::optional<int>>::fromString("7"), std::optional<int>{7});
+    }
+
+    TEST_CASE("TestStringConverter, IntegerLiterals") {
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("0x1F"), 31);
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("0XfF"), 255);
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("-0x10"), -16);
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("0o17"), 15);
+        REQUIRE_EQ(tconf::StringConverter<int>::fromString("0b101"), 5);
+        REQUIRE_EQ(tconf::StringConverter<unsigned>::fromString("0xFFFFFFFF"), 0xFFFFFFFFu);
+    }
+
+    TEST_CASE("TestStringConverter, InvalidInteger") {
+        REQUIRE(!tconf::StringConverter<int>::fromString("").has_value());
+        REQUIRE(!tconf::StringConverter<int>::fromString("12a").has_value());
+        REQUIRE(!tconf::StringConverter<int>::fromString("1.5").has_value());
+        REQUIRE(!tconf::StringConverter<int>::fromString("--1").has_value());
+        REQUIRE(!tconf::StringConverter<int>::fromString("+-1").has_value());
+        REQUIRE(!tconf::StringConverter<int>::fromString("0x-1").has_value());
+        REQUIRE(!tconf::StringConverter<int>::fromString("0b102").has_value());
+        REQUIRE(!tconf::StringConverter<int>::fromString(" 1").has_value());
+        REQUIRE(conversionError<int>("x").empty());
+    }
+
+    TEST_CASE("TestStringConverter, IntegerOutOfRange") {
+        REQUIRE_EQ(conversionError<int>("2147483648"), "value is out of range [-2147483648, 2147483647]");
+        REQUIRE_EQ(conversionError<int>("-2147483649"), "value is out of range [-2147483648, 2147483647]");
+        REQUIRE_EQ(conversionError<std::uint8_t>("256"), "value is out of range [0, 255]");
+        REQUIRE_EQ(conversionError<unsigned>("-1"), "value is out of range [0, 4294967295]");
+        REQUIRE_EQ(conversionError<std::int64_t>("99999999999999999999"),
+                   "value is out of range [-9223372036854775808, 9223372036854775807]");
+        REQUIRE_EQ(tconf::StringConverter<unsigned>::fromString("-0"), 0u);
+    }
+
+    TEST_CASE("TestStringConverter, Float") {
+        REQUIRE_EQ(tconf::StringConverter<double>::fromString("1.5"), 1.5);
+        REQUIRE_EQ(tconf::StringConverter<double>::fromString("-2.5e3"), -2500.0);
+        REQUIRE_EQ(tconf::StringConverter<double>::fromString("+0.25"), 0.25);
+        REQUIRE_EQ(tconf::StringConverter<float>::fromString("3"), 3.f);
+        REQUIRE(!tconf::StringConverter<double>::fromString("1.5x").has_value());
+        REQUIRE(!tconf::StringConverter<double>::fromString("+-1").has_value());
+        REQUIRE(!tconf::StringConverter<double>::fromString("").has_value());
+        REQUIRE_EQ(conversionError<float>("1e100"), "value is out of range");
+    }
+
+    TEST_CASE("TestStringConverter, Bool") {
+        for (auto value: {"1", "true", "True", "TRUE", "yes", "on"})
+            REQUIRE_EQ(tconf::StringConverter<bool>::fromString(value), true);
+        for (auto value: {"0", "false", "False", "no", "OFF"})
+            REQUIRE_EQ(tconf::StringConverter<bool>::fromString(value), false);
+        for (auto value: {"", "2", "y", "truee", "enabled"})
+            REQUIRE(!tconf::StringConverter<bool>::fromString(value).has_value());
+    }
+
+    TEST_CASE("TestStringConverter, Char") {
+        REQUIRE_EQ(tconf::StringConverter<char>::fromString("5"), '5');
+        REQUIRE(!tconf::StringConverter<char>::fromString("55").has_value());
+    }
+
+} //namespace test_string_converter
@@ -0,0 +1,156 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/config.h"
+#include "tconf/config_reader.h"
+#include "tconf/ini/parser.h"
+#include "tconf/json/json_parser.h"
+#include "tconf/short_macros.h"
+#include "tconf/tree/tree_builder.h"
+#include "tconf/tree/tree_layers.h"
+#include "tconf/yaml/parser.h"
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test_tree_layers {
+
+    template<typename TParser>
+    tconf::TreeNode parse(const std::string &content) {
+        auto stream = std::istringstream{content};
+        auto parser = TParser{};
+        return parser.parse(stream);
+    }
+
+    struct DbCfg : public tconf::Config {
+        TCONF_PARAM(host, std::string);
+        TCONF_PARAM(port, int);
+    };
+
+    struct ServerCfg : public tconf::Config {
+        TCONF_PARAM(host, std::string);
+    };
+
+    struct TestCfg : public tconf::Config {
+        using StringMap = std::map<std::string, std::string>;
+        TCONF_PARAM(name, std::string);
+        TCONF_PARAM(port, int);
+        TCONF_PARAM_LIST(tags, std::vector<std::string>);
+        TCONF_NODE(db, DbCfg);
+        TCONF_NODE_LIST(servers, std::vector<ServerCfg>);
+        TCONF_DICT(limits, StringMap);
+    };
+
+    tconf::TreeLayers makeLayers() {
+        auto layers = tconf::TreeLayers{};
+        layers.add(
+                parse<tconf::yaml::Parser>(R"(
+name: base
+port: 80
+tags: [a, b]
+db:
+  host: localhost
+  port: 5432
+servers:
+  - host: s1
+  - host: s2
+limits:
+  cpu: 1
+  mem: 2
+)"),
+                "base");
+        layers.add(
+                parse<tconf::JsonParser>(R"({
+    "port": 8080,
+    "tags": ["c"],
+    "db": {"host": "db.prod"},
+    "servers": [{"host": "s3"}],
+    "limits": {"mem": "4", "disk": "10"}
+})"),
+                "env");
+        layers.add(parse<tconf::ini::Parser>("name = host1\n[db]\nport = 6000\n"), "host");
+        return layers;
+    }
+
+    TEST_CASE("TestTreeLayers, Read") {
+        const auto layers = makeLayers();
+        auto reader = tconf::ConfigReader{};
+        auto cfg = reader.read<TestCfg>(layers);
+        REQUIRE_EQ(cfg.name, "host1");
+        REQUIRE_EQ(cfg.port, 8080);
+        REQUIRE_EQ(cfg.tags, (std::vector<std::string>{"c"}));
+        REQUIRE_EQ(cfg.db.host, "db.prod");
+        REQUIRE_EQ(cfg.db.port, 6000);
+        REQUIRE_EQ(cfg.servers.size(), 1);
+        REQUIRE_EQ(cfg.servers.at(0).host, "s3");
+        REQUIRE(cfg.limits == TestCfg::StringMap{{"cpu", "1"}, {"mem", "4"}, {"disk", "10"}});
+    }
+
+    TEST_CASE("TestTreeLayers, Origin") {
+        const auto layers = makeLayers();
+        REQUIRE_EQ(layers.size(), 3);
+        REQUIRE_EQ(layers.name(1), "env");
+        REQUIRE_EQ(layers.origin("name"), std::optional<std::size_t>{2});
+        REQUIRE_EQ(layers.origin("port"), std::optional<std::size_t>{1});
+        REQUIRE_EQ(layers.origin("tags"), std::optional<std::size_t>{1});
+        REQUIRE_EQ(layers.origin("db"), std::optional<std::size_t>{2});
+        REQUIRE_EQ(layers.origin("db.host"), std::optional<std::size_t>{1});
+        REQUIRE_EQ(layers.origin("db.port"), std::optional<std::size_t>{2});
+        REQUIRE_EQ(layers.origin("servers.0.host"), std::optional<std::size_t>{1});
+        REQUIRE_EQ(layers.origin("limits.cpu"), std::optional<std::size_t>{0});
+        REQUIRE_EQ(layers.origin("limits.disk"), std::optional<std::size_t>{1});
+        REQUIRE(!layers.origin("servers.1"));
+        REQUIRE(!layers.origin("servers.x"));
+        REQUIRE(!layers.origin("port.value"));
+        REQUIRE(!layers.origin("unknown"));
+    }
+
+    TEST_CASE("TestTreeLayers, ChildKindOverride") {
+        auto base = tconf::makeTreeRoot();
+        base.asItem().addNode("a").asItem().addParam("value", "1");
+        base.asItem().addParam("b", "2");
+        auto &list = base.asItem().addNodeList("c");
+        list.asList().addNode().asItem().addParam("value", "3");
+        base.asItem().addNode("d").asItem().addParam("value", "4");
+
+        auto overlay = tconf::makeTreeRoot();
+        overlay.asItem().addParam("a", "5");
+        overlay.asItem().addNode("b").asItem().addParam("value", "6");
+        overlay.asItem().addNode("c").asItem().addParam("value", "7");
+        overlay.asItem().addNodeList("d");
+
+        auto layers = tconf::TreeLayers{};
+        layers.add(std::move(base));
+        layers.add(std::move(overlay));
+
+        auto merged = tconf::makeTreeRoot();
+        auto builder = tconf::TreeBuilder{merged};
+        layers.visit(builder);
+        const auto &item = merged.asItem();
+        REQUIRE_EQ(item.nodesCount(), 3);
+        REQUIRE_EQ(item.paramsCount(), 1);
+        REQUIRE_EQ(item.param("a").value(), "5");
+        REQUIRE_EQ(item.node("b").asItem().param("value").value(), "6");
+        REQUIRE_EQ(item.node("c").asItem().paramsCount(), 1);
+        REQUIRE_EQ(item.node("c").asItem().param("value").value(), "7");
+        REQUIRE(item.node("d").isList());
+        REQUIRE_EQ(item.node("d").asList().count(), 0);
+        REQUIRE_EQ(merged.contentHash(), layers.tree(1).contentHash());
+    }
+
+} //namespace test_tree_layers
@@ -0,0 +1,160 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/tree/tree.h"
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test_tree {
+
+    TEST_CASE("TestTree, InsertionOrder") {
+        auto tree = tconf::makeTreeRoot();
+        tree.asItem().addParam("b", "1");
+        tree.asItem().addParam("a", "2");
+        tree.asItem().addParamList("c", {"3", "4"});
+        tree.asItem().addNode("z");
+        tree.asItem().addNodeList("y");
+
+        auto paramNames = std::vector<std::string>{};
+        for (const auto &[name, param]: tree.asItem().params())
+            paramNames.emplace_back(name);
+        REQUIRE(paramNames == std::vector<std::string>{"b", "a", "c"});
+
+        auto nodeNames = std::vector<std::string>{};
+        for (const auto &[name, node]: tree.asItem().nodes())
+            nodeNames.emplace_back(name);
+        REQUIRE(nodeNames == std::vector<std::string>{"z", "y"});
+
+        REQUIRE_EQ(tree.asItem().paramsCount(), 3);
+        REQUIRE_EQ(tree.asItem().nodesCount(), 2);
+        REQUIRE_EQ(tree.asItem().param("a").value(), "2");
+        REQUIRE(tree.asItem().param("c").valueList() == std::vector<std::string>{"3", "4"});
+        REQUIRE(tree.asItem().node("y").isList());
+    }
+
+    TEST_CASE("TestTree, Lookup") {
+        auto tree = tconf::makeTreeRoot();
+        auto &list = tree.asItem().addNodeList("list");
+        for (auto i = 0; i < 1000; ++i) {
+            auto &node = list.asList().addNode();
+            node.asItem().addParam("id", std::to_string(i));
+            node.asItem().addNode("id").asItem().addParam("value", std::to_string(i * 2));
+        }
+        tree.asItem().addParam("list", "param");
+
+        REQUIRE_EQ(list.asList().count(), 1000);
+        for (auto i = 0; i < 1000; ++i) {
+            const auto &node = tree.asItem().node("list").asList().node(i);
+            REQUIRE_EQ(node.asItem().param("id").value(), std::to_string(i));
+            REQUIRE_EQ(node.asItem().node("id").asItem().param("value").value(), std::to_string(i * 2));
+            REQUIRE(!node.asItem().hasParam("value"));
+        }
+        REQUIRE_EQ(tree.asItem().param("list").value(), "param");
+        REQUIRE(!tree.asItem().hasNode("id"));
+    }
+
+    TEST_CASE("TestTree, DuplicateNames") {
+        auto tree = tconf::makeTreeRoot();
+        tree.asItem().addParam("test", "1");
+        tree.asItem().addNode("test");
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    tree.asItem().addParam("test", "2");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "Parameter 'test' already exists");
+                });
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    tree.asItem().addNodeList("test", {2, 1});
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "[line:2, column:1] Node list 'test' already exists");
+                });
+    }
+
+    TEST_CASE("TestTree, MovedRoot") {
+        auto makeTree = [] {
+            auto tree = tconf::makeTreeRoot();
+            tree.asItem().addNode("node").asItem().addParam("test", "1");
+            return tree;
+        };
+        auto tree = makeTree();
+        auto movedTree = std::move(tree);
+        REQUIRE(movedTree.isRoot());
+        REQUIRE_EQ(movedTree.asItem().node("node").asItem().param("test").value(), "1");
+    }
+
+    TEST_CASE("TestTree, SourceViews") {
+        auto tree = tconf::makeTreeRoot();
+        const auto &source = tree.adoptSource("test = Hello");
+        const auto sourceView = std::string_view{source};
+        tree.asItem().addParam("test", sourceView.substr(7));
+        const auto &param = tree.asItem().param("test");
+        REQUIRE_EQ(param.value(), "Hello");
+        REQUIRE_EQ(param.value().data(), source.data() + 7);
+
+        auto value = std::string{"World"};
+        tree.asItem().addParam("copied", value);
+        value = "Error";
+        REQUIRE_EQ(tree.asItem().param("copied").value(), "World");
+
+        tree.asItem().addParamList("list", {sourceView.substr(0, 4), "copied"});
+        const auto &paramList = tree.asItem().param("list");
+        REQUIRE_EQ(paramList.valueList(), (std::vector<std::string>{"test", "copied"}));
+        REQUIRE_EQ(paramList.valueListView()[0].asString().data(), source.data());
+
+        auto &node = tree.asItem().addNode("node");
+        assert_exception<std::logic_error>(
+                [&] {
+                    node.adoptSource("test");
+                },
+                [](const std::logic_error &) {});
+    }
+
+    TEST_CASE("TestTree, ContentHash") {
+        auto makeTree = [](bool reversed, std::string_view listValue) {
+            auto tree = tconf::makeTreeRoot();
+            auto &item = tree.asItem();
+            auto addParams = [&] {
+                if (reversed) {
+                    item.addParam("b", tconf::TreeValue{std::int64_t{1}});
+                    item.addParam("a", "1");
+                } else {
+                    item.addParam("a", "1");
+                    item.addParam("b", tconf::TreeValue{std::int64_t{1}});
+                }
+            };
+            addParams();
+            auto &list = item.addNodeList("list");
+            list.asList().addNode().asItem().addParam("value", "0");
+            list.asList().addNode().asItem().addParamList("value", {listValue});
+            return tree;
+        };
+
+        const auto tree = makeTree(false, "1");
+        REQUIRE_EQ(tree.contentHash(), makeTree(true, "1").contentHash());
+        REQUIRE(tree.contentHash() != makeTree(false, "2").contentHash());
+        REQUIRE_EQ(tree.asItem().param("a").contentHash(), makeTree(true, "2").asItem().param("a").contentHash());
+        REQUIRE(tree.asItem().param("a").contentHash() != tree.asItem().param("b").contentHash());
+
+        const auto &list = tree.asItem().node("list").asList();
+        REQUIRE(list.node(0).contentHash() != list.node(1).contentHash());
+    }
+
+} //namespace test_tree
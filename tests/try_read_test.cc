@@ -0,0 +1,176 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/config.h"
+#include "tconf/config_reader.h"
+#include "tconf/ini/parser.h"
+#include "tconf/json/json_parser.h"
+#include "turbo/files/filesystem.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace test_try_read {
+
+    struct ItemCfg : public tconf::Config {
+        TCONF_PARAM(name, std::string);
+        TCONF_PARAM(weight, int)(1);
+    };
+
+    struct TestCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int).ensure(
+                [](int value) {
+                    if (value < 0)
+                        throw tconf::ValidationError{"value can't be negative."};
+                });
+        TCONF_PARAM(testDouble, double).ensure(
+                [](double value) {
+                    if (value > 1.0)
+                        throw tconf::ValidationError{"value can't be greater than 1."};
+                });
+        TCONF_PARAM(testStr, std::string);
+        TCONF_NODE_LIST(items, std::vector<ItemCfg>)();
+        TCONF_COPY_NODE_LIST(copyItems, std::vector<ItemCfg>)();
+    };
+
+    std::vector<std::string> errorTexts(const std::vector<tconf::Diagnostic> &errors) {
+        auto texts = std::vector<std::string>{};
+        for (const auto &error: errors)
+            texts.push_back(error.text());
+        return texts;
+    }
+
+    TEST_CASE("TestTryRead, Value") {
+        auto reader = tconf::ConfigReader{};
+        auto parser = tconf::ini::Parser{};
+        auto result = reader.try_read<TestCfg>("testInt = 1\ntestDouble = 0.5\ntestStr = foo\n", parser);
+        REQUIRE(result.has_value());
+        REQUIRE(result.errors().empty());
+        REQUIRE_EQ(result->testInt, 1);
+        REQUIRE_EQ(result.value().testStr, "foo");
+    }
+
+    TEST_CASE("TestTryRead, CollectedErrors") {
+        auto reader = tconf::ConfigReader{};
+        auto parser = tconf::ini::Parser{};
+        auto result = reader.try_read<TestCfg>(
+                "testInt = -1\n"
+                "testDouble = x\n"
+                "testFoo = 1\n"
+                "[items.0]\n"
+                "weight = 2\n"
+                "[items.1]\n"
+                "name = bar\n"
+                "weight = y\n",
+                parser);
+        REQUIRE(!result);
+        const auto expectedErrors = std::vector<std::string>{
+                "[line:4, column:1] Node list 'items': Parameter 'name' is missing.",
+                "[line:8, column:1] Couldn't set parameter 'weight' value from 'y'",
+                "[line:2, column:1] Couldn't set parameter 'testDouble' value from 'x'",
+                "[line:3, column:1] Unknown param 'testFoo'",
+                "[line:1, column:1] Root node: Parameter 'testStr' is missing.",
+                "[line:1, column:1] Parameter 'testInt': value can't be negative."};
+        REQUIRE_EQ(errorTexts(result.errors()), expectedErrors);
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    result.value();
+                },
+                [&](const tconf::ConfigError &error) {
+                    auto message = std::string{};
+                    for (const auto &text: expectedErrors)
+                        message += (message.empty() ? "" : "\n") + text;
+                    REQUIRE_EQ(std::string{error.what()}, message);
+                });
+    }
+
+    TEST_CASE("TestTryRead, ThrowingReadReportsFirstError") {
+        auto reader = tconf::ConfigReader{};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    reader.read_ini<TestCfg>("testInt = -1\ntestDouble = x\ntestFoo = 1\n");
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(
+                            std::string{error.what()},
+                            "[line:2, column:1] Couldn't set parameter 'testDouble' value from 'x'");
+                });
+    }
+
+    TEST_CASE("TestTryRead, Tree") {
+        auto reader = tconf::ConfigReader{};
+        auto stream = std::istringstream{
+                "testInt = 1\n"
+                "testDouble = 2\n"
+                "testStr = foo\n"
+                "[copyItems.0]\n"
+                "weight = 3\n"
+                "[copyItems.1]\n"
+                "weight = z\n"};
+        const auto tree = tconf::ini::Parser{}.parse(stream);
+        auto result = reader.try_read<TestCfg>(tree);
+        REQUIRE(!result.has_value());
+        const auto expectedErrors = std::vector<std::string>{
+                "[line:4, column:1] Node list 'copyItems': Parameter 'name' is missing.",
+                "[line:7, column:1] Couldn't set parameter 'weight' value from 'z'",
+                "[line:2, column:1] Parameter 'testDouble': value can't be greater than 1."};
+        REQUIRE_EQ(errorTexts(result.errors()), expectedErrors);
+    }
+
+    TEST_CASE("TestTryRead, SyntaxError") {
+        auto reader = tconf::ConfigReader{};
+        auto parser = tconf::ini::Parser{};
+        // the file is parsed before its fields are loaded, so only the syntax error is reported
+        auto result = reader.try_read<TestCfg>("testFoo = 1\n[items.0\n", parser);
+        REQUIRE(!result.has_value());
+        REQUIRE_EQ(result.errors().size(), 1);
+        REQUIRE_EQ(result.errors().at(0).text(), "[line:2, column:1] Section isn't closed");
+    }
+
+    TEST_CASE("TestTryRead, ReadManyFiles") {
+        auto reader = tconf::ConfigReader{};
+        const auto directory = turbo::filesystem::temp_directory_path();
+        auto paths = std::vector<turbo::filesystem::path>{};
+        for (auto i = 0; i < 6; ++i) {
+            paths.push_back(directory / ("tconf_test_try_read_" + std::to_string(i) + ".json"));
+            auto stream = std::ofstream{paths.back(), std::ios_base::binary};
+            stream << R"({"testInt": )" << (i % 2 ? "-1" : "1") << R"(, "testDouble": 0.5, "testStr": "foo"})";
+        }
+        paths.push_back(directory / "tconf_test_try_read_missing.json");
+
+        auto results = reader.try_read_many<TestCfg, tconf::JsonParser>(paths, 3);
+        REQUIRE_EQ(results.size(), 7);
+        for (auto i = 0; i < 6; ++i) {
+            if (i % 2) {
+                REQUIRE_EQ(results.at(i).errors().size(), 1);
+                REQUIRE_EQ(results.at(i).errors().at(0).text(), "Parameter 'testInt': value can't be negative.");
+                continue;
+            }
+            REQUIRE(results.at(i).has_value());
+            REQUIRE_EQ(results.at(i)->testInt, 1);
+        }
+        REQUIRE_EQ(results.at(6).errors().size(), 1);
+        REQUIRE_EQ(results.at(6).errors().at(0).text(), "Config file " + paths.back().string() + " doesn't exist");
+
+        for (const auto &path: paths) {
+            auto error = std::error_code{};
+            turbo::filesystem::remove(path, error);
+        }
+    }
+
+} //namespace test_try_read
@@ -0,0 +1,94 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/detail/validator.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace test_validator {
+
+    int liveValidators = 0;
+    bool failMoves = false;
+
+    struct CountedValidator {
+        explicit CountedValidator(bool throwOnMove = false)
+                : throwOnMove_{throwOnMove} {
+            ++liveValidators;
+        }
+
+        CountedValidator(CountedValidator &&other)
+                : throwOnMove_{other.throwOnMove_} {
+            if (throwOnMove_ && failMoves)
+                throw std::runtime_error{"move failed"};
+            ++liveValidators;
+        }
+
+        CountedValidator(const CountedValidator &) = delete;
+
+        CountedValidator &operator=(const CountedValidator &) = delete;
+
+        CountedValidator &operator=(CountedValidator &&) = delete;
+
+        ~CountedValidator() {
+            --liveValidators;
+        }
+
+        void operator()(const int &) const {
+        }
+
+    private:
+        bool throwOnMove_;
+    };
+
+    std::vector<tconf::detail::ValidatorTable::BoundValidator> makeValidators(bool throwOnMove) {
+        auto validators = std::vector<tconf::detail::ValidatorTable::BoundValidator>{};
+        validators.push_back({tconf::detail::Validator::of<int>(CountedValidator{}), 0, 0});
+        validators.push_back({tconf::detail::Validator::of<int>(CountedValidator{}), 0, 0});
+        validators.push_back({tconf::detail::Validator::of<int>(CountedValidator{throwOnMove}), 0, 0});
+        return validators;
+    }
+
+    TEST_CASE("TestValidatorTable, Basic") {
+        {
+            auto table = tconf::detail::ValidatorTable{makeValidators(false)};
+            REQUIRE_EQ(liveValidators, 3);
+            REQUIRE_EQ(table.end() - table.begin(), 3);
+            const auto value = 1;
+            for (const auto &entry: table)
+                entry.run(reinterpret_cast<const char *>(&value));
+        }
+        REQUIRE_EQ(liveValidators, 0);
+    }
+
+    TEST_CASE("TestValidatorTable, ThrowingMove") {
+        // the validators moved into the table before the failed one are destroyed
+        auto validators = makeValidators(true);
+        failMoves = true;
+        assert_exception<std::runtime_error>(
+                [&] {
+                    auto table = tconf::detail::ValidatorTable{std::move(validators)};
+                },
+                [](const std::runtime_error &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "move failed");
+                });
+        failMoves = false;
+        validators.clear();
+        REQUIRE_EQ(liveValidators, 0);
+    }
+
+} //namespace test_validator
@@ -0,0 +1,256 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "assert_exception.h"
+#include "tconf/config.h"
+#include "tconf/watched.h"
+#include "tconf/short_macros.h"
+#include "turbo/files/filesystem.h"
+#include <chrono>
+#include <fstream>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_watched {
+
+    struct TestCfg : public tconf::Config {
+        TCONF_PARAM(testInt, int);
+        TCONF_PARAM(testStr, std::string)();
+    };
+
+    class TempFile {
+    public:
+        TempFile(const std::string &name, const std::string &content)
+                : path_{turbo::filesystem::temp_directory_path() / name} {
+            write(content);
+        }
+
+        ~TempFile() {
+            auto error = std::error_code{};
+            turbo::filesystem::remove(path_, error);
+        }
+
+        void write(const std::string &content) {
+            auto stream = std::ofstream{path_, std::ios_base::binary | std::ios_base::trunc};
+            stream << content;
+        }
+
+        /// writes a new file and moves it over the old one, like most of the editors do
+        void replace(const std::string &content) {
+            auto newPath = path_;
+            newPath += ".new";
+            {
+                auto stream = std::ofstream{newPath, std::ios_base::binary};
+                stream << content;
+            }
+            turbo::filesystem::rename(newPath, path_);
+        }
+
+        const turbo::filesystem::path &path() const {
+            return path_;
+        }
+
+    private:
+        turbo::filesystem::path path_;
+    };
+
+    template<typename TPred>
+    bool waitFor(TPred pred) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        }
+        return true;
+    }
+
+    tconf::WatchOptions makeTestOptions() {
+        auto options = tconf::WatchOptions{};
+        options.debounce = std::chrono::milliseconds{10};
+        options.poll_interval = std::chrono::milliseconds{10};
+        return options;
+    }
+
+    const auto testOptions = makeTestOptions();
+
+    TEST_CASE("TestWatched, Reload")
+    {
+        auto file = TempFile{"tconf_test_watched.json", R"({"testInt": 1, "testStr": "Hello"})"};
+        auto watched = tconf::watch_json_file<TestCfg>(file.path(), testOptions);
+        auto reader = watched.reader();
+        const auto snapshot = watched.snapshot();
+        REQUIRE_EQ(reader->testInt, 1);
+        REQUIRE_EQ(watched.version(), 0);
+
+        file.write(R"({"testInt": 2, "testStr": "World"})");
+        REQUIRE(waitFor([&] { return watched.version() > 0; }));
+        REQUIRE_EQ(reader->testInt, 2);
+        REQUIRE_EQ(reader->testStr, "World");
+        REQUIRE(!watched.last_error());
+        REQUIRE_EQ(snapshot->testInt, 1);
+        REQUIRE_EQ(snapshot->testStr, "Hello");
+    }
+
+    struct PmrCfg : public tconf::Config {
+        TCONF_PARAM(testStr, std::pmr::string);
+    };
+
+    TEST_CASE("TestWatched, SnapshotArena")
+    {
+        auto file = TempFile{"tconf_test_watched_arena.json", R"({"testStr": "Hello"})"};
+        auto options = testOptions;
+        options.snapshot_arena = true;
+        auto watched = tconf::watch_json_file<PmrCfg>(file.path(), options);
+        const auto snapshot = watched.snapshot();
+        REQUIRE_EQ(snapshot->testStr, "Hello");
+        REQUIRE(snapshot->testStr.get_allocator().resource() != std::pmr::get_default_resource());
+
+        file.write(R"({"testStr": "World"})");
+        REQUIRE(waitFor([&] { return watched.version() > 0; }));
+        REQUIRE_EQ(watched.snapshot()->testStr, "World");
+        const auto arena = snapshot->testStr.get_allocator().resource();
+        REQUIRE(watched.snapshot()->testStr.get_allocator().resource() != arena);
+        REQUIRE_EQ(snapshot->testStr, "Hello");
+    }
+
+    TEST_CASE("TestWatched, ReloadReplacedFile")
+    {
+        auto file = TempFile{"tconf_test_watched.ini", "testInt = 1\n"};
+        auto watched = tconf::watch_ini_file<TestCfg>(file.path(), testOptions);
+        REQUIRE_EQ(watched.snapshot()->testInt, 1);
+
+        file.replace("testInt = 2\n");
+        REQUIRE(waitFor([&] { return watched.version() > 0; }));
+        REQUIRE_EQ(watched.snapshot()->testInt, 2);
+    }
+
+    TEST_CASE("TestWatched, ReloadSymlinkTarget")
+    {
+        // the layout of a Kubernetes ConfigMap mount: the file links to the data directory link,
+        // which is swapped to the new version's directory by renaming
+        namespace fs = turbo::filesystem;
+        const auto dir = fs::temp_directory_path() / "tconf_test_watched_symlink";
+        auto error = std::error_code{};
+        fs::remove_all(dir, error);
+        fs::create_directories(dir / "..v1");
+        fs::create_directories(dir / "..v2");
+        auto writeFile = [](const fs::path &path, const std::string &content) {
+            auto stream = std::ofstream{path, std::ios_base::binary};
+            stream << content;
+        };
+        writeFile(dir / "..v1" / "cfg.ini", "testInt = 1\n");
+        writeFile(dir / "..v2" / "cfg.ini", "testInt = 2\n");
+        fs::create_directory_symlink("..v1", dir / "..data");
+        fs::create_symlink(fs::path{"..data"} / "cfg.ini", dir / "cfg.ini");
+        {
+            auto watched = tconf::watch_ini_file<TestCfg>(dir / "cfg.ini", testOptions);
+            REQUIRE_EQ(watched.snapshot()->testInt, 1);
+
+            fs::create_directory_symlink("..v2", dir / "..data_tmp");
+            fs::rename(dir / "..data_tmp", dir / "..data");
+            REQUIRE(waitFor([&] { return watched.version() > 0; }));
+            REQUIRE_EQ(watched.snapshot()->testInt, 2);
+
+            // the target directory is watched too
+            writeFile(dir / "..v2" / "cfg.ini", "testInt = 3\n");
+            REQUIRE(waitFor([&] { return watched.snapshot()->testInt == 3; }));
+        }
+        fs::remove_all(dir, error);
+    }
+
+    TEST_CASE("TestWatched, FailedReloadKeepsSnapshot")
+    {
+        auto file = TempFile{"tconf_test_watched_error.json", R"({"testInt": 1})"};
+        auto watched = tconf::watch_json_file<TestCfg>(file.path(), testOptions);
+
+        file.write(R"({"testStr": "Hello"})");
+        REQUIRE(waitFor([&] { return watched.last_error().has_value(); }));
+        REQUIRE_EQ(*watched.last_error(), "[line:1, column:1] Root node: Parameter 'testInt' is missing.");
+        REQUIRE_EQ(watched.version(), 0);
+        REQUIRE_EQ(watched.snapshot()->testInt, 1);
+
+        file.write(R"({"testInt": 3})");
+        REQUIRE(waitFor([&] { return watched.version() > 0; }));
+        REQUIRE_EQ(watched.snapshot()->testInt, 3);
+        REQUIRE(!watched.last_error());
+    }
+
+    TEST_CASE("TestWatched, TruncatedDuringReload")
+    {
+        const auto makeContent = [](int value) {
+            return R"({"testInt": )" + std::to_string(value) + R"(, "testStr": ")" + std::string(100000, 'x') + "\"}";
+        };
+        auto file = TempFile{"tconf_test_watched_truncated.json", makeContent(0)};
+        auto options = testOptions;
+        options.debounce = std::chrono::milliseconds{0};
+        auto watched = tconf::watch_json_file<TestCfg>(file.path(), options);
+
+        // the file is truncated and written in parts while the watching thread reloads it
+        const auto content = makeContent(1);
+        for (auto i = 0; i < 50; ++i) {
+            auto stream = std::ofstream{file.path(), std::ios_base::binary | std::ios_base::trunc};
+            for (auto pos = std::size_t{}; pos < content.size(); pos += 10000) {
+                stream << content.substr(pos, 10000) << std::flush;
+                std::this_thread::sleep_for(std::chrono::microseconds{100});
+            }
+        }
+        REQUIRE(waitFor([&] { return watched.snapshot()->testInt == 1 && !watched.last_error(); }));
+        REQUIRE_EQ(watched.snapshot()->testStr.size(), 100000);
+    }
+
+    TEST_CASE("TestWatched, OnChange")
+    {
+        auto file = TempFile{"tconf_test_watched_on_change.json", R"({"testInt": 1, "testStr": "Hello"})"};
+        auto options = testOptions;
+        auto changes = std::vector<tconf::ConfigChanges>{};
+        auto changesMutex = std::mutex{};
+        options.on_change = [&](const tconf::ConfigChanges &configChanges) {
+            auto lock = std::lock_guard{changesMutex};
+            changes.push_back(configChanges);
+        };
+        auto watched = tconf::watch_json_file<TestCfg>(file.path(), options);
+
+        file.write(R"({"testInt": 1, "testStr": "World"})");
+        REQUIRE(waitFor([&] { return watched.version() > 0; }));
+        REQUIRE_EQ(watched.snapshot()->testStr, "World");
+        // the handler is called after the snapshot is published
+        REQUIRE(waitFor([&] {
+            auto lock = std::lock_guard{changesMutex};
+            return !changes.empty();
+        }));
+
+        auto lock = std::lock_guard{changesMutex};
+        REQUIRE_EQ(changes.size(), 1);
+        REQUIRE(changes[0].isFullReload);
+        REQUIRE(changes[0].fields.empty());
+    }
+
+    TEST_CASE("TestWatched, InitialReadError")
+    {
+        auto file = TempFile{"tconf_test_watched_initial.json", R"({"testStr": "Hello"})"};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    auto watched = tconf::watch_json_file<TestCfg>(file.path(), testOptions);
+                },
+                [](const tconf::ConfigError &error) {
+                    REQUIRE_EQ(std::string{error.what()}, "[line:1, column:1] Root node: Parameter 'testInt' is missing.");
+                });
+    }
+
+}
@@ -142,4 +142,26 @@ b:
         REQUIRE_EQ(bNode.param("testInt").value(), "9");
     }
 
-} //namespace test_nodeparser
\ No newline at end of file
+    TEST_CASE("TestNodeParser, ReusedParser")
+    {
+        auto parser = tconf::yaml::Parser{};
+        auto firstInput = std::stringstream{"foo: 5\na:\n  testStr: \"Hello\"\n"};
+        auto first = parser.parse(firstInput);
+
+        auto invalidInput = std::stringstream{"foo: [1, 2\n"};
+        assert_exception<tconf::ConfigError>(
+                [&] {
+                    parser.parse(invalidInput);
+                },
+                [](const tconf::ConfigError &) {});
+
+        auto secondInput = std::stringstream{"bar: test\n"};
+        auto second = parser.parse(secondInput);
+
+        REQUIRE_EQ(first.asItem().param("foo").value(), "5");
+        REQUIRE_EQ(first.asItem().node("a").asItem().param("testStr").value(), "Hello");
+        REQUIRE_EQ(second.asItem().paramsCount(), 1);
+        REQUIRE_EQ(second.asItem().param("bar").value(), "test");
+    }
+
+} //namespace test_nodeparser
@@ -0,0 +1,38 @@
+// Copyright 2023 The titan-search Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// tconf-compile: converts a text config into a binary snapshot that ConfigReader::read_snapshot_file() loads
+// without parsing. This tool isn't bound to a config type, so the snapshot gets the schema fingerprint passed with
+// --fingerprint (see ConfigReader::schema_fingerprint()). Without it the snapshot has no fingerprint and is read
+// only with UnboundSnapshot::Accept. A tool checking the config against its type is built with
+// tconf::binary::compile_main<TCfg>() from "tconf/binary/compile.h".
+//
+// usage: tconf-compile [--fingerprint <hex>] <config file> <snapshot file> [json|yaml|toml|ini]
+// The format is detected by the config file's extension if it isn't specified.
+
+#include "tconf/binary/compile.h"
+#include "tconf/binary/writer.h"
+
+int main(int argc, char **argv) {
+    return tconf::binary::detail::compileMain(
+            argc,
+            argv,
+            true,
+            [](const turbo::filesystem::path &snapshotFile,
+               const tconf::TreeNode &tree,
+               std::optional<std::uint64_t> fingerprint) {
+                tconf::binary::writeFile(snapshotFile, tree, fingerprint.value_or(0));
+            });
+}